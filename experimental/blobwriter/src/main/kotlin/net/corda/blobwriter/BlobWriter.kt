@@ -51,6 +51,7 @@ data class _Oi_ (val a: Integer)
 data class _l_ (val x: Long)
 data class _Ai_ (val z : Array<Int>)
 data class _Ci_ (val z : IntArray)
+data class _Cild_ (val a : IntArray, val b : LongArray, val c : DoubleArray)
 data class _is_ (val a: Int, val b: String)
 data class _i_is__ (val a: Int, val b: _is_)
 data class _Li_ (val a: List<Int>)
@@ -70,6 +71,7 @@ data class _Pls_ (val a : Pair<Long, String>)
 
 data class _e_ (val e: E)
 data class _Le_ (val listy: List<E>)
+data class _LsLe_ (val s: List<String>, val e: List<E>)
 data class _L_i__ (val listy: List<_i_>)
 
 data class _ALd_ (val a: Array<List<Double>>)
@@ -87,9 +89,17 @@ fun main (args: Array<String>) {
     v[0] = 1; v[1] = 2; v[2] = 3
 
     File("$path/_Ci_").writeBytes (_Ci_(v).serialize().bytes)
+    File("$path/_Cild_").writeBytes (_Cild_(
+            intArrayOf (1, -70000, 3),
+            longArrayOf (4, 5000000000),
+            doubleArrayOf (1.5, -2.25)).serialize().bytes)
 
     File("$path/_Le_").writeBytes (_Le_(listOf (E.A, E.B, E.C)).serialize().bytes)
     File("$path/_Le_2").writeBytes (_Le_(listOf (E.A, E.B, E.C, E.B, E.A)).serialize().bytes)
+
+    // the one "x" is written the second time as a reference back to the first
+    val x = "x"
+    File("$path/_LsLe_").writeBytes (_LsLe_(listOf (x, "y", x), listOf (E.A, E.A)).serialize().bytes)
     File("$path/_L_i__").writeBytes(
             _L_i__(listOf (
                     _i_ (1),
@@ -0,0 +1,618 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include <unistd.h>
+
+#include "proton/codec.h"
+
+#include "amqp/WorkPool.h"
+#include "amqp/BinaryEncoding.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+#include "amqp/schema/described-types/Envelope.h"
+#include "amqp/reader/Projection.h"
+#include "amqp/reader/visitors/JsonWriter.h"
+#include "amqp/reader/visitors/StreamVisitor.h"
+
+#include "CordaBytes.h"
+#include "BlobInspector.h"
+#include "BatchInspector.h"
+#include "Generator.h"
+
+/******************************************************************************
+ *
+ * Decode throughput, stage by stage, over the test blobs and some much
+ * larger synthetic ones built from them. Every benchmark reports the
+ * bytes of blob body and the number of blobs it got through.
+ *
+ ******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    const size_t HEADER_SIZE = amqp::AMQP_HEADER.size() + 1;
+
+    std::string
+    slurp (const std::string & path_) {
+        std::ifstream file { path_, std::ios::in | std::ios::binary };
+
+        return { std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>() };
+    }
+
+    /**
+     * A blob under test along with everything the later stages need
+     * already worked out by the earlier ones
+     */
+    struct Blob {
+        std::string name;
+        std::string path;
+        std::string bytes;
+
+        const char * body() const { return bytes.data() + HEADER_SIZE; }
+        size_t size() const { return bytes.size() - HEADER_SIZE; }
+
+        std::string descriptor;
+        std::string_view schema;
+        size_t payload;
+
+        /**
+         * A path picking out a small part of the blob, if we have one
+         */
+        std::string projection;
+
+        explicit Blob (std::string name_, std::string path_)
+            : name (std::move (name_))
+            , path (std::move (path_))
+            , bytes (slurp (path))
+            , payload (0)
+        {
+            decoder::Decoder d (body(), size());
+
+            decoder::auto_enter ae (&d);
+            d.next();
+            decoder::auto_enter ae2 (&d);
+
+            payload = d.offset();
+
+            {
+                decoder::auto_enter ae3 (&d);
+                descriptor = decoder::get_symbol<std::string> (&d);
+            }
+
+            d.next();
+            schema = d.encoded();
+        }
+
+        /**
+         * A cursor sat on the payload
+         */
+        decoder::Decoder
+        atPayload() const {
+            decoder::Decoder d (body(), size());
+
+            d.enter();
+            d.next();
+            d.next();
+            d.enter();
+            d.next();
+
+            return d;
+        }
+    };
+
+    std::vector<std::unique_ptr<Blob>> blobs; // NOLINT
+
+    /**************************************************************************
+     *
+     * Synthetic blobs
+     *
+     **************************************************************************/
+
+    void
+    put32 (std::string & out_, uint32_t value_) {
+        for (int shift { 24 } ; shift >= 0 ; shift -= 8) {
+            out_.push_back (static_cast<char>((value_ >> shift) & 0xff));
+        }
+    }
+
+    std::string
+    list32 (size_t count_, const std::string & content_) {
+        std::string rtn { "\xd0" };
+
+        put32 (rtn, static_cast<uint32_t>(content_.size() + 4));
+        put32 (rtn, static_cast<uint32_t>(count_));
+
+        return rtn + content_;
+    }
+
+    /**
+     * Take a test blob whose single property is a list and repeat its first
+     * element until there are [count_] of them. The schema section is copied
+     * across untouched.
+     */
+    std::string
+    grow (const std::string & template_, size_t count_) {
+        auto raw = slurp (std::string (TEST_FILES) + template_);
+        auto header = raw.substr (0, HEADER_SIZE);
+
+        decoder::Decoder d (raw.data() + HEADER_SIZE, raw.size() - HEADER_SIZE);
+
+        decoder::auto_enter ae (&d);
+        std::string envelopeDescriptor { d.encoded() };
+
+        d.next();
+        decoder::auto_list_enter ale (&d, true);
+
+        std::string sections;
+
+        std::string payloadDescriptor, listDescriptor, element;
+        {
+            decoder::auto_enter ae2 (&d);
+            payloadDescriptor = d.encoded();
+            d.next();
+
+            decoder::auto_enter ae3 (&d);
+            decoder::auto_enter ae4 (&d);
+            listDescriptor = d.encoded();
+            d.next();
+
+            decoder::auto_enter ae5 (&d);
+            element = d.encoded();
+        }
+
+        // everything after the payload, the schema and transforms
+        while (d.next()) {
+            sections += d.encoded();
+        }
+
+        std::string elements;
+        elements.reserve (element.size() * count_);
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            elements += element;
+        }
+
+        auto field = std::string (1, '\0') + listDescriptor + list32 (count_, elements);
+        auto payload = std::string (1, '\0') + payloadDescriptor + list32 (1, field);
+
+        return header + std::string (1, '\0') + envelopeDescriptor
+            + list32 (ale.elements(), payload + sections);
+    }
+
+    /**************************************************************************
+     *
+     * Stages
+     *
+     **************************************************************************/
+
+    void
+    count (benchmark::State & state_, const Blob & blob_) {
+        state_.SetBytesProcessed (state_.iterations() * blob_.size());
+        state_.SetItemsProcessed (state_.iterations());
+    }
+
+    /**
+     * Open, map and check the header
+     */
+    void
+    header (benchmark::State & state_, const Blob & blob_) {
+        for (auto _ : state_) {
+            CordaBytes cb (blob_.path);
+            benchmark::DoNotOptimize (cb.bytes());
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * What we used to do with the whole blob before reading anything
+     */
+    void
+    pnDataDecode (benchmark::State & state_, const Blob & blob_) {
+        std::unique_ptr<pn_data_t, decltype(&pn_data_free)> data {
+            pn_data (0), pn_data_free
+        };
+
+        for (auto _ : state_) {
+            pn_data_clear (data.get());
+            benchmark::DoNotOptimize (
+                pn_data_decode (data.get(), blob_.body(), blob_.size()));
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * The native decoder visiting every value in the blob
+     */
+    void
+    walk (decoder::Decoder & d_) {
+        do {
+            switch (d_.type()) {
+                case decoder::described_t :
+                case decoder::list_t :
+                case decoder::map_t :
+                case decoder::array_t :
+                    if (d_.enter()) {
+                        walk (d_);
+                        d_.exit();
+                    }
+                    break;
+                default :
+                    benchmark::DoNotOptimize (d_.code());
+            }
+        } while (d_.next());
+    }
+
+    void
+    nativeWalk (benchmark::State & state_, const Blob & blob_) {
+        decoder::Decoder d (blob_.body(), blob_.size());
+
+        for (auto _ : state_) {
+            d.reset (blob_.body(), blob_.size());
+            walk (d);
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * Building the Envelope, and the Schema inside it, out of proton
+     */
+    void
+    envelopeBuild (benchmark::State & state_, const Blob & blob_) {
+        std::unique_ptr<pn_data_t, decltype(&pn_data_free)> data {
+            pn_data (0), pn_data_free
+        };
+
+        pn_data_decode (data.get(), blob_.body(), blob_.size());
+
+        for (auto _ : state_) {
+            pn_data_rewind (data.get());
+            pn_data_next (data.get());
+
+            auto envelope = schema::descriptors::dispatchDescribed<schema::Envelope> (
+                    data.get());
+
+            benchmark::DoNotOptimize (envelope.get());
+        }
+
+        count (state_, blob_);
+    }
+
+    void
+    compositeFactory (benchmark::State & state_, const Blob & blob_) {
+        std::unique_ptr<pn_data_t, decltype(&pn_data_free)> data {
+            pn_data (0), pn_data_free
+        };
+
+        pn_data_decode (data.get(), blob_.schema.data(), blob_.schema.size());
+
+        auto schema = schema::descriptors::dispatchDescribed<schema::Schema> (
+                data.get());
+
+        for (auto _ : state_) {
+            CompositeFactory cf;
+            cf.process (*schema);
+
+            benchmark::DoNotOptimize (cf.byDescriptor (blob_.descriptor));
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * Reading the payload with everything else already in place
+     */
+    template<class Render>
+    void
+    render (benchmark::State & state_, const Blob & blob_, Render render_) {
+        auto entry = SchemaCache::instance().get (blob_.schema);
+        auto reader = entry->byDescriptor (blob_.descriptor);
+        auto payload = blob_.atPayload();
+
+        for (auto _ : state_) {
+            auto d = payload;
+            render_ (*reader, d, entry->schema());
+        }
+
+        count (state_, blob_);
+    }
+
+    void
+    renderTree (benchmark::State & state_, const Blob & blob_) {
+        render (state_, blob_, [](auto & reader_, auto & d_, auto & schema_) {
+            benchmark::DoNotOptimize (
+                reader_.dump ("{ Parsed", &d_, schema_)->dump());
+        });
+    }
+
+    void
+    renderText (benchmark::State & state_, const Blob & blob_) {
+        render (state_, blob_, [](auto & reader_, auto & d_, auto & schema_) {
+            std::stringstream ss;
+            reader::StreamVisitor visitor (ss);
+
+            visitor.key ("{ Parsed");
+            reader_.visit (&d_, schema_, visitor);
+
+            benchmark::DoNotOptimize (ss.str());
+        });
+    }
+
+    void
+    renderJson (benchmark::State & state_, const Blob & blob_) {
+        render (state_, blob_, [](auto & reader_, auto & d_, auto & schema_) {
+            reader::JsonWriter writer;
+            reader_.visit (&d_, schema_, writer);
+
+            benchmark::DoNotOptimize (writer.str().data());
+        });
+    }
+
+    /**
+     * As render_json with large containers split across every core
+     */
+    void
+    renderJsonParallel (benchmark::State & state_, const Blob & blob_) {
+        WorkPool::configure (std::thread::hardware_concurrency());
+
+        renderJson (state_, blob_);
+
+        WorkPool::configure (0);
+    }
+
+    /**
+     * As render_json but with only the blob's [projection] decoded, the
+     * rest is skipped
+     */
+    void
+    projectJson (benchmark::State & state_, const Blob & blob_) {
+        reader::Projection projection ({ blob_.projection });
+
+        render (state_, blob_, [&projection](auto & reader_, auto & d_, auto & schema_) {
+            reader::JsonWriter writer;
+            projection.visit (
+                    dynamic_cast<const reader::Reader &>(reader_),
+                    &d_, schema_, writer);
+
+            benchmark::DoNotOptimize (writer.str().data());
+        });
+    }
+
+    /**
+     * End to end, with the schema cache cleared every time and left warm
+     */
+    void
+    inspectCold (benchmark::State & state_, const Blob & blob_) {
+        for (auto _ : state_) {
+            SchemaCache::instance().clear();
+
+            CordaBytes cb (blob_.path);
+            benchmark::DoNotOptimize (BlobInspector (cb).dump());
+        }
+
+        count (state_, blob_);
+    }
+
+    void
+    inspectWarm (benchmark::State & state_, const Blob & blob_) {
+        for (auto _ : state_) {
+            CordaBytes cb (blob_.path);
+            benchmark::DoNotOptimize (BlobInspector (cb).dump());
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * As a batch worker does it, one context for every blob
+     */
+    void
+    inspectReused (benchmark::State & state_, const Blob & blob_) {
+        DecodeContext context;
+
+        for (auto _ : state_) {
+            CordaBytes cb (blob_.path);
+            benchmark::DoNotOptimize (BlobInspector (context, cb).text().data());
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * All a routing job wants, against envelope_build which is what it
+     * costs to get the same from a built schema
+     */
+    void
+    classify (benchmark::State & state_, const Blob & blob_) {
+        DecodeContext context;
+
+        for (auto _ : state_) {
+            CordaBytes cb (blob_.path);
+            benchmark::DoNotOptimize (
+                BlobInspector (context, cb).classification().data());
+        }
+
+        count (state_, blob_);
+    }
+
+    /**
+     * Rendering a run of hashes, keys and signatures sized binary values
+     */
+    void
+    encode (
+        benchmark::State & state_,
+        size_t size_,
+        size_t (*length_)(size_t),
+        void (*encode_)(const uint8_t *, size_t, char *)
+    ) {
+        std::vector<uint8_t> bytes (size_);
+
+        for (size_t i { 0 } ; i < bytes.size() ; ++i) {
+            bytes[i] = static_cast<uint8_t>(i * 31 + 7);
+        }
+
+        std::string text (length_ (size_), '\0');
+
+        for (auto _ : state_) {
+            encode_ (bytes.data(), bytes.size(), text.data());
+            benchmark::DoNotOptimize (text.data());
+        }
+
+        state_.SetBytesProcessed (state_.iterations() * size_);
+        state_.SetLabel (binaryEncodingImplementation());
+    }
+
+    /**************************************************************************/
+
+    /**
+     * Every blob in [dir_], listed as the inspector lists a directory
+     */
+    void
+    load (const std::string & dir_) {
+        for (const auto & path : BatchInspector::expand (dir_)) {
+            blobs.emplace_back (std::make_unique<Blob> (
+                    path.substr (dir_.size()), path));
+        }
+    }
+
+    /**
+     * Synthetic blobs are written out so every stage, the header included,
+     * sees them exactly as it would a real file
+     */
+    std::string
+    synthesise (const std::string & dir_) {
+        const std::vector<std::tuple<std::string, size_t, std::string>> templates {
+            { "_Li_", 100000, "a[99999]" },
+            { "_L_i__", 100000, "listy[99999].a" },
+            { "_Le_", 100000, "listy[99999]" }
+        };
+
+        for (const auto & [name, n, projection] : templates) {
+            auto path = dir_ + "/" + name + "x" + std::to_string (n);
+            std::ofstream (path, std::ios::binary) << grow (name, n);
+
+            blobs.emplace_back (std::make_unique<Blob> (
+                    "synthetic/" + name + "x" + std::to_string (n), path));
+
+            blobs.back()->projection = projection;
+        }
+
+        // made from scratch, a schema of many types, one nested deeply,
+        // and a few megabytes of everything
+        std::vector<std::pair<std::string, Generator::Shape>> shapes (3);
+
+        shapes[0].first = "wide";
+        shapes[0].second.types = 64;
+        shapes[0].second.count = 4;
+
+        shapes[1].first = "deep";
+        shapes[1].second.depth = 32;
+        shapes[1].second.types = 2;
+
+        shapes[2].first = "4M";
+        shapes[2].second.bytes = 4 << 20;
+        shapes[2].second.primitives = Generator::primitives();
+
+        for (auto & [name, shape] : shapes) {
+            auto path = dir_ + "/generated-" + name;
+            std::ofstream (path, std::ios::binary) << Generator (shape).blob();
+
+            blobs.emplace_back (std::make_unique<Blob> ("generated/" + name, path));
+            blobs.back()->projection = "r0[0].f0";
+        }
+
+        return dir_;
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char ** argv) {
+    char tmp[] = "/tmp/blob-benchmarks-XXXXXX";
+
+    if (!::mkdtemp (tmp)) {
+        return EXIT_FAILURE;
+    }
+
+    load (TEST_FILES);
+    synthesise (tmp);
+
+    const std::vector<std::pair<std::string, void (*)(benchmark::State &, const Blob &)>> stages {
+        { "header",            header },
+        { "pn_data_decode",    pnDataDecode },
+        { "native_walk",       nativeWalk },
+        { "envelope_build",    envelopeBuild },
+        { "composite_factory", compositeFactory },
+        { "render_tree",       renderTree },
+        { "render_text",       renderText },
+        { "render_json",       renderJson },
+        { "render_json_par",   renderJsonParallel },
+        { "inspect_cold",      inspectCold },
+        { "inspect_warm",      inspectWarm },
+        { "inspect_reused",    inspectReused },
+        { "classify",          classify },
+    };
+
+    for (const auto & [stage, fn] : stages) {
+        for (const auto & blob : blobs) {
+            benchmark::RegisterBenchmark (
+                (stage + "/" + blob->name).c_str(),
+                fn,
+                std::cref (*blob));
+        }
+    }
+
+    for (const auto & blob : blobs) {
+        if (!blob->projection.empty()) {
+            benchmark::RegisterBenchmark (
+                ("project_json/" + blob->name).c_str(),
+                projectJson,
+                std::cref (*blob));
+        }
+    }
+
+    for (size_t size : { 32, 64, 4096 }) {
+        benchmark::RegisterBenchmark (
+            ("encode_hex/" + std::to_string (size)).c_str(),
+            encode, size,
+            [](size_t n_) { return hexLength (n_); }, toHex);
+
+        benchmark::RegisterBenchmark (
+            ("encode_base64/" + std::to_string (size)).c_str(),
+            encode, size,
+            [](size_t n_) { return base64Length (n_); }, toBase64);
+    }
+
+    benchmark::Initialize (&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    // everything synthesise wrote, whatever it was called
+    for (const auto & path : BatchInspector::expand (std::string (tmp))) {
+        ::unlink (path.c_str());
+    }
+
+    ::rmdir (tmp);
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
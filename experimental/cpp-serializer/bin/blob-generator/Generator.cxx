@@ -0,0 +1,507 @@
+#include "Generator.h"
+
+#include <array>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/schema/Descriptors.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::encoder::Encoder;
+
+    const std::string PACKAGE { "net.corda.generated." };
+
+    /**
+     * Opens a value described by one of the Corda schema descriptors, or
+     * a symbol, and the list it describes, closing both when we go
+     */
+    class Described {
+        private :
+            Encoder & m_encoder;
+            bool      m_map;
+
+        public :
+            Described (Encoder & encoder_, int id_, bool map_ = false)
+                : m_encoder (encoder_)
+                , m_map (map_)
+            {
+                m_encoder.putDescribed();
+                m_encoder.putUlong (
+                    amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS | id_);
+
+                if (m_map) {
+                    m_encoder.beginMap();
+                } else {
+                    m_encoder.beginList();
+                }
+            }
+
+            Described (Encoder & encoder_, const std::string & symbol_, bool map_ = false)
+                : m_encoder (encoder_)
+                , m_map (map_)
+            {
+                m_encoder.putDescribed();
+                m_encoder.putSymbol (symbol_);
+
+                if (m_map) {
+                    m_encoder.beginMap();
+                } else {
+                    m_encoder.beginList();
+                }
+            }
+
+            Described (const Described &) = delete;
+
+            ~Described() noexcept (false) {
+                // leave whatever went wrong to be reported, the output's
+                // no use now anyway
+                if (std::uncaught_exceptions()) {
+                    return;
+                }
+
+                if (m_map) {
+                    m_encoder.endMap();
+                } else {
+                    m_encoder.endList();
+                }
+            }
+    };
+
+    std::string
+    descriptor (const std::string & name_) {
+        return "net.corda:" + name_;
+    }
+
+    void
+    putDescriptor (Encoder & encoder_, const std::string & name_) {
+        Described d (encoder_, amqp::schema::descriptors::OBJECT);
+
+        encoder_.putSymbol (descriptor (name_));
+        encoder_.putNull();
+    }
+
+    void
+    putField (
+        Encoder & encoder_,
+        const std::string & name_,
+        const std::string & type_,
+        const std::string & requires_ = ""
+    ) {
+        Described d (encoder_, amqp::schema::descriptors::FIELD);
+
+        encoder_.putString (name_);
+        encoder_.putString (requires_.empty() ? type_ : "*");
+
+        encoder_.beginList();
+        if (!requires_.empty()) {
+            encoder_.putString (requires_);
+        }
+        encoder_.endList();
+
+        encoder_.putNull();
+        encoder_.putNull();
+        encoder_.putBool (true);
+        encoder_.putBool (false);
+    }
+
+    std::string
+    listOf (const std::string & type_) {
+        return "java.util.List<" + type_ + ">";
+    }
+
+    std::string
+    mapOf (const std::string & type_) {
+        return "java.util.Map<string, " + type_ + ">";
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Generator::Shape
+ *
+ ******************************************************************************/
+
+Generator::Shape::Shape()
+    : depth (2)
+    , types (4)
+    , fields (4)
+    , list (8)
+    , map (4)
+    , string (16)
+    , count (16)
+    , bytes (0)
+    , seed (1)
+    , primitives { "int", "long", "double", "boolean", "string" }
+{
+}
+
+/******************************************************************************
+ *
+ * Generator
+ *
+ ******************************************************************************/
+
+/**
+ * Everything about the schema is decided here, from the seed, so it's the
+ * same every time we write
+ */
+Generator::Generator (Shape shape_)
+    : m_shape (std::move (shape_))
+    , m_random (m_shape.seed)
+{
+    if (m_shape.depth == 0 || m_shape.types == 0) {
+        throw std::runtime_error ("Need at least one level of one type");
+    }
+
+    if (m_shape.primitives.empty()) {
+        throw std::runtime_error ("Need at least one primitive");
+    }
+
+    for (const auto & primitive : m_shape.primitives) {
+        const auto & known = primitives();
+
+        if (std::find (known.begin(), known.end(), primitive) == known.end()) {
+            throw std::runtime_error ("Can't generate " + primitive);
+        }
+    }
+
+    m_composites.resize (m_shape.depth * m_shape.types);
+
+    for (size_t level { 0 } ; level < m_shape.depth ; ++level) {
+        for (size_t type { 0 } ; type < m_shape.types ; ++type) {
+            auto & composite = m_composites[level * m_shape.types + type];
+
+            composite.name = PACKAGE + "C" + std::to_string (level)
+                + "_" + std::to_string (type);
+            composite.descriptor = descriptor (composite.name);
+
+            for (size_t i { 0 } ; i < m_shape.fields ; ++i) {
+                composite.fields.push_back (pick (m_shape.primitives));
+            }
+
+            if (m_shape.list) {
+                composite.list = pick (m_shape.primitives);
+                restricted (listOf (composite.list), "list");
+            }
+
+            if (m_shape.map) {
+                composite.map = pick (m_shape.primitives);
+                restricted (mapOf (composite.map), "map");
+            }
+
+            composite.child = level + 1 < m_shape.depth
+                ? &m_composites[(level + 1) * m_shape.types + type]
+                : nullptr;
+        }
+    }
+
+    for (size_t type { 0 } ; type < m_shape.types ; ++type) {
+        restricted (listOf (m_composites[type].name), "list");
+    }
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
+Generator::primitives() {
+    static const std::vector<std::string> primitives {
+        "boolean", "byte", "ubyte", "short", "ushort", "int", "uint",
+        "long", "ulong", "float", "double", "char", "timestamp", "uuid",
+        "binary", "string", "symbol"
+    };
+
+    return primitives;
+}
+
+/******************************************************************************/
+
+const std::string &
+Generator::pick (const std::vector<std::string> & from_) {
+    return from_[m_random() % from_.size()];
+}
+
+/******************************************************************************/
+
+std::string
+Generator::text (size_t length_) {
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+    std::string rtn (length_, '\0');
+
+    for (auto & c : rtn) {
+        c = alphabet[m_random() % (sizeof (alphabet) - 1)];
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+Generator::restricted (const std::string & name_, const std::string & source_) {
+    auto known = std::find_if (
+            m_restricted.begin(),
+            m_restricted.end(),
+            [&name_](const auto & r_) { return r_.first == name_; });
+
+    if (known == m_restricted.end()) {
+        m_restricted.emplace_back (name_, source_);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Values come straight from the generator rather than through the standard
+ * distributions, which aren't the same from one library to the next
+ */
+void
+Generator::primitive (Encoder & encoder_, const std::string & type_) {
+    auto bits = m_random();
+
+    // a double in [-1e6, 1e6)
+    auto real = static_cast<double>(bits >> 11) * 0x1.0p-53 * 2e6 - 1e6;
+
+    if (type_ == "int") {
+        encoder_.putInt (static_cast<int32_t>(bits));
+    } else if (type_ == "long") {
+        encoder_.putLong (static_cast<int64_t>(bits));
+    } else if (type_ == "double") {
+        encoder_.putDouble (real);
+    } else if (type_ == "boolean") {
+        encoder_.putBool (bits & 1);
+    } else if (type_ == "string") {
+        encoder_.putString (text (m_shape.string));
+    } else if (type_ == "byte") {
+        encoder_.putByte (static_cast<int8_t>(bits));
+    } else if (type_ == "ubyte") {
+        encoder_.putUbyte (static_cast<uint8_t>(bits));
+    } else if (type_ == "short") {
+        encoder_.putShort (static_cast<int16_t>(bits));
+    } else if (type_ == "ushort") {
+        encoder_.putUshort (static_cast<uint16_t>(bits));
+    } else if (type_ == "uint") {
+        encoder_.putUint (static_cast<uint32_t>(bits));
+    } else if (type_ == "ulong") {
+        encoder_.putUlong (bits);
+    } else if (type_ == "float") {
+        encoder_.putFloat (static_cast<float>(real));
+    } else if (type_ == "char") {
+        encoder_.putChar ('a' + bits % 26);
+    } else if (type_ == "timestamp") {
+        // sometime before 2096
+        encoder_.putTimestamp (static_cast<int64_t>(bits % 4'000'000'000'000ULL));
+    } else if (type_ == "uuid") {
+        std::array<char, 16> uuid { };
+
+        for (size_t i { 0 } ; i < uuid.size() ; ++i) {
+            uuid[i] = static_cast<char>(i < 8 ? bits >> (8 * i) : m_random());
+        }
+
+        encoder_.putUuid (uuid);
+    } else if (type_ == "binary") {
+        std::string binary (m_shape.string, '\0');
+
+        for (auto & b : binary) {
+            b = static_cast<char>(m_random());
+        }
+
+        encoder_.putBinary (binary);
+    } else if (type_ == "symbol") {
+        encoder_.putSymbol (text (m_shape.string));
+    }
+}
+
+/******************************************************************************/
+
+void
+Generator::object (Encoder & encoder_, const Composite & composite_) {
+    Described d (encoder_, composite_.descriptor);
+
+    for (const auto & field : composite_.fields) {
+        primitive (encoder_, field);
+    }
+
+    if (!composite_.list.empty()) {
+        Described list (encoder_, descriptor (listOf (composite_.list)));
+
+        for (size_t i { 0 } ; i < m_shape.list ; ++i) {
+            primitive (encoder_, composite_.list);
+        }
+    }
+
+    if (!composite_.map.empty()) {
+        Described map (encoder_, descriptor (mapOf (composite_.map)), true);
+
+        for (size_t i { 0 } ; i < m_shape.map ; ++i) {
+            encoder_.putString ("k" + std::to_string (i));
+            primitive (encoder_, composite_.map);
+        }
+    }
+
+    if (composite_.child) {
+        object (encoder_, *composite_.child);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * With a target size each of Root's lists gets an even share of it
+ */
+void
+Generator::payload (Encoder & encoder_) {
+    Described root (encoder_, descriptor (PACKAGE + "Root"));
+
+    auto start = encoder_.size();
+
+    for (size_t type { 0 } ; type < m_shape.types ; ++type) {
+        const auto & composite = m_composites[type];
+
+        Described list (encoder_, descriptor (listOf (composite.name)));
+
+        auto until = start + m_shape.bytes * (type + 1) / m_shape.types;
+
+        for (size_t i { 0 } ; m_shape.bytes
+                ? (i == 0 || encoder_.size() < until)
+                : i < m_shape.count
+            ; ++i
+        ) {
+            object (encoder_, composite);
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+Generator::schema (Encoder & encoder_) const {
+    using namespace amqp::schema::descriptors;
+
+    Described schema (encoder_, SCHEMA);
+
+    encoder_.beginList();
+
+    {
+        Described root (encoder_, COMPOSITE_TYPE);
+
+        encoder_.putString (PACKAGE + "Root");
+        encoder_.putNull();
+        encoder_.beginList();
+        encoder_.endList();
+        putDescriptor (encoder_, PACKAGE + "Root");
+
+        encoder_.beginList();
+        for (size_t type { 0 } ; type < m_shape.types ; ++type) {
+            putField (
+                encoder_,
+                "r" + std::to_string (type),
+                "",
+                listOf (m_composites[type].name));
+        }
+        encoder_.endList();
+    }
+
+    for (const auto & composite : m_composites) {
+        Described d (encoder_, COMPOSITE_TYPE);
+
+        encoder_.putString (composite.name);
+        encoder_.putNull();
+        encoder_.beginList();
+        encoder_.endList();
+        putDescriptor (encoder_, composite.name);
+
+        encoder_.beginList();
+
+        for (size_t i { 0 } ; i < composite.fields.size() ; ++i) {
+            putField (encoder_, "f" + std::to_string (i), composite.fields[i]);
+        }
+
+        if (!composite.list.empty()) {
+            putField (encoder_, "l", "", listOf (composite.list));
+        }
+
+        if (!composite.map.empty()) {
+            putField (encoder_, "m", "", mapOf (composite.map));
+        }
+
+        if (composite.child) {
+            putField (encoder_, "c", composite.child->name);
+        }
+
+        encoder_.endList();
+    }
+
+    for (const auto & [name, source] : m_restricted) {
+        Described d (encoder_, RESTRICTED_TYPE);
+
+        encoder_.putString (name);
+        encoder_.putNull();
+        encoder_.beginList();
+        encoder_.endList();
+        encoder_.putString (source);
+        putDescriptor (encoder_, name);
+        encoder_.beginList();
+        encoder_.endList();
+    }
+
+    encoder_.endList();
+}
+
+/******************************************************************************/
+
+/**
+ * The values are drawn afresh from the seed every time so writing the
+ * same Generator twice writes the same blob twice
+ */
+void
+Generator::write (Encoder & encoder_) {
+    using namespace amqp::schema::descriptors;
+
+    m_random.seed (m_shape.seed + 1);
+
+    encoder_.putRaw ({ amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size() });
+    encoder_.putRaw (std::string (1, static_cast<char>(amqp::DATA_AND_STOP)));
+
+    Described envelope (encoder_, ENVELOPE);
+
+    payload (encoder_);
+    schema (encoder_);
+
+    {
+        Described transforms (encoder_, TRANSFORM_SCHEMA, true);
+    }
+}
+
+/******************************************************************************/
+
+uint64_t
+Generator::write (int fd_) {
+    Encoder encoder (fd_);
+
+    write (encoder);
+    encoder.flush();
+
+    return encoder.size();
+}
+
+/******************************************************************************/
+
+std::string
+Generator::blob() {
+    Encoder encoder;
+
+    write (encoder);
+
+    return encoder.str();
+}
+
+/******************************************************************************/
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "amqp/encoder/Encoder.h"
+
+/******************************************************************************/
+
+/**
+ * Makes up Corda blobs, header, envelope, schema and payload, of whatever
+ * shape and size is wanted. What it writes depends only on the [Shape]
+ * it's given, the seed included, so the same blob can be made again
+ * anywhere without a JVM.
+ *
+ * The payload is a Root object with one list per composite type at the
+ * top level. Each composite has a run of primitive fields, a list and a
+ * map of primitives, and below the last level a field holding the
+ * composite one level further down. There are [Shape::types] composite
+ * types at each of [Shape::depth] levels, each with its own mix of
+ * primitives.
+ */
+class Generator {
+    public :
+        struct Shape {
+            /**
+             * Levels of composite, one is a list of flat objects
+             */
+            size_t depth;
+
+            /**
+             * Composite types at each level
+             */
+            size_t types;
+
+            /**
+             * Primitive fields on each composite
+             */
+            size_t fields;
+
+            /**
+             * Elements of the list, and entries of the map, on each
+             * composite, zero for none
+             */
+            size_t list;
+            size_t map;
+
+            /**
+             * Length of strings, symbols and binaries
+             */
+            size_t string;
+
+            /**
+             * Objects in each of Root's lists
+             */
+            size_t count;
+
+            /**
+             * When set [count] is ignored and objects are added until the
+             * blob is at least this many bytes
+             */
+            uint64_t bytes;
+
+            uint64_t seed;
+
+            /**
+             * The Corda names of the primitives to pick from
+             */
+            std::vector<std::string> primitives;
+
+            Shape();
+        };
+
+    private :
+        struct Composite {
+            std::string name;
+            std::string descriptor;
+
+            std::vector<std::string> fields;
+
+            std::string list;
+            std::string map;
+
+            const Composite * child;
+        };
+
+        Shape m_shape;
+
+        /**
+         * Level by level, [Shape::types] of them to each
+         */
+        std::vector<Composite> m_composites;
+
+        /**
+         * Lists and maps, by the name of their type
+         */
+        std::vector<std::pair<std::string, std::string>> m_restricted;
+
+        std::mt19937_64 m_random;
+
+        const std::string & pick (const std::vector<std::string> &);
+
+        std::string text (size_t);
+
+        void restricted (const std::string &, const std::string &);
+
+        void primitive (amqp::internal::encoder::Encoder &, const std::string &);
+        void object (amqp::internal::encoder::Encoder &, const Composite &);
+        void payload (amqp::internal::encoder::Encoder &);
+        void schema (amqp::internal::encoder::Encoder &) const;
+
+    public :
+        explicit Generator (Shape);
+
+        /**
+         * Write a whole blob, the Corda header first
+         */
+        void write (amqp::internal::encoder::Encoder &);
+
+        /**
+         * Write a whole blob to [fd_]
+         *
+         * @return its size
+         */
+        uint64_t write (int fd_);
+
+        std::string blob();
+
+        /**
+         * Everything [Shape::primitives] may name
+         */
+        static const std::vector<std::string> & primitives();
+};
+
+/******************************************************************************/
@@ -0,0 +1,165 @@
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Generator.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_
+            << " [-d depth] [-t types] [-f fields] [-l list] [-m map]"
+            << " [-s string] [-p primitives] [-n count | -b bytes]"
+            << " [-r seed] [-N blobs] <file | - | dir>"
+            << std::endl
+            << "    -d  levels of nested composites (2)" << std::endl
+            << "    -t  composite types at each level (4)" << std::endl
+            << "    -f  primitive fields on each composite (4)" << std::endl
+            << "    -l  elements in each composite's list, 0 for none (8)"
+            << std::endl
+            << "    -m  entries in each composite's map, 0 for none (4)"
+            << std::endl
+            << "    -s  length of strings, symbols and binaries (16)"
+            << std::endl
+            << "    -p  comma separated primitives to pick from"
+            << " (int,long,double,boolean,string)" << std::endl
+            << "    -n  objects in each top level list (16)" << std::endl
+            << "    -b  instead of -n, grow the blob to this size,"
+            << " K, M and G suffixes allowed" << std::endl
+            << "    -r  seed, the same seed and shape make the same blob (1)"
+            << std::endl
+            << "    -N  write this many blobs, seeded one after another,"
+            << " into a directory" << std::endl;
+    }
+
+    uint64_t
+    bytes (const std::string & arg_) {
+        char * end;
+        uint64_t rtn = std::strtoull (arg_.c_str(), &end, 10);
+
+        switch (*end) {
+            case 'G' : case 'g' : rtn <<= 10; [[fallthrough]];
+            case 'M' : case 'm' : rtn <<= 10; [[fallthrough]];
+            case 'K' : case 'k' : rtn <<= 10; break;
+            case '\0' : break;
+            default :
+                throw std::runtime_error ("Bad size " + arg_);
+        }
+
+        return rtn;
+    }
+
+    std::vector<std::string>
+    split (const std::string & arg_) {
+        std::vector<std::string> rtn;
+        std::stringstream ss (arg_);
+
+        for (std::string primitive; std::getline (ss, primitive, ','); ) {
+            if (!primitive.empty()) {
+                rtn.emplace_back (std::move (primitive));
+            }
+        }
+
+        return rtn;
+    }
+
+    uint64_t
+    generate (const Generator::Shape & shape_, const std::string & path_) {
+        Generator generator (shape_);
+
+        if (path_ == "-") {
+            return generator.write (STDOUT_FILENO);
+        }
+
+        int fd = ::open (path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+        if (fd < 0) {
+            throw std::runtime_error ("Cannot open " + path_);
+        }
+
+        try {
+            auto rtn = generator.write (fd);
+            ::close (fd);
+            return rtn;
+        } catch (...) {
+            ::close (fd);
+            throw;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    Generator::Shape shape;
+    size_t blobs { 0 };
+
+    try {
+        int opt;
+        while ((opt = getopt (argc, argv, "d:t:f:l:m:s:p:n:b:r:N:")) != -1) {
+            switch (opt) {
+                case 'd' : shape.depth = std::strtoul (optarg, nullptr, 10); break;
+                case 't' : shape.types = std::strtoul (optarg, nullptr, 10); break;
+                case 'f' : shape.fields = std::strtoul (optarg, nullptr, 10); break;
+                case 'l' : shape.list = std::strtoul (optarg, nullptr, 10); break;
+                case 'm' : shape.map = std::strtoul (optarg, nullptr, 10); break;
+                case 's' : shape.string = std::strtoul (optarg, nullptr, 10); break;
+                case 'p' : shape.primitives = split (optarg); break;
+                case 'n' : shape.count = std::strtoul (optarg, nullptr, 10); break;
+                case 'b' : shape.bytes = bytes (optarg); break;
+                case 'r' : shape.seed = std::strtoull (optarg, nullptr, 10); break;
+                case 'N' : blobs = std::strtoul (optarg, nullptr, 10); break;
+                default :
+                    usage (argv[0]);
+                    return EXIT_FAILURE;
+            }
+        }
+
+        if (optind + 1 != argc) {
+            usage (argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        std::string path { argv[optind] };
+
+        if (!blobs) {
+            generate (shape, path);
+            return EXIT_SUCCESS;
+        }
+
+        if (::mkdir (path.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw std::runtime_error ("Cannot make " + path);
+        }
+
+        auto seed = shape.seed;
+
+        for (size_t i { 0 } ; i < blobs ; ++i) {
+            shape.seed = seed + i;
+
+            // zero padded so they list in the order they were made
+            auto name = std::to_string (i);
+            name.insert (0, name.size() < 6 ? 6 - name.size() : 0, '0');
+
+            generate (shape, path + "/" + name);
+        }
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
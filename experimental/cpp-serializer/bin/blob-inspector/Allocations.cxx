@@ -0,0 +1,50 @@
+#include <new>
+#include <cstdlib>
+
+#include "amqp/Stats.h"
+
+/******************************************************************************/
+
+/*
+ * Replaces the global operator new so --stats can count allocations. It's
+ * only linked into the blob-inspector binary itself, anything else using
+ * the library keeps its own allocator and has no allocations reported.
+ *
+ * The array forms come through these too, the over aligned ones are left
+ * alone as nothing here makes any.
+ */
+
+namespace {
+
+    const bool counting = (amqp::internal::Stats::countingAllocations(), true);
+
+}
+
+/******************************************************************************/
+
+void *
+operator new (std::size_t size_) {
+    amqp::internal::Stats::allocated();
+
+    if (void * rtn = std::malloc (size_ ? size_ : 1)) {
+        return rtn;
+    }
+
+    throw std::bad_alloc();
+}
+
+/******************************************************************************/
+
+void
+operator delete (void * ptr_) noexcept {
+    std::free (ptr_);
+}
+
+/******************************************************************************/
+
+void
+operator delete (void * ptr_, std::size_t) noexcept {
+    std::free (ptr_);
+}
+
+/******************************************************************************/
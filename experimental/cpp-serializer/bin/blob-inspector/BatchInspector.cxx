@@ -0,0 +1,381 @@
+#include "BatchInspector.h"
+
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <ostream>
+#include <optional>
+#include <functional>
+#include <algorithm>
+#include <stdexcept>
+#include <condition_variable>
+
+#include <glob.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "CordaBytes.h"
+#include "CordaStream.h"
+#include "BlobInspector.h"
+
+#include "amqp/reader/visitors/JsonWriter.h"
+
+/******************************************************************************/
+
+namespace {
+
+    bool
+    isDirectory (const std::string & path_) {
+        struct stat results { };
+        return ::stat (path_.c_str(), &results) == 0 && S_ISDIR (results.st_mode);
+    }
+
+    bool
+    isRegular (const std::string & path_) {
+        struct stat results { };
+        return ::stat (path_.c_str(), &results) == 0 && S_ISREG (results.st_mode);
+    }
+
+    struct CloseDir {
+        void operator() (DIR * dir_) const { ::closedir (dir_); }
+    };
+
+    std::vector<std::string>
+    directory (const std::string & path_) {
+        std::vector<std::string> rtn;
+
+        std::unique_ptr<DIR, CloseDir> dir { ::opendir (path_.c_str()) };
+
+        if (!dir) {
+            throw std::runtime_error ("Cannot open directory " + path_);
+        }
+
+        auto prefix = path_.back() == '/' ? path_ : path_ + "/";
+
+        while (auto entry = ::readdir (dir.get())) {
+            auto file = prefix + entry->d_name;
+
+            if (entry->d_name[0] != '.' && isRegular (file)) {
+                rtn.emplace_back (std::move (file));
+            }
+        }
+
+        std::sort (rtn.begin(), rtn.end());
+
+        return rtn;
+    }
+
+    std::vector<std::string>
+    list (const std::string & path_) {
+        std::ifstream file { path_ };
+
+        if (!file) {
+            throw std::runtime_error ("Cannot open list " + path_);
+        }
+
+        std::vector<std::string> rtn;
+
+        for (std::string line; std::getline (file, line); ) {
+            if (!line.empty()) {
+                rtn.emplace_back (std::move (line));
+            }
+        }
+
+        return rtn;
+    }
+
+    std::vector<std::string>
+    globbed (const std::string & pattern_) {
+        glob_t results { };
+
+        std::vector<std::string> rtn;
+
+        if (::glob (pattern_.c_str(), 0, nullptr, &results) == 0) {
+            rtn.assign (results.gl_pathv, results.gl_pathv + results.gl_pathc);
+        }
+
+        ::globfree (&results);
+
+        return rtn;
+    }
+
+    /**
+     * The outcome of a single blob, exactly one of these will be set
+     */
+    struct Result {
+        std::string value;
+        std::string error;
+
+        amqp::internal::Stats stats;
+    };
+
+}
+
+/******************************************************************************/
+
+BatchInspector::BatchInspector (
+    size_t threads_,
+    BlobInspector::Format format_,
+    const amqp::internal::reader::Projection * projection_,
+    sPtr<const amqp::internal::SchemaCache::Entry> as_,
+    amqp::internal::reader::JsonWriter::Binary binary_,
+    bool classify_,
+    bool share_
+) : m_threads (threads_ ? threads_ : std::max (1U, std::thread::hardware_concurrency()))
+  , m_window (4 * m_threads)
+  , m_format (format_)
+  , m_projection (projection_)
+  , m_as (std::move (as_))
+  , m_binary (binary_)
+  , m_classify (classify_)
+  , m_share (share_)
+{
+}
+
+/******************************************************************************/
+
+std::vector<std::string>
+BatchInspector::expand (const std::string & arg_) {
+    if (arg_.size() > 1 && arg_[0] == '@') {
+        return list (arg_.substr (1));
+    }
+
+    if (isDirectory (arg_)) {
+        return directory (arg_);
+    }
+
+    if (arg_.find_first_of ("*?[") != std::string::npos) {
+        return globbed (arg_);
+    }
+
+    return { arg_ };
+}
+
+/******************************************************************************/
+
+std::vector<std::string>
+BatchInspector::expand (const std::vector<std::string> & args_) {
+    std::vector<std::string> rtn;
+
+    for (const auto & arg : args_) {
+        auto paths = expand (arg);
+        rtn.insert (rtn.end(), paths.begin(), paths.end());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string
+BatchInspector::inspect (
+    amqp::internal::DecodeContext & context_,
+    CordaBytes & cb_,
+    const std::string & name_
+) const {
+    using amqp::internal::reader::JsonWriter;
+
+    if (cb_.encoding() != amqp::DATA_AND_STOP) {
+        throw std::runtime_error ("Bad encoding");
+    }
+
+    BlobInspector inspector (context_, cb_, m_projection, m_as);
+
+    if (m_format == BlobInspector::text_t) {
+        return name_ + " : " + (m_classify
+            ? inspector.classification()
+            : inspector.text (m_share));
+    }
+
+    auto & writer = context_.json (
+        m_format == BlobInspector::pretty_t
+            ? JsonWriter::pretty_t
+            : JsonWriter::compact_t,
+        m_binary);
+
+    if (m_classify) {
+        inspector.classify (writer, name_);
+    } else {
+        inspector.json (writer, name_);
+    }
+
+    return writer.str();
+}
+
+/******************************************************************************/
+
+size_t
+BatchInspector::run (
+    const std::vector<std::string> & paths_,
+    std::ostream & out_,
+    std::ostream & err_,
+    amqp::internal::Stats * stats_
+) const {
+    return run (
+        paths_.size(),
+        [this, &paths_](amqp::internal::DecodeContext & context_, size_t job_) {
+            CordaBytes cb (paths_[job_]);
+
+            return inspect (context_, cb, paths_[job_]);
+        },
+        [&paths_](size_t job_) { return paths_[job_]; },
+        out_, err_, stats_);
+}
+
+/******************************************************************************/
+
+/**
+ * The file is walked once up front to find its sections, which doesn't
+ * read any of them, and then they're shared out like any other batch
+ */
+size_t
+BatchInspector::run (
+    const std::string & path_,
+    CordaStream & stream_,
+    std::ostream & out_,
+    std::ostream & err_,
+    amqp::internal::Stats * stats_
+) const {
+    auto sections = stream_.sections();
+
+    auto name = [&path_, &sections](size_t job_) {
+        return path_ + "@" + std::to_string (sections[job_].offset);
+    };
+
+    return run (
+        sections.size(),
+        [this, &sections, &name](amqp::internal::DecodeContext & context_, size_t job_) {
+            const auto & section = sections[job_];
+            CordaBytes cb (section.encoding, section.bytes, section.size);
+
+            return inspect (context_, cb, name (job_));
+        },
+        name,
+        out_, err_, stats_);
+}
+
+/******************************************************************************/
+
+/**
+ * Workers claim blobs in order from a shared counter and park their result
+ * in that blob's slot. We write results out from the calling thread as soon
+ * as the next one in sequence is ready.
+ *
+ * No worker gets more than [m_window] ahead of what's been written, so
+ * that many slots, reused in turn, are all we need however many blobs
+ * there are.
+ */
+size_t
+BatchInspector::run (
+    size_t jobs_,
+    const std::function<std::string (amqp::internal::DecodeContext &, size_t)> & inspect_,
+    const std::function<std::string (size_t)> & name_,
+    std::ostream & out_,
+    std::ostream & err_,
+    amqp::internal::Stats * stats_
+) const {
+    std::vector<std::optional<Result>> results (m_window);
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable space;
+
+    std::atomic<size_t> nextJob { 0 };
+    size_t written { 0 };
+
+    auto worker = [&]() {
+        // kept for every blob this worker reads, so once it's seen a few
+        // it has all the room it needs
+        amqp::internal::DecodeContext context;
+
+        for (;;) {
+            auto job = nextJob++;
+
+            if (job >= jobs_) {
+                return;
+            }
+
+            {
+                std::unique_lock<std::mutex> lock (mutex);
+                space.wait (lock, [&]() { return job < written + m_window; });
+            }
+
+            Result result;
+
+            try {
+                std::optional<amqp::internal::Stats::Scope> scope;
+
+                if (stats_) {
+                    scope.emplace (result.stats);
+                }
+
+                result.value = inspect_ (context, job);
+            } catch (const std::exception & e) {
+                // an empty error reads as success, so never leave one
+                result.error = *e.what() ? e.what() : "Unknown error";
+            } catch (...) {
+                // anything escaping a worker would take the whole run down
+                result.error = "Unknown error";
+            }
+
+            {
+                std::lock_guard<std::mutex> lock (mutex);
+                results[job % m_window] = std::move (result);
+            }
+
+            ready.notify_one();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    auto threads = std::min (m_threads, std::max<size_t> (1, jobs_));
+
+    for (size_t i { 0 } ; i < threads ; ++i) {
+        pool.emplace_back (worker);
+    }
+
+    size_t failed { 0 };
+
+    while (written < jobs_) {
+        Result result;
+
+        {
+            std::unique_lock<std::mutex> lock (mutex);
+            auto & slot = results[written % m_window];
+
+            ready.wait (lock, [&]() { return slot.has_value(); });
+
+            result = std::move (*slot);
+            slot.reset();
+        }
+
+        if (result.error.empty()) {
+            out_ << result.value << std::endl;
+        } else {
+            ++failed;
+            err_ << name_ (written) << " : " << result.error << std::endl;
+        }
+
+        if (stats_) {
+            err_ << name_ (written) << " : " << result.stats.summary() << std::endl;
+            *stats_ += result.stats;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+            ++written;
+        }
+
+        space.notify_all();
+    }
+
+    for (auto & thread : pool) {
+        thread.join();
+    }
+
+    return failed;
+}
+
+/******************************************************************************/
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <functional>
+
+#include "CordaStream.h"
+#include "BlobInspector.h"
+
+#include "amqp/Stats.h"
+
+/******************************************************************************/
+
+/**
+ * Inspects many blobs at once on a pool of worker threads.
+ *
+ * Output is written in the order the blobs were given to us regardless of
+ * the order they finish in, each one prefixed with its path or, for JSON,
+ * with its path recorded in the object written for it. A blob that
+ * fails to decode reports its error on the error stream, in its place, and
+ * the run carries on.
+ */
+class BatchInspector {
+    private :
+        size_t m_threads;
+
+        /**
+         * How far ahead of the output the workers may get, bounds the number
+         * of finished but unwritten results we hold on to
+         */
+        size_t m_window;
+
+        BlobInspector::Format m_format;
+
+        const amqp::internal::reader::Projection * m_projection;
+
+        sPtr<const amqp::internal::SchemaCache::Entry> m_as;
+
+        amqp::internal::reader::JsonWriter::Binary m_binary;
+
+        /**
+         * Only say what each blob is, see [BlobInspector::classify]
+         */
+        bool m_classify;
+
+        /**
+         * Read each referenced object once, see [BlobInspector::text]
+         */
+        bool m_share;
+
+        std::string inspect (
+            amqp::internal::DecodeContext &,
+            CordaBytes &,
+            const std::string & name_) const;
+
+        /**
+         * Run [inspect_] for every job from 0 to [jobs_], [name_] saying
+         * which blob a job is when reporting on it
+         */
+        size_t run (
+            size_t jobs_,
+            const std::function<std::string (amqp::internal::DecodeContext &, size_t)> & inspect_,
+            const std::function<std::string (size_t)> & name_,
+            std::ostream & out_,
+            std::ostream & err_,
+            amqp::internal::Stats * stats_) const;
+
+    public :
+        explicit BatchInspector (
+            size_t threads_ = 0,
+            BlobInspector::Format format_ = BlobInspector::text_t,
+            const amqp::internal::reader::Projection * projection_ = nullptr,
+            sPtr<const amqp::internal::SchemaCache::Entry> as_ = nullptr,
+            amqp::internal::reader::JsonWriter::Binary binary_ =
+                amqp::internal::reader::JsonWriter::hex_t,
+            bool classify_ = false,
+            bool share_ = false);
+
+        /**
+         * Expand a single command line argument into the blobs it names
+         *
+         *  - a directory, every regular file in it in name order
+         *  - @file, a file with one path per line
+         *  - anything with glob characters is expanded as a glob
+         *  - otherwise the argument itself
+         */
+        static std::vector<std::string> expand (const std::string &);
+
+        static std::vector<std::string> expand (
+                const std::vector<std::string> &);
+
+        /**
+         * When given [stats_] each blob's stats are written to [err_] as it
+         * is and added to [stats_]
+         *
+         * @return the number of blobs that failed
+         */
+        size_t run (
+            const std::vector<std::string> & paths_,
+            std::ostream & out_,
+            std::ostream & err_,
+            amqp::internal::Stats * stats_ = nullptr) const;
+
+        /**
+         * As above but for every envelope in one file of many, each
+         * named as [path_]@ the offset of its header
+         */
+        size_t run (
+            const std::string & path_,
+            CordaStream & stream_,
+            std::ostream & out_,
+            std::ostream & err_,
+            amqp::internal::Stats * stats_ = nullptr) const;
+
+        size_t threads() const { return m_threads; }
+};
+
+/******************************************************************************/
+
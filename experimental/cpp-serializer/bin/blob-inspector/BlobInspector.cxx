@@ -1,73 +1,328 @@
 #include "BlobInspector.h"
 #include "CordaBytes.h"
 
+#include <memory>
+#include <cassert>
 #include <iostream>
-#include <sstream>
-
-#include "proton/codec.h"
-#include "proton/proton_wrapper.h"
 
+#include "amqp/Stats.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/reader/visitors/CountingVisitor.h"
+#include "amqp/reader/visitors/StreamVisitor.h"
+#include "amqp/reader/visitors/TreeVisitor.h"
+#include "amqp/schema/Descriptors.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
-#include "amqp/CompositeFactory.h"
-#include "amqp/schema/described-types/Envelope.h"
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Always sixteen digits so fingerprints sort and line up
+     */
+    std::string
+    hex (uint64_t value_) {
+        const char * digits = "0123456789abcdef";
+        std::string rtn (16, '0');
+
+        for (auto it = rtn.rbegin() ; value_ ; value_ >>= 4) {
+            *it++ = digits[value_ & 0xf];
+        }
+
+        return rtn;
+    }
+
+}
 
 /******************************************************************************/
 
-BlobInspector::BlobInspector (CordaBytes & cb_)
-    : m_data { pn_data (cb_.size()) }
+BlobInspector::BlobInspector (
+    CordaBytes & cb_,
+    const amqp::internal::reader::Projection * projection_,
+    sPtr<const amqp::internal::SchemaCache::Entry> as_
+) : m_owned (std::make_unique<amqp::internal::DecodeContext>())
+  , m_context (*m_owned)
+  , m_projection (projection_)
+  , m_as (std::move (as_))
+  , m_size (cb_.size())
 {
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (m_data, cb_.bytes(), cb_.size());
-    assert (rtn == cb_.size());
+    m_context.reset (cb_.bytes(), cb_.size());
 }
 
 /******************************************************************************/
 
-std::string
-BlobInspector::dump() {
-    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+BlobInspector::BlobInspector (
+    amqp::internal::DecodeContext & context_,
+    CordaBytes & cb_,
+    const amqp::internal::reader::Projection * projection_,
+    sPtr<const amqp::internal::SchemaCache::Entry> as_
+) : m_context (context_)
+  , m_projection (projection_)
+  , m_as (std::move (as_))
+  , m_size (cb_.size())
+{
+    m_context.reset (cb_.bytes(), cb_.size());
+}
 
-    if (pn_data_is_described (m_data)) {
-        proton::auto_enter p (m_data);
+/******************************************************************************/
+
+/**
+ * An envelope is a described list of the payload, the schema and the
+ * transforms schema. We don't bother exiting it again, once we've found
+ * what we want from it there's nothing else in the blob.
+ */
+void
+BlobInspector::envelope() {
+    using namespace amqp::internal;
 
-        auto a = pn_data_get_ulong(m_data);
+    auto & data = m_context.data();
 
-        envelope.reset (
-                dynamic_cast<amqp::internal::schema::Envelope *> (
-                        amqp::internal::AMQPDescriptorRegistory[a]->build(m_data).release()));
+    decoder::is_described (&data);
+    data.enter();
+    data.next();
+
+    decoder::is_ulong (&data);
+    if (amqp::stripCorda (data.get_ulong())
+        != static_cast<uint32_t>(amqp::schema::descriptors::ENVELOPE)
+    ) {
+        throw std::runtime_error ("Expected an Envelope");
     }
 
-    amqp::internal::CompositeFactory cf;
+    data.next();
+    decoder::is_list (&data);
+    data.enter();
+    data.next();
+}
 
-    cf.process (envelope->schema());
+/******************************************************************************/
+
+/**
+ * Parsing the schema and building its readers is the expensive part of all
+ * this and most blobs share a schema with one we've already seen. The
+ * transforms, where there are any, follow the schema
+ */
+sPtr<const amqp::internal::SchemaCache::Entry>
+BlobInspector::schema() {
+    auto & data = m_context.data();
+    auto schema = data.encoded();
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
-    assert (reader);
+    return amqp::internal::SchemaCache::instance().get (
+            schema,
+            data.next() ? data.encoded() : std::string_view());
+}
+
+/******************************************************************************/
+
+sPtr<const amqp::internal::SchemaCache::Entry>
+BlobInspector::schema (CordaBytes & cb_) {
+    BlobInspector inspector (cb_);
+
+    inspector.envelope();
+    inspector.m_context.data().next();
+
+    return inspector.schema();
+}
+
+/******************************************************************************/
+
+/**
+ * Only the schema is handed to proton, and then only the first time we
+ * see it, the payload is read by our readers straight out of the blob.
+ */
+void
+BlobInspector::visit (amqp::reader::IVisitor & visitor_) {
+    using namespace amqp::internal;
+
+    auto * stats = Stats::current();
+
+    auto & data = m_context.data();
+    auto & payload = m_context.payload();
+    auto & descriptor = m_context.descriptor();
 
     {
-        // move to the actual blob entry in the tree - ideally we'd have
-        // saved this on the Envelope but that's not easily doable as we
-        // can't grab an actual copy of our data pointer
-        proton::auto_enter p (m_data);
-        pn_data_next (m_data);
-        proton::is_list (m_data);
-        assert (pn_data_get_list (m_data) == 3);
-        {
-            proton::auto_enter p (m_data);
+        Stats::Timer timer (Stats::envelope_t);
 
-            std::stringstream ss;
+        envelope();
 
-            // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            ss << reader->dump ("{ Parsed", m_data, envelope->schema())->dump()
-               << " }";
+        // remember where the payload is, we can't read it until we have
+        // the schema which comes after it
+        payload = data;
 
-            return ss.str();
+        {
+            decoder::is_described (&data);
+            decoder::auto_enter ae3 (&data);
+            decoder::is_symbol (&data);
+            descriptor.assign (data.get_symbol());
         }
+
+        data.next();
+    }
+
+    sPtr<const SchemaCache::Entry> schema;
+    sPtr<CompositeFactory::ReaderType> reader;
+
+    {
+        Stats::Timer timer (Stats::schema_t);
+
+        schema = this->schema();
+        reader = schema->byDescriptor (descriptor, m_as);
+        assert (reader);
+    }
+
+    Stats::Timer timer (Stats::render_t);
+
+    if (!stats) {
+        render (*reader, schema->schema(), visitor_);
+        return;
+    }
+
+    stats->blobs += 1;
+    stats->bytes += m_size;
+
+    // the schema keeps its types grouped by what they depend on
+    for (const auto & group : schema->schema().types()) {
+        stats->types += group.size();
+    }
+
+    reader::CountingVisitor counter (visitor_);
+    render (*reader, schema->schema(), counter);
+
+    stats->values += counter.values();
+    stats->nodes += counter.nodes();
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::render (
+    const amqp::internal::CompositeFactory::ReaderType & reader_,
+    const amqp::internal::schema::Schema & schema_,
+    amqp::reader::IVisitor & visitor_
+) {
+    auto & payload = m_context.payload();
+
+    if (m_projection) {
+        m_projection->visit (
+                dynamic_cast<const amqp::internal::reader::Reader &>(reader_),
+                &payload,
+                schema_,
+                visitor_);
+    } else {
+        reader_.visit (&payload, schema_, visitor_);
+    }
+}
+
+/******************************************************************************/
+
+const std::string &
+BlobInspector::text (bool share_) {
+    auto & ss = m_context.text();
+
+    // We wrap our output like this to make sure it's valid JSON to
+    // facilitate easy pretty printing
+    if (share_) {
+        amqp::internal::reader::TreeVisitor visitor (true);
+
+        visitor.key ("{ Parsed");
+        visit (visitor);
+
+        ss << visitor.result()->dump();
+    } else {
+        amqp::internal::reader::StreamVisitor visitor (ss);
+
+        visitor.key ("{ Parsed");
+        visit (visitor);
+    }
+
+    ss << " }";
+
+    return m_context.str();
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::classify (
+    amqp::reader::IVisitor & visitor_,
+    const std::string & file_
+) {
+    using amqp::internal::Stats;
+
+    if (auto * stats = Stats::current()) {
+        stats->blobs += 1;
+        stats->bytes += m_size;
+    }
+
+    const amqp::internal::Classifier::Classification * classification;
+
+    {
+        Stats::Timer timer (Stats::envelope_t);
+
+        classification = &m_context.classifier().classify (m_context.data());
+    }
+
+    Stats::Timer timer (Stats::render_t);
+
+    visitor_.beginComposite ("");
+
+    if (!file_.empty()) {
+        visitor_.key ("file");
+        visitor_.stringValue (file_);
     }
+
+    visitor_.key ("descriptor");
+    visitor_.stringValue (classification->descriptor);
+
+    visitor_.key ("fingerprint");
+    visitor_.stringValue (hex (classification->fingerprint));
+
+    visitor_.key ("types");
+    visitor_.beginList();
+
+    for (const auto & type : classification->types) {
+        visitor_.stringValue (type);
+    }
+
+    visitor_.endList();
+    visitor_.endComposite();
+}
+
+/******************************************************************************/
+
+const std::string &
+BlobInspector::classification() {
+    amqp::internal::reader::StreamVisitor visitor (m_context.text());
+
+    classify (visitor);
+
+    return m_context.str();
+}
+
+/******************************************************************************/
+
+std::string
+BlobInspector::dump() {
+    return text();
+}
+
+/******************************************************************************/
+
+void
+BlobInspector::json (
+    amqp::internal::reader::JsonWriter & writer_,
+    const std::string & file_
+) {
+    writer_.beginComposite ("");
+
+    if (!file_.empty()) {
+        writer_.key ("file");
+        writer_.stringValue (file_);
+    }
+
+    writer_.key ("Parsed");
+    visit (writer_);
+
+    writer_.endComposite();
 }
 
 /******************************************************************************/
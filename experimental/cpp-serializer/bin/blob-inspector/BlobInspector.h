@@ -3,21 +3,117 @@
 #include <iosfwd>
 #include "CordaBytes.h"
 
-/******************************************************************************/
-
-struct pn_data_t;
+#include "amqp/SchemaCache.h"
+#include "amqp/DecodeContext.h"
+#include "amqp/reader/IVisitor.h"
+#include "amqp/reader/Projection.h"
+#include "amqp/reader/visitors/JsonWriter.h"
 
 /******************************************************************************/
 
 class BlobInspector {
+    public :
+        enum Format { text_t, json_t, pretty_t };
+
     private :
-        pn_data_t * m_data;
+        /**
+         * Set when we weren't given a context and had to make our own
+         */
+        uPtr<amqp::internal::DecodeContext> m_owned;
+
+        amqp::internal::DecodeContext & m_context;
+
+        /**
+         * When set only what it selects is reported
+         */
+        const amqp::internal::reader::Projection * m_projection;
+
+        /**
+         * When set the blob is reported as though it had been written
+         * with the types in this schema
+         */
+        sPtr<const amqp::internal::SchemaCache::Entry> m_as;
+
+        /**
+         * Of the blob, less the Corda header
+         */
+        size_t m_size;
+
+        /**
+         * Step into the envelope, leaving us on the payload
+         */
+        void envelope();
+
+        sPtr<const amqp::internal::SchemaCache::Entry> schema();
+
+        void render (
+            const amqp::internal::CompositeFactory::ReaderType &,
+            const amqp::internal::schema::Schema &,
+            amqp::reader::IVisitor &);
 
     public :
-        BlobInspector (CordaBytes &);
+        explicit BlobInspector (
+            CordaBytes &,
+            const amqp::internal::reader::Projection * projection_ = nullptr,
+            sPtr<const amqp::internal::SchemaCache::Entry> as_ = nullptr);
+
+        /**
+         * Read the blob with, and write its output into, [context_], which
+         * is reset for it. Anything read or written with it before is
+         * gone.
+         */
+        BlobInspector (
+            amqp::internal::DecodeContext & context_,
+            CordaBytes &,
+            const amqp::internal::reader::Projection * projection_ = nullptr,
+            sPtr<const amqp::internal::SchemaCache::Entry> as_ = nullptr);
+
+        /**
+         * The schema a blob was written with, for reading others as
+         */
+        static sPtr<const amqp::internal::SchemaCache::Entry> schema (
+            CordaBytes &);
+
+        /**
+         * Walk the payload of the blob reporting what we find
+         */
+        void visit (amqp::reader::IVisitor &);
+
+        /**
+         * Report what the blob is, the descriptor of its payload, the
+         * fingerprint of its schema and the names of the types in that,
+         * without reading either. Tagged with the file it came from if
+         * we're given one.
+         */
+        void classify (amqp::reader::IVisitor &, const std::string & file_ = "");
+
+        /**
+         * [classify] as text into our context
+         *
+         * @return what was written, good until the context is next reset
+         */
+        const std::string & classification();
+
+        /**
+         * Write the blob out as text into our context. With [share_] it's
+         * first built into a tree where every object the blob refers back
+         * to is read once and shared, rather than read again for each
+         * reference, and that tree written out. The text is the same.
+         *
+         * @return what was written, good until the context is next reset
+         */
+        const std::string & text (bool share_ = false);
 
         std::string dump();
 
+        /**
+         * Write the blob as a JSON object, { "Parsed" : ... }, tagged with
+         * the file it came from if we're given one
+         */
+        void json (
+            amqp::internal::reader::JsonWriter &,
+            const std::string & file_ = "");
+
 };
 
 /******************************************************************************/
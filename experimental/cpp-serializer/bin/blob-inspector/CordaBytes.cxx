@@ -1,38 +1,175 @@
 #include "CordaBytes.h"
 
 #include <array>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+
+#include "amqp/Stats.h"
 #include "amqp/AMQPHeader.h"
 
 /******************************************************************************/
 
+static_assert (CordaBytes::HEADER_SIZE == amqp::AMQP_HEADER.size() + 1);
+
+/******************************************************************************/
+
 CordaBytes::CordaBytes (const std::string & file_)
-    : m_blob { nullptr }
+    : m_encoding { amqp::DATA_AND_STOP }
+    , m_size { 0 }
+    , m_blob { nullptr }
+    , m_mapped { nullptr }
+    , m_mappedSize { 0 }
 {
-    std::ifstream file { file_, std::ios::in | std::ios::binary };
+    amqp::internal::Stats::Timer timer (amqp::internal::Stats::read_t);
+
+    if (file_ == "-") {
+        readStream (std::cin);
+        return;
+    }
+
     struct stat results { };
 
     if (::stat(file_.c_str(), &results) != 0) {
         throw std::runtime_error ("Not a file");
     }
 
-    // Disregard the Corda header
-    m_size = results.st_size - (amqp::AMQP_HEADER.size() + 1);
+    if (S_ISREG (results.st_mode)) {
+        int fd = ::open (file_.c_str(), O_RDONLY);
+
+        if (fd < 0) {
+            throw std::runtime_error ("Cannot open " + file_);
+        }
+
+        map (fd, results.st_size);
+        ::close (fd);
+
+        if (mapped()) {
+            return;
+        }
+    }
+
+    // Not something we can map, fall back to reading it in
+    std::ifstream file { file_, std::ios::in | std::ios::binary };
+    readStream (file);
+}
+
+/******************************************************************************/
+
+CordaBytes::CordaBytes (std::istream & stream_)
+    : m_encoding { amqp::DATA_AND_STOP }
+    , m_size { 0 }
+    , m_blob { nullptr }
+    , m_mapped { nullptr }
+    , m_mappedSize { 0 }
+{
+    amqp::internal::Stats::Timer timer (amqp::internal::Stats::read_t);
+
+    readStream (stream_);
+}
+
+/******************************************************************************/
+
+CordaBytes::CordaBytes (
+    amqp::amqp_section_id_t encoding_,
+    const char * bytes_,
+    size_t size_
+) : m_encoding { encoding_ }
+  , m_size { size_ }
+  , m_blob { bytes_ }
+  , m_mapped { nullptr }
+  , m_mappedSize { 0 }
+{
+}
+
+/******************************************************************************/
+
+CordaBytes::~CordaBytes() {
+    if (m_mapped) {
+        ::munmap (m_mapped, m_mappedSize);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Leaves [m_mapped] null if the mapping fails so the caller can fall back
+ * to copying the file
+ */
+void
+CordaBytes::map (int fd_, size_t size_) {
+    if (size_ < HEADER_SIZE) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
 
-    std::array<char, 7> header { };
-    file.read (header.data(), 7);
+    void * addr = ::mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
 
-    if (header != amqp::AMQP_HEADER) {
+    if (addr == MAP_FAILED) {
+        return;
+    }
+
+    // We only ever walk the blob front to back
+    ::posix_madvise (addr, size_, POSIX_MADV_SEQUENTIAL);
+
+    m_mapped = addr;
+    m_mappedSize = size_;
+
+    try {
+        readHeader (static_cast<const char *>(addr));
+    } catch (...) {
+        ::munmap (m_mapped, m_mappedSize);
+        m_mapped = nullptr;
+        throw;
+    }
+
+    m_blob = static_cast<const char *>(addr) + HEADER_SIZE;
+    m_size = size_ - HEADER_SIZE;
+}
+
+/******************************************************************************/
+
+void
+CordaBytes::readStream (std::istream & stream_) {
+    std::array<char, HEADER_SIZE> header { };
+
+    if (!stream_.read (header.data(), header.size())) {
         throw std::runtime_error ("Not a Corda stream");
     }
 
-    file.read (reinterpret_cast<char *>(&m_encoding), 1);
+    readHeader (header.data());
+
+    m_buffer.assign (
+            std::istreambuf_iterator<char> (stream_),
+            std::istreambuf_iterator<char>());
+
+    m_blob = m_buffer.data();
+    m_size = m_buffer.size();
+}
 
-    m_blob = new char[m_size];
+/******************************************************************************/
 
-    memset (m_blob, 0, m_size);
-    file.read (m_blob, m_size);
+void
+CordaBytes::readHeader (const char * header_) {
+    m_encoding = header (header_);
 }
 
 /******************************************************************************/
 
+amqp::amqp_section_id_t
+CordaBytes::header (const char * header_) {
+    if (!std::equal (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end(), header_)) {
+        throw std::runtime_error ("Not a Corda stream");
+    }
+
+    return static_cast<amqp::amqp_section_id_t>(
+            header_[amqp::AMQP_HEADER.size()]);
+}
+
+/******************************************************************************/
@@ -1,23 +1,63 @@
 #pragma once
 
-#include "string"
-#include <fstream>
+#include <string>
+#include <vector>
+#include <iosfwd>
 #include "amqp/AMQPSectionId.h"
 
 /******************************************************************************/
 
+/**
+ * The bytes of a Corda serialised blob with the 8 byte Corda header (the
+ * magic and the section id) stripped off.
+ *
+ * Where the source is a regular file it is mapped read only and [bytes]
+ * points directly into that mapping, no copy is made. Anything we can't
+ * map, pipes, stdin etc, is read into an owned buffer instead.
+ */
 class CordaBytes {
     private :
         amqp::amqp_section_id_t m_encoding;
         size_t m_size;
-        char * m_blob;
+        const char * m_blob;
+
+        /**
+         * Set when the file has been mapped, this is the entire file
+         * including the header
+         */
+        void * m_mapped;
+        size_t m_mappedSize;
+
+        /**
+         * Backing store for the copying fallback
+         */
+        std::vector<char> m_buffer;
+
+        void map (int, size_t);
+        void readStream (std::istream &);
+        void readHeader (const char *);
 
     public :
+        /**
+         * @param file_ path to the blob, "-" reads from stdin
+         */
         explicit CordaBytes (const std::string &);
 
-        ~CordaBytes() {
-            delete [] m_blob;
-        }
+        /**
+         * Always copies, for use with pipes and stdin
+         */
+        explicit CordaBytes (std::istream &);
+
+        /**
+         * A view of an envelope someone else owns, one of the sections of
+         * a [CordaStream] say, that must outlive us. Nothing is copied.
+         */
+        CordaBytes (amqp::amqp_section_id_t, const char *, size_t);
+
+        CordaBytes (const CordaBytes &) = delete;
+        CordaBytes & operator = (const CordaBytes &) = delete;
+
+        ~CordaBytes();
 
         const decltype (m_encoding) & encoding() const {
             return m_encoding;
@@ -25,7 +65,21 @@ class CordaBytes {
 
         decltype (m_size) size() const { return m_size; }
 
-        const char * const bytes() const { return m_blob; }
+        const char * bytes() const { return m_blob; }
+
+        bool mapped() const { return m_mapped != nullptr; }
+
+        /**
+         * Check [header_] is the Corda magic followed by a section id
+         *
+         * @return that section id
+         */
+        static amqp::amqp_section_id_t header (const char * header_);
+
+        /**
+         * The magic plus the section id
+         */
+        static constexpr size_t HEADER_SIZE = 8;
 };
 
 /******************************************************************************/
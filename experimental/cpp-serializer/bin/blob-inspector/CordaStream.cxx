@@ -0,0 +1,77 @@
+#include "CordaStream.h"
+
+#include <stdexcept>
+
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************/
+
+CordaStream::CordaStream (const std::string & file_)
+    : m_bytes (file_)
+    , m_at (m_bytes.bytes())
+{
+}
+
+/******************************************************************************/
+
+bool
+CordaStream::next (Section & section_) {
+    const char * end = m_bytes.bytes() + m_bytes.size();
+
+    if (m_at == end) {
+        return false;
+    }
+
+    auto encoding = m_bytes.encoding();
+    auto * at = m_at;
+
+    if (at != m_bytes.bytes()) {
+        if (static_cast<size_t>(end - at) < CordaBytes::HEADER_SIZE) {
+            throw std::runtime_error ("Truncated Corda header");
+        }
+
+        encoding = CordaBytes::header (at);
+        at += CordaBytes::HEADER_SIZE;
+    }
+
+    if (encoding == amqp::ENCODING) {
+        throw std::runtime_error ("Compressed sections can't be walked");
+    }
+
+    // throws if the envelope claims to run past the end of the file
+    auto envelope = amqp::internal::decoder::Decoder (
+            at, static_cast<size_t>(end - at)).encoded();
+
+    section_.encoding = encoding;
+    // every header's as long as the first, the one [m_bytes] skipped
+    section_.offset = static_cast<size_t>(at - m_bytes.bytes());
+    section_.bytes = envelope.data();
+    section_.size = envelope.size();
+
+    m_at = at + envelope.size();
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+CordaStream::rewind() {
+    m_at = m_bytes.bytes();
+}
+
+/******************************************************************************/
+
+std::vector<CordaStream::Section>
+CordaStream::sections() {
+    std::vector<Section> rtn;
+    Section section { };
+
+    for (rewind() ; next (section) ; ) {
+        rtn.push_back (section);
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
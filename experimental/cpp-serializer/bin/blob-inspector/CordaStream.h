@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "CordaBytes.h"
+
+/******************************************************************************/
+
+/**
+ * A file of Corda blobs one after another, each with its own header and
+ * section, as our exports write them.
+ *
+ * The file is read as [CordaBytes] reads any blob, mapped where it can be,
+ * and [next] walks it a section at a time handing back where each
+ * envelope is. Nothing is copied, and as the length of an envelope is
+ * in its encoding, finding where one ends costs the same whatever is in
+ * it.
+ *
+ * Compressed sections can't be walked, what they hold runs to the end of
+ * the file and needs inflating first, so meeting one is an error.
+ */
+class CordaStream {
+    public :
+        struct Section {
+            amqp::amqp_section_id_t encoding;
+
+            /**
+             * Of the section's header from the start of the file
+             */
+            size_t offset;
+
+            /**
+             * The envelope, good for as long as the stream is
+             */
+            const char * bytes;
+            size_t       size;
+        };
+
+    private :
+        CordaBytes m_bytes;
+
+        /**
+         * Where the next section's header starts, or for the first, whose
+         * header [m_bytes] has already read, its envelope
+         */
+        const char * m_at;
+
+    public :
+        /**
+         * @param file_ path to the file, "-" reads from stdin
+         */
+        explicit CordaStream (const std::string & file_);
+
+        /**
+         * Move onto the next section
+         *
+         * @return false, leaving [section_] alone, at the end of the file
+         */
+        bool next (Section & section_);
+
+        /**
+         * Back to the first section
+         */
+        void rewind();
+
+        /**
+         * Every section from the first, rewinding first
+         */
+        std::vector<Section> sections();
+};
+
+/******************************************************************************/
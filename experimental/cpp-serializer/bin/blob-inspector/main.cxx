@@ -2,17 +2,25 @@
 #include <iomanip>
 #include <fstream>
 #include <cstddef>
+#include <cstdlib>
+#include <vector>
+#include <memory>
+#include <optional>
 
 #include <assert.h>
 #include <string.h>
 #include <proton/types.h>
 #include <proton/codec.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <getopt.h>
 
 #include "debug.h"
 
 #include "proton/proton_wrapper.h"
 
+#include "amqp/Stats.h"
+#include "amqp/WorkPool.h"
 #include "amqp/AMQPHeader.h"
 #include "amqp/AMQPSectionId.h"
 #include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
@@ -20,32 +28,257 @@
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/CompositeFactory.h"
 #include "CordaBytes.h"
+#include "CordaStream.h"
 #include "BlobInspector.h"
+#include "BatchInspector.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    usage (const char * name_) {
+        std::cerr << "usage: " << name_
+            << " [-j threads] [-t threads] [-c | -p] [-b] [-s path] [-a blob]"
+            << " [--stats] [--classify] [--stream] [--shared] ..."
+            << " <blob | - | dir | @list | glob> ..."
+            << std::endl
+            << "    -j  inspect this many blobs at once" << std::endl
+            << "    -t  split large lists, arrays and maps across this many threads"
+            << std::endl
+            << "    -s  only decode this path, e.g. a.b[3].c or outputs[*].owner,"
+            << " may be repeated" << std::endl
+            << "    -a  read every blob as the types in this one are,"
+            << " for blobs written by other versions of a CorDapp"
+            << std::endl
+            << "    -c  compact JSON, one object per line" << std::endl
+            << "    -p  pretty printed JSON" << std::endl
+            << "    -b  binary values in JSON as base64 rather than hex"
+            << std::endl
+            << "    --stats  time spent at each stage and counts of what was"
+            << " read, on stderr" << std::endl
+            << "    --classify  only the payload's descriptor, the schema's"
+            << " fingerprint and the names of its types, reading neither"
+            << std::endl
+            << "    --stream  each file is many blobs one after another,"
+            << " inspect them all" << std::endl
+            << "    --shared  read each object a blob refers back to once"
+            << " rather than once per reference, text only" << std::endl;
+    }
+
+    /**
+     * A single blob named directly on the command line is written out as is,
+     * which is how we've always behaved
+     */
+    int
+    single (
+        const std::string & path_,
+        BlobInspector::Format format_,
+        const amqp::internal::reader::Projection * projection_,
+        const sPtr<const amqp::internal::SchemaCache::Entry> & as_,
+        amqp::internal::reader::JsonWriter::Binary binary_,
+        bool stats_,
+        bool classify_,
+        bool share_
+    ) {
+        amqp::internal::Stats stats;
+        std::optional<amqp::internal::Stats::Scope> scope;
+
+        if (stats_) {
+            scope.emplace (stats);
+        }
+
+        // "-" means read the blob from stdin
+        struct stat results { };
+
+        if (path_ != "-" && stat(path_.c_str(), &results) != 0) {
+            return EXIT_FAILURE;
+        }
+
+        CordaBytes cb (path_);
+
+        if (cb.encoding() != amqp::DATA_AND_STOP) {
+            std::cerr << "BAD ENCODING " << cb.encoding() << " != "
+                << amqp::DATA_AND_STOP << std::endl;
+
+            return EXIT_FAILURE;
+        }
+
+        BlobInspector blobInspector (cb, projection_, as_);
+
+        if (format_ == BlobInspector::text_t) {
+            std::cout << (classify_
+                ? blobInspector.classification()
+                : blobInspector.text (share_)) << std::endl;
+        } else {
+            // straight out to stdout, no need to hold the whole thing
+            amqp::internal::reader::JsonWriter writer (
+                format_ == BlobInspector::pretty_t
+                    ? amqp::internal::reader::JsonWriter::pretty_t
+                    : amqp::internal::reader::JsonWriter::compact_t,
+                STDOUT_FILENO,
+                binary_);
+
+            if (classify_) {
+                blobInspector.classify (writer);
+            } else {
+                blobInspector.json (writer);
+            }
+
+            writer.finish();
+        }
+
+        if (stats_) {
+            scope.reset();
+            std::cerr << path_ << " : " << stats.summary() << std::endl;
+        }
+
+        return EXIT_SUCCESS;
+    }
+
+}
 
 /******************************************************************************/
 
 int
 main (int argc, char **argv) {
-    struct stat results { };
+    size_t threads { 0 };
+    bool batch { false };
+    auto format { BlobInspector::text_t };
+    std::vector<std::string> selected;
+    std::string as;
+    auto binary { amqp::internal::reader::JsonWriter::hex_t };
+    bool stats { false };
+    bool classify { false };
+    bool stream { false };
+    bool share { false };
 
-    if (stat(argv[1], &results) != 0) {
+    enum { STATS = 256, CLASSIFY, STREAM, SHARED };
+
+    const struct option options[] = {
+        { "stats",    no_argument, nullptr, STATS },
+        { "classify", no_argument, nullptr, CLASSIFY },
+        { "stream",   no_argument, nullptr, STREAM },
+        { "shared",   no_argument, nullptr, SHARED },
+        { nullptr,    0,           nullptr, 0 }
+    };
+
+    int opt;
+    while ((opt = getopt_long (argc, argv, "j:t:cpbs:a:", options, nullptr)) != -1) {
+        switch (opt) {
+            case STATS :
+                stats = true;
+                break;
+            case CLASSIFY :
+                classify = true;
+                break;
+            case STREAM :
+                stream = true;
+                break;
+            case SHARED :
+                share = true;
+                break;
+            case 'j' :
+                threads = std::strtoul (optarg, nullptr, 10);
+                batch = true;
+                break;
+            case 't' :
+                amqp::internal::WorkPool::configure (
+                        std::strtoul (optarg, nullptr, 10));
+                break;
+            case 'c' :
+                format = BlobInspector::json_t;
+                break;
+            case 'p' :
+                format = BlobInspector::pretty_t;
+                break;
+            case 'b' :
+                binary = amqp::internal::reader::JsonWriter::base64_t;
+                break;
+            case 's' :
+                selected.emplace_back (optarg);
+                break;
+            case 'a' :
+                as = optarg;
+                break;
+            default :
+                usage (argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (optind >= argc || (share && format != BlobInspector::text_t)) {
+        usage (argv[0]);
         return EXIT_FAILURE;
     }
 
-    CordaBytes cb (argv[1]);
-    
-    if (cb.encoding() == amqp::DATA_AND_STOP) {
-        BlobInspector blobInspector (cb);
-        auto val = blobInspector.dump();
-        std::cout << val << std::endl;
+    std::unique_ptr<amqp::internal::reader::Projection> projection;
+
+    if (!selected.empty()) {
+        try {
+            projection = std::make_unique<amqp::internal::reader::Projection> (
+                    std::move (selected));
+        } catch (const std::exception & e) {
+            std::cerr << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    sPtr<const amqp::internal::SchemaCache::Entry> schema;
+
+    if (!as.empty()) {
+        try {
+            CordaBytes cb (as);
+            schema = BlobInspector::schema (cb);
+        } catch (const std::exception & e) {
+            std::cerr << as << " : " << e.what() << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<std::string> args (argv + optind, argv + argc);
+
+    auto paths = BatchInspector::expand (args);
+
+    if (!batch && !stream
+        && args.size() == 1 && paths.size() == 1 && paths[0] == args[0]
+    ) {
+        return single (
+                args[0], format, projection.get(), schema, binary,
+                stats, classify, share);
+    }
+
+    amqp::internal::Stats total;
+
+    BatchInspector inspector (
+            threads, format, projection.get(), schema, binary, classify,
+            share);
+
+    size_t failed { 0 };
+
+    if (stream) {
+        for (const auto & path : paths) {
+            try {
+                CordaStream cs (path);
+
+                failed += inspector.run (
+                        path, cs, std::cout, std::cerr,
+                        stats ? &total : nullptr);
+            } catch (const std::exception & e) {
+                ++failed;
+                std::cerr << path << " : " << e.what() << std::endl;
+            }
+        }
     } else {
-        std::cerr << "BAD ENCODING " << cb.encoding() << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+        failed = inspector.run (
+                paths, std::cout, std::cerr, stats ? &total : nullptr);
+    }
 
-        return EXIT_FAILURE;
+    if (stats) {
+        std::cerr << "total : " << total.summary() << std::endl;
     }
 
-    return EXIT_SUCCESS;
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
 }
 
 /******************************************************************************/
@@ -1,6 +1,23 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <iterator>
+#include <proton/codec.h>
+#include <unistd.h>
 #include "CordaBytes.h"
+#include "CordaStream.h"
 #include "BlobInspector.h"
+#include "BatchInspector.h"
+#include "Generator.h"
+#include "amqp/Stats.h"
+#include "amqp/WorkPool.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/DecodeContext.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/reader/visitors/TreeVisitor.h"
 
 const std::string filepath ("../../test-files/"); // NOLINT
 
@@ -82,12 +99,22 @@ TEST (BlobInspector, _Le_) { // NOLINT
 
 /******************************************************************************/
 
+/**
+ * The second A and B are written as references back to the first
+ */
 TEST (BlobInspector,_Le_2) { // NOLINT
-    EXPECT_THROW (
-        {
-            test ("_Le_2", "");
-        },
-        std::runtime_error);
+    test ("_Le_2", "{ Parsed : { listy : [ A, B, C, B, A ] } }");
+}
+
+/******************************************************************************/
+
+/**
+ * The second "x" is written as a reference back to the first. As elements
+ * of a list strings are numbered so the enum the second A refers back to
+ * is object 3, not 1.
+ */
+TEST (BlobInspector, _LsLe_) { // NOLINT
+    test ("_LsLe_", R"({ Parsed : { s : [ "x", "y", "x" ], e : [ A, A ] } })");
 }
 
 /******************************************************************************/
@@ -150,6 +177,14 @@ TEST (BlobInspector, _Ci_) { // NOLINT
 
 /******************************************************************************/
 
+// Arrays of each unboxed type, full width values among the small ones
+TEST (BlobInspector, _Cild_) { // NOLINT
+    test ("_Cild_",
+        "{ Parsed : { a : [ 1, -70000, 3 ], b : [ 4, 5000000000 ], c : [ 1.5, -2.25 ] } }");
+}
+
+/******************************************************************************/
+
 /**
  * Composite with
  *   * one int property
@@ -165,7 +200,1152 @@ TEST (BlobInspector, __i_LMis_l__) { // NOLINT
 
 TEST (BlobInspector, _ALd_) { // NOLINT
     test ("_ALd_",
-            R"({ Parsed : { a : [ [ 10.100000, 11.200000, 12.300000 ], [  ], [ 13.400000 ] ] } })");
+            R"({ Parsed : { a : [ [ 10.1, 11.2, 12.3 ], [  ], [ 13.4 ] ] } })");
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * CordaBytes Tests
+ *
+ ******************************************************************************/
+
+/**
+ * The mapped and copied paths should see exactly the same bytes
+ */
+TEST (CordaBytes, mappedMatchesStream) { // NOLINT
+    auto path { filepath + "__i_LMis_l__" };
+
+    CordaBytes mapped (path);
+
+    std::ifstream file { path, std::ios::in | std::ios::binary };
+    CordaBytes copied (file);
+
+    ASSERT_TRUE (mapped.mapped());
+    ASSERT_FALSE (copied.mapped());
+    ASSERT_EQ (mapped.encoding(), copied.encoding());
+    ASSERT_EQ (mapped.size(), copied.size());
+    ASSERT_EQ (
+        std::string (mapped.bytes(), mapped.size()),
+        std::string (copied.bytes(), copied.size()));
+
+    ASSERT_EQ (
+        BlobInspector (mapped).dump(),
+        BlobInspector (copied).dump());
+}
+
+/******************************************************************************/
+
+/**
+ * A second blob with the same schema shouldn't cause it to be rebuilt
+ */
+TEST (SchemaCache, reused) { // NOLINT
+    auto & cache = amqp::internal::SchemaCache::instance();
+    cache.clear();
+
+    test ("_i_", "{ Parsed : { a : 69 } }");
+    test ("_i_", "{ Parsed : { a : 69 } }");
+
+    ASSERT_EQ (1UL, cache.size());
+    ASSERT_EQ (1UL, cache.misses());
+    ASSERT_EQ (1UL, cache.hits());
+
+    test ("_l_", "{ Parsed : { x : 100000000000 } }");
+
+    ASSERT_EQ (2UL, cache.size());
+    ASSERT_EQ (2UL, cache.misses());
+}
+
+/******************************************************************************/
+
+/**
+ * Reading every blob through one context gives what reading each with its
+ * own does, and a second time round nothing needs to grow
+ */
+TEST (DecodeContext, reused) { // NOLINT
+    amqp::internal::DecodeContext context;
+
+    size_t capacity { 0 };
+
+    for (int pass { 0 } ; pass < 2 ; ++pass) {
+        for (const auto & path : BatchInspector::expand (filepath)) {
+            CordaBytes cb (path);
+
+            std::string expected;
+
+            try {
+                expected = BlobInspector (cb).dump();
+            } catch (const std::runtime_error &) {
+                continue;
+            }
+
+            ASSERT_EQ (expected, BlobInspector (context, cb).text()) << path;
+        }
+
+        if (pass == 0) {
+            capacity = context.str().capacity();
+        }
+    }
+
+    ASSERT_EQ (capacity, context.str().capacity());
+
+    CordaBytes cb (filepath + "_i_");
+
+    auto & writer = context.json (amqp::internal::reader::JsonWriter::compact_t);
+    BlobInspector (context, cb).json (writer);
+    ASSERT_EQ (R"({"Parsed":{"a":69}})", writer.str());
+
+    BlobInspector (context, cb).json (writer);
+    ASSERT_EQ (&writer, &context.json (amqp::internal::reader::JsonWriter::compact_t));
+    ASSERT_EQ (R"({"Parsed":{"a":69}})", writer.str());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * BatchInspector Tests
+ *
+ ******************************************************************************/
+
+/**
+ * Results come out in the order they went in whatever order the workers
+ * finish them in, and one bad blob doesn't take the rest down with it
+ */
+TEST (BatchInspector, ordered) { // NOLINT
+    auto paths = BatchInspector::expand (filepath);
+
+    ASSERT_EQ (19UL, paths.size());
+    ASSERT_TRUE (std::is_sorted (paths.begin(), paths.end()));
+
+    auto bad = paths.insert (paths.begin() + 5, filepath + "../CMakeLists.txt");
+
+    std::stringstream out, err;
+
+    auto failed = BatchInspector (4).run (paths, out, err);
+
+    ASSERT_EQ (1UL, failed);
+    ASSERT_EQ (*bad + " : Not a Corda stream\n", err.str());
+
+    std::string line;
+    auto path = paths.begin();
+
+    while (std::getline (out, line)) {
+        if (path == bad) {
+            ++path;
+        }
+
+        ASSERT_EQ (0UL, line.find (*path + " : { Parsed : "));
+        ++path;
+    }
+
+    ASSERT_EQ (paths.end(), path);
+}
+
+/******************************************************************************/
+
+TEST (BatchInspector, glob) { // NOLINT
+    auto paths = BatchInspector::expand (filepath + "_M*");
+
+    ASSERT_EQ (
+        (std::vector<std::string> {
+            filepath + "_MiLs_", filepath + "_Mi_is__", filepath + "_Mis_" }),
+        paths);
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Visitor Tests
+ *
+ ******************************************************************************/
+
+/**
+ * Building the tree and streaming straight out have to agree
+ */
+TEST (BlobInspector, treeMatchesStream) { // NOLINT
+    for (const auto & path : BatchInspector::expand (filepath)) {
+        CordaBytes cb (path);
+
+        amqp::internal::reader::TreeVisitor visitor;
+        visitor.key ("{ Parsed");
+        BlobInspector (cb).visit (visitor);
+
+        ASSERT_EQ (
+            BlobInspector (cb).dump(),
+            visitor.result()->dump() + " }") << path;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Sharing referenced objects changes what the tree is made of, not what
+ * it says
+ */
+TEST (BlobInspector, sharedTree) { // NOLINT
+    for (const auto & path : BatchInspector::expand (filepath)) {
+        CordaBytes cb (path);
+
+        amqp::internal::reader::TreeVisitor copied, shared (true);
+        BlobInspector (cb).visit (copied);
+        BlobInspector (cb).visit (shared);
+
+        ASSERT_EQ (copied.result()->dump(), shared.result()->dump()) << path;
+        ASSERT_EQ (BlobInspector (cb).text(), BlobInspector (cb).text (true)) << path;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Splitting every container, however small, across threads mustn't change
+ * a thing, including where one refers back to an object in an earlier part
+ * of the same container, _Le_2, which can't be split
+ */
+TEST (BlobInspector, parallelMatchesSerial) { // NOLINT
+    std::vector<std::pair<std::string, std::string>> expected;
+
+    for (const auto & path : BatchInspector::expand (filepath)) {
+        CordaBytes cb (path);
+
+        amqp::internal::reader::TreeVisitor shared (true);
+        BlobInspector (cb).visit (shared);
+
+        expected.emplace_back (BlobInspector (cb).dump(), shared.result()->dump());
+    }
+
+    amqp::internal::WorkPool::configure (4, 1);
+
+    size_t i { 0 };
+    for (const auto & path : BatchInspector::expand (filepath)) {
+        CordaBytes cb (path);
+
+        amqp::internal::reader::TreeVisitor shared (true);
+        BlobInspector (cb).visit (shared);
+
+        EXPECT_EQ (expected[i].first, BlobInspector (cb).dump()) << path;
+        EXPECT_EQ (expected[i].second, shared.result()->dump()) << path;
+        ++i;
+    }
+
+    amqp::internal::WorkPool::configure (0);
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * JSON Tests
+ *
+ ******************************************************************************/
+
+TEST (BlobInspector, json) { // NOLINT
+    CordaBytes cb (filepath + "__i_LMis_l__");
+
+    amqp::internal::reader::JsonWriter writer;
+    BlobInspector (cb).json (writer);
+
+    ASSERT_EQ (
+        R"({"Parsed":{"x":[{"1":"two","3":"four","5":"six"},{"7":"eight","9":"ten"}],"y":{"x":1000000},"z":{"a":666}}})",
+        writer.str());
+}
+
+/******************************************************************************/
+
+TEST (BatchInspector, json) { // NOLINT
+    std::stringstream out, err;
+
+    BatchInspector (2, BlobInspector::json_t).run (
+        { filepath + "_i_", filepath + "_ALd_" }, out, err);
+
+    ASSERT_EQ (
+        "{\"file\":\"" + filepath + R"(_i_","Parsed":{"a":69}})" "\n"
+        "{\"file\":\"" + filepath + R"(_ALd_","Parsed":{"a":[[10.1,11.2,12.3],[],[13.4]]}})" "\n",
+        out.str());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Projection Tests
+ *
+ ******************************************************************************/
+
+void
+project (
+    const std::string & file_,
+    std::vector<std::string> paths_,
+    const std::string & result_
+) {
+    amqp::internal::reader::Projection projection (std::move (paths_));
+
+    CordaBytes cb (filepath + file_);
+    ASSERT_EQ (result_, BlobInspector (cb, &projection).dump());
+}
+
+/******************************************************************************/
+
+TEST (Projection, fields) { // NOLINT
+    project ("__i_LMis_l__", { "y" }, "{ Parsed : { y : { x : 1000000 } } }");
+    project ("__i_LMis_l__", { "z.a", "y.x" },
+        "{ Parsed : { y : { x : 1000000 }, z : { a : 666 } } }");
+    project ("_i_is__", { "b.b" }, R"({ Parsed : { b : { b : "three" } } })");
+}
+
+/******************************************************************************/
+
+TEST (Projection, elements) { // NOLINT
+    project ("_ALd_", { "a[2]" }, "{ Parsed : { a : [ [ 13.4 ] ] } }");
+    project ("_ALd_", { "a[0][1]", "a[*][0]" },
+        "{ Parsed : { a : [ [ 10.1, 11.2 ], [  ], [ 13.4 ] ] } }");
+    project ("_L_i__", { "listy[*].a" },
+        "{ Parsed : { listy : [ { a : 1 }, { a : 2 }, { a : 3 } ] } }");
+    project ("__i_LMis_l__", { "x[1]" },
+        R"({ Parsed : { x : [ { 7 : "eight", 9 : "ten" } ] } })");
+    project ("_Mi_is__", { "a[*].b" },
+        R"({ Parsed : { a : { 1 : { b : "three" }, 4 : { b : "six" }, 7 : { b : "nine" } } } })");
+    project ("_Cild_", { "a[1]", "c" },
+        "{ Parsed : { a : [ -70000 ], c : [ 1.5, -2.25 ] } }");
+    project ("_Cild_", { "b[*]" }, "{ Parsed : { b : [ 4, 5000000000 ] } }");
+}
+
+/******************************************************************************/
+
+/**
+ * Skipped values still have to be numbered for later references to them
+ * to be followed
+ */
+TEST (Projection, references) { // NOLINT
+    project ("_Le_2", { "listy[3]" }, "{ Parsed : { listy : [ B ] } }");
+    project ("_Le_2", { "listy[4]" }, "{ Parsed : { listy : [ A ] } }");
+}
+
+/******************************************************************************/
+
+TEST (Projection, errors) { // NOLINT
+    using amqp::internal::reader::Projection;
+
+    EXPECT_THROW (Projection ({ "a..b" }), std::runtime_error);
+    EXPECT_THROW (Projection ({ "a[" }), std::runtime_error);
+    EXPECT_THROW (Projection ({ "a[x]" }), std::runtime_error);
+    EXPECT_THROW (Projection ({ "a[1]b" }), std::runtime_error);
+    EXPECT_THROW (Projection ({ "a." }), std::runtime_error);
+
+    Projection projection ({ "a.nope" });
+
+    CordaBytes cb (filepath + "_i_is__");
+    EXPECT_THROW (BlobInspector (cb, &projection).dump(), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Evolution Tests
+ *
+ * We've no blobs written by two versions of the same class to hand so these
+ * build their own, a schema that's v1 of a class and its enum and another
+ * that's v2 of them
+ *
+ ******************************************************************************/
+
+namespace {
+
+    using Fields = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * Puts a described list, or map, on construction and steps back out of
+     * it when done with
+     */
+    class Described {
+        private :
+            pn_data_t * m_data;
+
+        public :
+            Described (pn_data_t * data_, int id_, bool map_ = false)
+                : m_data (data_)
+            {
+                pn_data_put_described (m_data);
+                pn_data_enter (m_data);
+                pn_data_put_ulong (m_data,
+                    amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS | id_);
+
+                if (map_) {
+                    pn_data_put_map (m_data);
+                } else {
+                    pn_data_put_list (m_data);
+                }
+
+                pn_data_enter (m_data);
+            }
+
+            Described (pn_data_t * data_, const std::string & symbol_)
+                : m_data (data_)
+            {
+                pn_data_put_described (m_data);
+                pn_data_enter (m_data);
+                pn_data_put_symbol (m_data, pn_bytes (symbol_.size(), symbol_.data()));
+                pn_data_put_list (m_data);
+                pn_data_enter (m_data);
+            }
+
+            ~Described() {
+                pn_data_exit (m_data);
+                pn_data_exit (m_data);
+            }
+    };
+
+    void
+    putString (pn_data_t * data_, const std::string & value_) {
+        pn_data_put_string (data_, pn_bytes (value_.size(), value_.data()));
+    }
+
+    void
+    putEmptyList (pn_data_t * data_) {
+        pn_data_put_list (data_);
+    }
+
+    void
+    putDescriptor (pn_data_t * data_, const std::string & descriptor_) {
+        using namespace amqp::schema::descriptors;
+
+        Described d (data_, OBJECT);
+        pn_data_put_symbol (data_, pn_bytes (descriptor_.size(), descriptor_.data()));
+        pn_data_put_null (data_);
+    }
+
+    void
+    putComposite (
+        pn_data_t * data_,
+        const std::string & name_,
+        const std::string & descriptor_,
+        const Fields & fields_
+    ) {
+        using namespace amqp::schema::descriptors;
+
+        Described d (data_, COMPOSITE_TYPE);
+        putString (data_, name_);
+        pn_data_put_null (data_);
+        putEmptyList (data_);
+        putDescriptor (data_, descriptor_);
+
+        pn_data_put_list (data_);
+        pn_data_enter (data_);
+
+        for (const auto & field : fields_) {
+            Described f (data_, FIELD);
+            putString (data_, field.first);
+            putString (data_, field.second);
+            putEmptyList (data_);
+            pn_data_put_null (data_);
+            pn_data_put_null (data_);
+            pn_data_put_bool (data_, true);
+            pn_data_put_bool (data_, false);
+        }
+
+        pn_data_exit (data_);
+    }
+
+    void
+    putEnum (
+        pn_data_t * data_,
+        const std::string & name_,
+        const std::string & descriptor_,
+        const std::vector<std::string> & choices_
+    ) {
+        using namespace amqp::schema::descriptors;
+
+        Described d (data_, RESTRICTED_TYPE);
+        putString (data_, name_);
+        pn_data_put_null (data_);
+        putEmptyList (data_);
+        putString (data_, "list");
+        putDescriptor (data_, descriptor_);
+
+        pn_data_put_list (data_);
+        pn_data_enter (data_);
+
+        for (size_t i { 0 } ; i < choices_.size() ; ++i) {
+            Described c (data_, CHOICE);
+            putString (data_, choices_[i]);
+            putString (data_, std::to_string (i));
+        }
+
+        pn_data_exit (data_);
+    }
+
+    /**
+     * The transforms of the enum, each a triple of the name of the
+     * transform and its arguments
+     */
+    void
+    putTransforms (
+        pn_data_t * data_,
+        const std::string & enum_,
+        const std::vector<std::array<std::string, 3>> & transforms_
+    ) {
+        using namespace amqp::schema::descriptors;
+
+        Described d (data_, TRANSFORM_SCHEMA, true);
+
+        if (transforms_.empty()) {
+            return;
+        }
+
+        putString (data_, enum_);
+        pn_data_put_map (data_);
+        pn_data_enter (data_);
+
+        for (const auto & transform : transforms_) {
+            {
+                Described key (data_, TRANSFORM_ELEMENT_KEY);
+            }
+
+            pn_data_put_list (data_);
+            pn_data_enter (data_);
+
+            {
+                Described element (data_, TRANSFORM_ELEMENT);
+
+                for (const auto & value : transform) {
+                    putString (data_, value);
+                }
+            }
+
+            pn_data_exit (data_);
+        }
+
+        pn_data_exit (data_);
+    }
+
+    const std::string evolvedType { "net.corda.test.Evolved" };
+    const std::string enumType { "net.corda.test.E" };
+
+    /**
+     * v1 is { a : int, b : string, c : long, e : E } with E { A, B, Cee, D }
+     * and v2 { c : long, a : int, d : string, e : E } with E { A, B, C },
+     * v2 having renamed Cee and v1 saying D should be read as B by anything
+     * that doesn't know it
+     */
+    std::string
+    blob (int version_, const std::string & constant_) {
+        using namespace amqp::schema::descriptors;
+
+        std::unique_ptr<pn_data_t, decltype(&pn_data_free)> data {
+            pn_data (0), pn_data_free
+        };
+
+        auto * d = data.get();
+
+        const std::string descriptor { "net.corda:evolved" + std::to_string (version_) };
+        const std::string enumDescriptor { "net.corda:e" + std::to_string (version_) };
+
+        {
+            Described envelope (d, ENVELOPE);
+
+            {
+                Described payload (d, descriptor);
+
+                if (version_ == 1) {
+                    pn_data_put_int (d, 1);
+                    putString (d, "gone");
+                    pn_data_put_long (d, 3);
+                } else {
+                    pn_data_put_long (d, 3);
+                    pn_data_put_int (d, 1);
+                    putString (d, "new");
+                }
+
+                Described e (d, enumDescriptor);
+                putString (d, constant_);
+                pn_data_put_int (d, 0);
+            }
+
+            {
+                Described schema (d, SCHEMA);
+
+                pn_data_put_list (d);
+                pn_data_enter (d);
+
+                if (version_ == 1) {
+                    putEnum (d, enumType, enumDescriptor, { "A", "B", "Cee", "D" });
+                    putComposite (d, evolvedType, descriptor, {
+                        { "a", "int" }, { "b", "string" },
+                        { "c", "long" }, { "e", enumType } });
+                } else {
+                    putEnum (d, enumType, enumDescriptor, { "A", "B", "C" });
+                    putComposite (d, evolvedType, descriptor, {
+                        { "c", "long" }, { "a", "int" },
+                        { "d", "string" }, { "e", enumType } });
+                }
+
+                pn_data_exit (d);
+            }
+
+            if (version_ == 1) {
+                putTransforms (d, enumType, { { "EnumDefault", "B", "D" } });
+            } else {
+                putTransforms (d, enumType, { { "Rename", "Cee", "C" } });
+            }
+        }
+
+        std::string encoded (pn_data_encoded_size (d), '\0');
+        pn_data_encode (d, &encoded[0], encoded.size());
+
+        return std::string (amqp::AMQP_HEADER.begin(), amqp::AMQP_HEADER.end())
+            + static_cast<char>(amqp::DATA_AND_STOP)
+            + encoded;
+    }
+
+    std::string
+    readAs (const std::string & blob_, const std::string & as_) {
+        std::istringstream as (as_);
+        CordaBytes asBytes (as);
+
+        std::istringstream blob (blob_);
+        CordaBytes cb (blob);
+
+        return BlobInspector (cb, nullptr, BlobInspector::schema (asBytes)).dump();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Evolution, asWritten) { // NOLINT
+    std::istringstream blob (::blob (1, "Cee"));
+    CordaBytes cb (blob);
+
+    ASSERT_EQ (
+        R"({ Parsed : { a : 1, b : "gone", c : 3, e : Cee } })",
+        BlobInspector (cb).dump());
+
+    // reading as itself changes nothing
+    ASSERT_EQ (
+        R"({ Parsed : { a : 1, b : "gone", c : 3, e : Cee } })",
+        readAs (::blob (1, "Cee"), ::blob (1, "A")));
+}
+
+/******************************************************************************/
+
+/**
+ * Fields are reordered, dropped and defaulted, and enum constants renamed
+ * or defaulted
+ */
+TEST (Evolution, older) { // NOLINT
+    auto v2 = blob (2, "A");
+
+    ASSERT_EQ ("{ Parsed : { c : 3, a : 1, d : null, e : C } }",
+        readAs (blob (1, "Cee"), v2));
+    ASSERT_EQ ("{ Parsed : { c : 3, a : 1, d : null, e : B } }",
+        readAs (blob (1, "D"), v2));
+    ASSERT_EQ ("{ Parsed : { c : 3, a : 1, d : null, e : A } }",
+        readAs (blob (1, "A"), v2));
+}
+
+/******************************************************************************/
+
+TEST (Evolution, newer) { // NOLINT
+    auto v1 = blob (1, "A");
+
+    ASSERT_EQ (R"({ Parsed : { a : 1, b : null, c : 3, e : Cee } })",
+        readAs (blob (2, "C"), v1));
+}
+
+/******************************************************************************/
+
+/**
+ * The plan for a pair of schemas is only ever built once
+ */
+TEST (Evolution, cached) { // NOLINT
+    std::istringstream v1 (blob (1, "A"));
+    CordaBytes v1Bytes (v1);
+    auto writer = BlobInspector::schema (v1Bytes);
+
+    std::istringstream v2 (blob (2, "A"));
+    CordaBytes v2Bytes (v2);
+    auto reader = BlobInspector::schema (v2Bytes);
+
+    auto before = writer->evolutions();
+
+    readAs (blob (1, "Cee"), blob (2, "A"));
+    readAs (blob (1, "D"), blob (2, "B"));
+
+    ASSERT_EQ (before + (before ? 0 : 1), writer->evolutions());
+    ASSERT_EQ (
+        writer->byDescriptor ("net.corda:evolved1", reader),
+        writer->byDescriptor ("net.corda:evolved1", reader));
+    ASSERT_NE (
+        writer->byDescriptor ("net.corda:evolved1"),
+        writer->byDescriptor ("net.corda:evolved1", reader));
+}
+
+/******************************************************************************/
+
+/**
+ * Reading each of two schemas as the other mustn't leave either owning
+ * the other, once the cache lets them go they go
+ */
+TEST (Evolution, bothWays) { // NOLINT
+    std::weak_ptr<const amqp::internal::SchemaCache::Entry> v1Entry, v2Entry;
+
+    {
+        std::istringstream v1 (blob (1, "A"));
+        CordaBytes v1Bytes (v1);
+        auto writer = BlobInspector::schema (v1Bytes);
+
+        std::istringstream v2 (blob (2, "A"));
+        CordaBytes v2Bytes (v2);
+        auto reader = BlobInspector::schema (v2Bytes);
+
+        readAs (blob (1, "A"), blob (2, "A"));
+        readAs (blob (2, "A"), blob (1, "A"));
+
+        ASSERT_EQ (1UL, writer->evolutions());
+        ASSERT_EQ (1UL, reader->evolutions());
+
+        v1Entry = writer;
+        v2Entry = reader;
+    }
+
+    amqp::internal::SchemaCache::instance().clear();
+
+    ASSERT_TRUE (v1Entry.expired());
+    ASSERT_TRUE (v2Entry.expired());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Generator Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    std::string
+    generated (const Generator::Shape & shape_) {
+        std::istringstream blob (Generator (shape_).blob());
+        CordaBytes cb (blob);
+
+        return BlobInspector (cb).dump();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Generator, shape) { // NOLINT
+    Generator::Shape shape;
+
+    shape.depth = 2;
+    shape.types = 1;
+    shape.fields = 1;
+    shape.list = 2;
+    shape.map = 1;
+    shape.count = 2;
+    shape.primitives = { "int" };
+
+    auto dump = generated (shape);
+
+    // Root's one list of two objects, each with the one below
+    ASSERT_EQ (0U, dump.find ("{ Parsed : { r0 : [ { f0 : "));
+    ASSERT_EQ (2, std::count (dump.begin(), dump.end(), 'c'));
+    ASSERT_EQ (4, std::count (dump.begin(), dump.end(), 'm'));
+    ASSERT_EQ (std::string::npos, dump.find ("r1"));
+}
+
+/******************************************************************************/
+
+/**
+ * Every primitive we can make reads back
+ */
+TEST (Generator, primitives) { // NOLINT
+    Generator::Shape shape;
+
+    shape.primitives = Generator::primitives();
+    shape.fields = shape.primitives.size() * 2;
+    shape.depth = 3;
+
+    for (shape.seed = 1 ; shape.seed < 8 ; ++shape.seed) {
+        ASSERT_NO_THROW (generated (shape)) << shape.seed;
+    }
+
+    shape.primitives = { "decimal32" };
+    ASSERT_THROW (Generator { shape }, std::runtime_error);
+}
+
+/******************************************************************************/
+
+TEST (Generator, reproducible) { // NOLINT
+    Generator::Shape shape;
+
+    Generator generator (shape);
+    auto blob = generator.blob();
+
+    ASSERT_EQ (blob, generator.blob());
+    ASSERT_EQ (blob, Generator (shape).blob());
+
+    shape.seed = 2;
+    ASSERT_NE (blob, Generator (shape).blob());
+}
+
+/******************************************************************************/
+
+TEST (Generator, bytes) { // NOLINT
+    Generator::Shape shape;
+
+    shape.bytes = 1 << 20;
+
+    auto blob = Generator (shape).blob();
+
+    // over by no more than the last object of each list and the schema
+    ASSERT_GE (blob.size(), shape.bytes);
+    ASSERT_LT (blob.size(), shape.bytes + 16384);
+
+    std::istringstream in (blob);
+    CordaBytes cb (in);
+    ASSERT_NO_THROW (BlobInspector (cb).dump());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Stats Tests
+ *
+ ******************************************************************************/
+
+TEST (Stats, populated) { // NOLINT
+    Generator::Shape shape;
+
+    shape.depth = 1;
+    shape.types = 1;
+    shape.fields = 2;
+    shape.list = 0;
+    shape.map = 0;
+    shape.count = 3;
+    shape.primitives = { "int" };
+
+    auto blob = Generator (shape).blob();
+
+    amqp::internal::Stats stats;
+    size_t size { 0 };
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        amqp::internal::Stats::Scope scope (stats);
+
+        std::istringstream in (blob);
+        CordaBytes cb (in);
+        BlobInspector (cb).dump();
+
+        size = cb.size();
+    }
+
+    EXPECT_EQ (2U, stats.blobs);
+    EXPECT_EQ (2 * size, stats.bytes);
+    // Root, the one composite and Root's list of them
+    EXPECT_EQ (2U * 3, stats.types);
+    EXPECT_EQ (2U * 3 * 2, stats.values);
+
+    // Root, its list and the three objects in it
+    EXPECT_EQ (stats.values + 2U * 5, stats.nodes);
+
+    // whether the first was a miss depends on what's been read before us
+    EXPECT_EQ (2U, stats.hits + stats.misses);
+    EXPECT_LE (1U, stats.hits);
+
+    EXPECT_LT (0, stats.time[amqp::internal::Stats::render_t].count());
+    EXPECT_LT (0, stats.time[amqp::internal::Stats::read_t].count());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * Classify Tests
+ *
+ ******************************************************************************/
+
+/**
+ * What's peeked at agrees with what reading the whole blob finds
+ */
+TEST (Classify, matchesSchema) { // NOLINT
+    for (const auto & file : { "_i_", "_Mis_", "_ALd_", "_L_i__" }) {
+        CordaBytes cb (filepath + file);
+
+        amqp::internal::DecodeContext context;
+        BlobInspector inspector (context, cb);
+
+        auto classification = context.classifier().classify (context.data());
+
+        auto schema = BlobInspector::schema (cb);
+
+        ASSERT_EQ (
+            amqp::internal::SchemaCache::fingerprint (
+                schema->bytes(), schema->transformBytes()),
+            classification.fingerprint) << file;
+
+        std::vector<std::string> types;
+
+        // the schema's types are kept grouped by what they depend on
+        for (const auto & group : schema->schema().types()) {
+            for (const auto & type : group) {
+                types.emplace_back (type->name());
+            }
+        }
+
+        ASSERT_EQ (types.size(), classification.types.size()) << file;
+
+        // names are as they were written where the schema unboxes those
+        // of restricted types, java.lang.Double becoming double, but a
+        // composite's is left alone
+        ASSERT_NE (
+            types.end(),
+            std::find (
+                types.begin(), types.end(),
+                classification.types.front())) << file;
+
+        ASSERT_EQ (0U, classification.descriptor.find ("net.corda:")) << file;
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Fingerprints are kept and compared across runs and builds so mustn't
+ * ever change for the same bytes
+ */
+TEST (Classify, fingerprintPinned) { // NOLINT
+    using amqp::internal::SchemaCache;
+
+    // which bytes were in which section counts
+    ASSERT_NE (SchemaCache::fingerprint ("foobar"), SchemaCache::fingerprint ("foo", "bar"));
+
+    CordaBytes cb (filepath + "_i_");
+    amqp::internal::DecodeContext context;
+    BlobInspector inspector (context, cb);
+
+    ASSERT_EQ (
+        0x9d99dd07ffb7b2aeULL,
+        context.classifier().classify (context.data()).fingerprint);
+}
+
+/******************************************************************************/
+
+TEST (Classify, text) { // NOLINT
+    CordaBytes cb (filepath + "_Mis_");
+
+    auto text = BlobInspector (cb).classification();
+
+    ASSERT_EQ (0U, text.find ("{ descriptor : \"net.corda:")) << text;
+    ASSERT_NE (std::string::npos, text.find (
+        "types : [ \"net.corda.blobwriter._Mis_\", "
+        "\"java.util.Map<int, string>\" ] }")) << text;
+}
+
+/******************************************************************************/
+
+/**
+ * However big the payload the generator's types are all there is
+ */
+TEST (Classify, generated) { // NOLINT
+    Generator::Shape shape;
+
+    shape.depth = 2;
+    shape.types = 3;
+    shape.bytes = 1 << 20;
+
+    std::istringstream in (Generator (shape).blob());
+    CordaBytes cb (in);
+
+    amqp::internal::DecodeContext context;
+    BlobInspector inspector (context, cb);
+
+    const auto & classification = context.classifier().classify (
+            context.data());
+
+    ASSERT_EQ ("net.corda:net.corda.generated.Root", classification.descriptor);
+    ASSERT_EQ ("net.corda.generated.Root", classification.types.front());
+    ASSERT_EQ (1U, std::count (
+            classification.types.begin(),
+            classification.types.end(),
+            "net.corda.generated.C1_2"));
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * CordaStream Tests
+ *
+ ******************************************************************************/
+
+namespace {
+
+    std::string
+    slurp (const std::string & path_) {
+        std::ifstream file (path_, std::ios::binary);
+
+        return { std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char>() };
+    }
+
+    /**
+     * Somewhere to write a stream for as long as we're in scope
+     */
+    class TempFile {
+        private :
+            std::string m_path;
+
+        public :
+            explicit TempFile (const std::string & contents_) {
+                char path[] = "/tmp/corda-streamXXXXXX";
+                int fd = ::mkstemp (path);
+                ::close (fd);
+
+                m_path = path;
+                std::ofstream (m_path, std::ios::binary) << contents_;
+            }
+
+            ~TempFile() { ::unlink (m_path.c_str()); }
+
+            const std::string & path() const { return m_path; }
+    };
+
+    /**
+     * Every test file, and a generated blob, one after another
+     */
+    std::vector<std::string>
+    concatenated (std::string & to_) {
+        std::vector<std::string> blobs;
+
+        for (const auto & path : BatchInspector::expand (filepath)) {
+            blobs.emplace_back (slurp (path));
+        }
+
+        Generator::Shape shape;
+        shape.bytes = 1 << 18;
+        blobs.emplace_back (Generator (shape).blob());
+
+        for (const auto & blob : blobs) {
+            to_ += blob;
+        }
+
+        return blobs;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Each envelope is found where it was put and reads as it did alone
+ */
+TEST (CordaStream, sections) { // NOLINT
+    std::string contents;
+    auto blobs = concatenated (contents);
+
+    TempFile file (contents);
+    CordaStream stream (file.path());
+
+    auto sections = stream.sections();
+
+    ASSERT_EQ (blobs.size(), sections.size());
+
+    size_t offset { 0 };
+
+    for (size_t i { 0 } ; i < blobs.size() ; ++i) {
+        const auto & section = sections[i];
+
+        ASSERT_EQ (offset, section.offset);
+        ASSERT_EQ (amqp::DATA_AND_STOP, section.encoding);
+        ASSERT_EQ (blobs[i].size() - CordaBytes::HEADER_SIZE, section.size);
+
+        CordaBytes alone (section.encoding, section.bytes, section.size);
+        std::istringstream in (blobs[i]);
+        CordaBytes copied (in);
+
+        ASSERT_EQ (BlobInspector (copied).dump(), BlobInspector (alone).dump()) << i;
+
+        offset += blobs[i].size();
+    }
+
+    // and again, having rewound
+    CordaStream::Section section { };
+
+    stream.rewind();
+    ASSERT_TRUE (stream.next (section));
+    ASSERT_EQ (0U, section.offset);
+}
+
+/******************************************************************************/
+
+TEST (CordaStream, batch) { // NOLINT
+    std::string contents;
+    auto blobs = concatenated (contents);
+
+    TempFile file (contents);
+    CordaStream stream (file.path());
+
+    std::stringstream out, err;
+
+    ASSERT_EQ (0U, BatchInspector (4).run (file.path(), stream, out, err));
+    ASSERT_EQ ("", err.str());
+
+    std::string line;
+    size_t offset { 0 };
+
+    for (const auto & blob : blobs) {
+        ASSERT_TRUE (std::getline (out, line));
+        ASSERT_EQ (0U, line.find (
+            file.path() + "@" + std::to_string (offset) + " : { Parsed : "));
+
+        offset += blob.size();
+    }
+
+    ASSERT_FALSE (std::getline (out, line));
+}
+
+/******************************************************************************/
+
+TEST (CordaStream, bad) { // NOLINT
+    auto blob = slurp (filepath + "_i_");
+    CordaStream::Section section { };
+
+    // cut short
+    {
+        TempFile file (blob + blob.substr (0, blob.size() - 1));
+        CordaStream stream (file.path());
+
+        ASSERT_TRUE (stream.next (section));
+        ASSERT_THROW (stream.next (section), std::runtime_error); // NOLINT
+    }
+
+    // anything but a header between envelopes
+    {
+        TempFile file (blob + "xx" + blob);
+        CordaStream stream (file.path());
+
+        ASSERT_TRUE (stream.next (section));
+        ASSERT_THROW (stream.next (section), std::runtime_error); // NOLINT
+    }
+
+    // compressed
+    {
+        auto compressed = blob;
+        compressed[amqp::AMQP_HEADER.size()] = amqp::ENCODING;
+
+        TempFile file (blob + compressed);
+        CordaStream stream (file.path());
+
+        ASSERT_TRUE (stream.next (section));
+        ASSERT_THROW (stream.next (section), std::runtime_error); // NOLINT
+    }
 }
 
 /******************************************************************************/
@@ -5,6 +5,7 @@
 #include <any>
 
 #include "amqp/AMQPDescribed.h"
+#include "amqp/reader/IVisitor.h"
 
 #include "amqp/schema/described-types/Schema.h"
 
@@ -14,7 +15,11 @@
  *
  ******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::internal::decoder {
+
+    class Decoder;
+
+}
 
 /******************************************************************************
  *
@@ -33,6 +38,15 @@ namespace amqp::reader {
         public :
             virtual std::string dump() const = 0;
 
+            /**
+             * As [dump] but onto the end of [out_], which lets a whole tree
+             * be written into one string rather than each value building
+             * its own for its parent to copy
+             */
+            virtual void dumpTo (std::string & out_) const {
+                out_.append (dump());
+            }
+
             virtual ~IValue() = default;
     };
 
@@ -56,18 +70,27 @@ namespace amqp::reader {
             virtual const std::string & name() const = 0;
             virtual const std::string & type() const = 0;
 
-            virtual std::any read (pn_data_t *) const = 0;
-            virtual std::string readString (pn_data_t *) const = 0;
+            virtual std::any read (amqp::internal::decoder::Decoder *) const = 0;
+            virtual std::string readString (amqp::internal::decoder::Decoder *) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
                     const std::string &,
-                    pn_data_t *,
+                    amqp::internal::decoder::Decoder *,
                     const SchemaType &) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
-                    pn_data_t *,
+                    amqp::internal::decoder::Decoder *,
                     const SchemaType &) const = 0;
 
+            /**
+             * Walk the value under the cursor reporting everything found
+             * to the visitor, leaving the cursor on the next value
+             */
+            virtual void visit (
+                    amqp::internal::decoder::Decoder *,
+                    const SchemaType &,
+                    IVisitor &) const = 0;
+
     };
 
 }
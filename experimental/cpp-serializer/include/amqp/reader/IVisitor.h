@@ -0,0 +1,91 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::IVisitor
+ *
+ ******************************************************************************/
+
+/**
+ * A push style alternative to building a tree of [IValue]s. As a reader
+ * walks the blob it reports what it finds to a visitor, which can do with
+ * it as it likes, write it to a stream, build a tree of its own, count
+ * things, whatever.
+ *
+ * Properties of a composite are announced with [key] immediately before
+ * their value. The entries of a map are not named, instead each key and
+ * then its value are reported as ordinary values in turn.
+ *
+ * Views passed to the string callbacks are only valid for the duration of
+ * the call.
+ */
+namespace amqp::reader {
+
+    class IVisitor {
+        public :
+            virtual ~IVisitor() = default;
+
+            virtual void beginComposite (const std::string & type_) = 0;
+            virtual void endComposite() = 0;
+
+            virtual void beginList() = 0;
+            virtual void endList() = 0;
+
+            virtual void beginMap() = 0;
+            virtual void endMap() = 0;
+
+            virtual void key (const std::string &) = 0;
+
+            virtual void intValue (int32_t) = 0;
+            virtual void longValue (int64_t) = 0;
+            virtual void boolValue (bool) = 0;
+            virtual void doubleValue (double) = 0;
+            virtual void stringValue (std::string_view) = 0;
+            virtual void enumValue (std::string_view) = 0;
+
+            /**
+             * The raw bytes of a binary value, a view straight into the
+             * blob, it being up to the visitor how they're written out
+             */
+            virtual void binaryValue (std::string_view) = 0;
+
+            /**
+             * A number that won't go through any of the above without
+             * losing something, a decimal or an unsigned long past the
+             * range of a long, already written out in full
+             */
+            virtual void numberValue (std::string_view) = 0;
+
+            /**
+             * A value that isn't there, a field the blob was written
+             * without for instance
+             */
+            virtual void nullValue() = 0;
+
+            /**
+             * Every composite, enum, list, array and map is numbered in the
+             * order it finished being written, as is every element of a
+             * list or array and key or value of a map that isn't a JVM
+             * primitive, boxed or not, or a byte array, Strings for
+             * instance. Corda writes any of those it has already written
+             * as a reference to that number.
+             *
+             * [object] is called with the number of each as it finishes.
+             * Where the blob refers back to one [reference] is called, if
+             * that returns false the original is visited again, so by
+             * default a visitor can't tell references were used at all.
+             */
+            virtual void object (size_t) { }
+            virtual bool reference (size_t) { return false; }
+    };
+
+}
+
+/******************************************************************************/
@@ -19,16 +19,16 @@ namespace amqp::schema::descriptors {
 
 namespace amqp::schema::descriptors {
 
-    extern const int ENVELOPE;
-    extern const int SCHEMA;
-    extern const int OBJECT;
-    extern const int FIELD;
-    extern const int COMPOSITE_TYPE;
-    extern const int RESTRICTED_TYPE;
-    extern const int CHOICE;
-    extern const int REFERENCED_OBJECT;
-    extern const int TRANSFORM_SCHEMA;
-    extern const int TRANSFORM_ELEMENT;
-    extern const int TRANSFORM_ELEMENT_KEY;
+    constexpr int ENVELOPE              =  1;
+    constexpr int SCHEMA                =  2;
+    constexpr int OBJECT                =  3;
+    constexpr int FIELD                 =  4;
+    constexpr int COMPOSITE_TYPE        =  5;
+    constexpr int RESTRICTED_TYPE       =  6;
+    constexpr int CHOICE                =  7;
+    constexpr int REFERENCED_OBJECT     =  8;
+    constexpr int TRANSFORM_SCHEMA      =  9;
+    constexpr int TRANSFORM_ELEMENT     = 10;
+    constexpr int TRANSFORM_ELEMENT_KEY = 11;
 
 }
@@ -0,0 +1,196 @@
+#include "BinaryEncoding.h"
+
+#if defined (__SSSE3__)
+#   include <tmmintrin.h>
+#elif defined (__SSE2__)
+#   include <emmintrin.h>
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    const char HEX[] = "0123456789abcdef";
+
+    const char BASE64[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    /**
+     * @return how many bytes were dealt with, always whole vectors
+     */
+    size_t
+    hexVectors (const uint8_t * from_, size_t n_, char * to_) {
+        size_t i { 0 };
+
+#if defined (__SSSE3__)
+        const auto digits = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(HEX));
+        const auto low = _mm_set1_epi8 (0x0F);
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i));
+
+            auto hi = _mm_shuffle_epi8 (digits, _mm_and_si128 (_mm_srli_epi16 (v, 4), low));
+            auto lo = _mm_shuffle_epi8 (digits, _mm_and_si128 (v, low));
+
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(to_ + 2 * i), _mm_unpacklo_epi8 (hi, lo));
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(to_ + 2 * i + 16), _mm_unpackhi_epi8 (hi, lo));
+        }
+#elif defined (__SSE2__)
+        // no table lookup so each nibble becomes '0' + n, plus the gap
+        // between '9' and 'a' where it's more than nine
+        const auto low = _mm_set1_epi8 (0x0F);
+        const auto nine = _mm_set1_epi8 (9);
+        const auto zero = _mm_set1_epi8 ('0');
+        const auto gap = _mm_set1_epi8 ('a' - '0' - 10);
+
+        auto text = [&](__m128i nibbles_) {
+            auto letters = _mm_and_si128 (_mm_cmpgt_epi8 (nibbles_, nine), gap);
+            return _mm_add_epi8 (_mm_add_epi8 (nibbles_, zero), letters);
+        };
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i));
+
+            auto hi = text (_mm_and_si128 (_mm_srli_epi16 (v, 4), low));
+            auto lo = text (_mm_and_si128 (v, low));
+
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(to_ + 2 * i), _mm_unpacklo_epi8 (hi, lo));
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(to_ + 2 * i + 16), _mm_unpackhi_epi8 (hi, lo));
+        }
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+        const auto digits = vld1q_u8 (reinterpret_cast<const uint8_t *>(HEX));
+        const auto low = vdupq_n_u8 (0x0F);
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = vld1q_u8 (from_ + i);
+
+            auto text = vzipq_u8 (
+                    vqtbl1q_u8 (digits, vshrq_n_u8 (v, 4)),
+                    vqtbl1q_u8 (digits, vandq_u8 (v, low)));
+
+            vst1q_u8 (reinterpret_cast<uint8_t *>(to_ + 2 * i), text.val[0]);
+            vst1q_u8 (reinterpret_cast<uint8_t *>(to_ + 2 * i + 16), text.val[1]);
+        }
+#endif
+
+        return i;
+    }
+
+    /**
+     * Wojciech Muła's approach, twelve bytes at a time become sixteen six
+     * bit indices, one per byte, which are then turned into text by adding
+     * an offset that depends on which range of the alphabet they're in.
+     *
+     * Each step loads sixteen bytes to use twelve so we stop while there
+     * are still at least four more.
+     *
+     * @return how many bytes were dealt with, always a multiple of twelve
+     */
+    size_t
+    base64Vectors (const uint8_t * from_, size_t n_, char * to_) {
+        size_t i { 0 };
+
+#if defined (__SSSE3__)
+        // bytes 0 1 2 become 1 0 2 1, and so on, each 32 bit lane then
+        // holds one group of three ready to be split in place
+        const auto spread = _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+
+        const auto offsets = _mm_setr_epi8 (
+                'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                '/' - 63, 'A', 0, 0);
+
+        char * to = to_;
+
+        for ( ; i + 16 <= n_ ; i += 12, to += 16) {
+            auto v = _mm_shuffle_epi8 (
+                    _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i)),
+                    spread);
+
+            auto indices = _mm_or_si128 (
+                    _mm_mulhi_epu16 (
+                            _mm_and_si128 (v, _mm_set1_epi32 (0x0fc0fc00)),
+                            _mm_set1_epi32 (0x04000040)),
+                    _mm_mullo_epi16 (
+                            _mm_and_si128 (v, _mm_set1_epi32 (0x003f03f0)),
+                            _mm_set1_epi32 (0x01000010)));
+
+            // 0..51 become 0 and 52..63 1..12, then 0..25 are told apart
+            // from 26..51 by becoming 13
+            auto range = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+            auto upper = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+
+            range = _mm_or_si128 (range, _mm_and_si128 (upper, _mm_set1_epi8 (13)));
+
+            _mm_storeu_si128 (
+                    reinterpret_cast<__m128i *>(to),
+                    _mm_add_epi8 (_mm_shuffle_epi8 (offsets, range), indices));
+        }
+#endif
+
+        return i;
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+toHex (const uint8_t * from_, size_t n_, char * to_) {
+    for (size_t i { hexVectors (from_, n_, to_) } ; i < n_ ; ++i) {
+        to_[2 * i]     = HEX[from_[i] >> 4];
+        to_[2 * i + 1] = HEX[from_[i] & 0xF];
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+toBase64 (const uint8_t * from_, size_t n_, char * to_) {
+    size_t i = base64Vectors (from_, n_, to_);
+    char * to = to_ + i / 3 * 4;
+
+    for ( ; i + 3 <= n_ ; i += 3) {
+        uint32_t group = (from_[i] << 16) | (from_[i + 1] << 8) | from_[i + 2];
+
+        *to++ = BASE64[group >> 18];
+        *to++ = BASE64[(group >> 12) & 0x3F];
+        *to++ = BASE64[(group >> 6) & 0x3F];
+        *to++ = BASE64[group & 0x3F];
+    }
+
+    if (i < n_) {
+        uint32_t group = from_[i] << 16;
+
+        if (i + 1 < n_) {
+            group |= from_[i + 1] << 8;
+        }
+
+        *to++ = BASE64[group >> 18];
+        *to++ = BASE64[(group >> 12) & 0x3F];
+        *to++ = i + 1 < n_ ? BASE64[(group >> 6) & 0x3F] : '=';
+        *to++ = '=';
+    }
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::
+binaryEncodingImplementation() {
+#if defined (__SSSE3__)
+    return "ssse3";
+#elif defined (__SSE2__)
+    return "sse2";
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/******************************************************************************/
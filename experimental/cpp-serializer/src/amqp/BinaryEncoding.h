@@ -0,0 +1,40 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Write [n_] bytes from [from_] into [to_] as text, either lower case
+     * hex or standard, padded, base64. [to_] must have room for the
+     * matching length and is not terminated.
+     *
+     * Hashes, keys and signatures all turn up as binary so a blob can be
+     * full of them. Where the target allows these are done 16 bytes at a
+     * time, SSSE3 for both or SSE2 for hex alone on x86 and NEON for hex on
+     * AArch64, and a byte, or three, at a time otherwise.
+     */
+    constexpr size_t hexLength (size_t n_) {
+        return 2 * n_;
+    }
+
+    constexpr size_t base64Length (size_t n_) {
+        return (n_ + 2) / 3 * 4;
+    }
+
+    void toHex (const uint8_t * from_, size_t n_, char * to_);
+    void toBase64 (const uint8_t * from_, size_t n_, char * to_);
+
+    /**
+     * @return which of the above we were built with
+     */
+    const char * binaryEncodingImplementation();
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,109 @@
+#include "Classifier.h"
+
+#include <stdexcept>
+
+#include "amqp/SchemaCache.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    expect (amqp::internal::decoder::Decoder & data_, int descriptor_) {
+        amqp::internal::decoder::is_ulong (&data_);
+
+        if (amqp::stripCorda (data_.get_ulong())
+            != static_cast<uint32_t>(descriptor_)
+        ) {
+            throw std::runtime_error (
+                "Expected a " + amqp::describedToString (
+                        static_cast<uint32_t>(descriptor_)));
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Classifier::Classifier()
+    : m_classification { { }, 0, { } }
+{
+}
+
+/******************************************************************************/
+
+/**
+ * A Schema is a described list holding a single list of types, each a
+ * described list whose first element is the type's name whether it's a
+ * composite or a restricted type
+ */
+void
+amqp::internal::
+Classifier::schema (decoder::Decoder & data_) {
+    decoder::is_described (&data_);
+    decoder::auto_enter ae1 (&data_);
+    expect (data_, amqp::schema::descriptors::SCHEMA);
+
+    data_.next();
+    decoder::is_list (&data_);
+    decoder::auto_enter ae2 (&data_);
+
+    decoder::is_list (&data_);
+    // no reserve from the count, types is cleared rather than freed
+    // between blobs so it only grows to the biggest schema we've seen
+    decoder::auto_list_enter ale (&data_);
+
+    while (data_.next()) {
+        decoder::is_described (&data_);
+        decoder::auto_enter ae3 (&data_);
+
+        data_.next();
+        decoder::is_list (&data_);
+        decoder::auto_enter ae4 (&data_);
+
+        decoder::is_string (&data_);
+        m_classification.types.push_back (data_.get_string());
+    }
+}
+
+/******************************************************************************/
+
+const amqp::internal::Classifier::Classification &
+amqp::internal::
+Classifier::classify (decoder::Decoder & data_) {
+    m_classification.descriptor = { };
+    m_classification.types.clear();
+
+    decoder::is_described (&data_);
+    decoder::auto_enter ae1 (&data_);
+    expect (data_, amqp::schema::descriptors::ENVELOPE);
+
+    data_.next();
+    decoder::is_list (&data_);
+    decoder::auto_enter ae2 (&data_);
+
+    {
+        decoder::is_described (&data_);
+        decoder::auto_enter ae3 (&data_);
+        decoder::is_symbol (&data_);
+        m_classification.descriptor = data_.get_symbol();
+    }
+
+    // over the payload, however big it is, to the schema
+    data_.next();
+
+    auto encoded = data_.encoded();
+
+    schema (data_);
+
+    m_classification.fingerprint = SchemaCache::fingerprint (
+            encoded,
+            data_.next() ? data_.encoded() : std::string_view());
+
+    return m_classification;
+}
+
+/******************************************************************************/
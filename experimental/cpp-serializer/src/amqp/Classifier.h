@@ -0,0 +1,70 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::Classifier
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Says what a blob is without reading it. For routing and inventory we
+     * only want the descriptor of the payload and the names of the types
+     * in its schema, all of which can be had by walking the envelope with
+     * a [decoder::Decoder]. The payload is stepped over whole, which costs
+     * the same whatever its size, and nothing of the schema is built.
+     *
+     * Everything handed back is a view into the blob so is good only for
+     * as long as it is, and only until the next [classify].
+     *
+     * Not to be shared between threads, one each.
+     */
+    class Classifier {
+        public :
+            struct Classification {
+                /**
+                 * Of the payload, the type of the object the blob holds
+                 */
+                std::string_view descriptor;
+
+                /**
+                 * What the [SchemaCache] keys the schema, transforms
+                 * included, on
+                 */
+                uint64_t fingerprint;
+
+                /**
+                 * The name of every type in the schema, in the order
+                 * they were written
+                 */
+                std::vector<std::string_view> types;
+            };
+
+        private :
+            Classification m_classification;
+
+            void schema (decoder::Decoder &);
+
+        public :
+            Classifier();
+
+            /**
+             * @param data_ on the envelope, as it is when first reset on
+             * a blob. It's left somewhere inside it.
+             */
+            const Classification & classify (decoder::Decoder & data_);
+    };
+
+}
+
+/******************************************************************************/
@@ -20,6 +20,8 @@
 #include "reader/restricted-readers/ListReader.h"
 #include "reader/restricted-readers/ArrayReader.h"
 #include "reader/restricted-readers/EnumReader.h"
+#include "reader/restricted-readers/PrimitiveArrayReader.h"
+#include "reader/property-readers/NumberedPropertyReader.h"
 
 #include "schema/restricted-types/Map.h"
 #include "schema/restricted-types/List.h"
@@ -30,32 +32,40 @@
 
 namespace {
 
+    using namespace amqp::internal;
+
 /**
  *
  */
     template<typename T>
-    std::shared_ptr<T> &
+    std::shared_ptr<T>
     computeIfAbsent(
-            spStrMap_t<T> &map_,
+            SymbolMap<std::shared_ptr<T>> &map_,
             const std::string &k_,
             std::function<std::shared_ptr<T>(void)> f_
     ) {
-        auto it = map_.find(k_);
+        auto symbol = intern (k_);
+        auto it = map_.find (symbol);
 
         if (it == map_.end()) {
             DBG ("ComputeIfAbsent \"" << k_ << "\" - missing" << std::endl); // NOLINT
-            map_[k_] = std::move (f_());
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << " : " << map_[k_]->type()
+
+            // building the reader may well add others to the map so hang
+            // on to it rather than anything pointing into the map
+            auto reader = f_();
+
+            DBG ("                \"" << k_ << "\" - RTN: " << reader->name() << " : " << reader->type()
                                       << std::endl); // NOLINT
-            assert (map_[k_]);
-            assert (map_[k_] != nullptr);
-            DBG (k_ << " =?= " << map_[k_]->type() << std::endl);
-            assert (k_ == map_[k_]->type());
+            assert (reader != nullptr);
+            DBG (k_ << " =?= " << reader->type() << std::endl);
+            assert (k_ == reader->type());
 
-            return map_[k_];
+            map_[symbol] = reader;
+
+            return reader;
         } else {
             DBG ("ComputeIfAbsent \"" << k_ << "\" - found it" << std::endl); // NOLINT
-            DBG ("                \"" << k_ << "\" - RTN: " << map_[k_]->name() << std::endl); // NOLINT
+            DBG ("                \"" << k_ << "\" - RTN: " << it->second->name() << std::endl); // NOLINT
 
             assert (it->second != nullptr);
 
@@ -71,6 +81,20 @@ namespace {
  *
  ******************************************************************************/
 
+amqp::internal::
+CompositeFactory::CompositeFactory()
+    : m_evolution (nullptr)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::
+CompositeFactory::CompositeFactory (const Evolution & evolution_)
+    : m_evolution (&evolution_)
+{ }
+
+/******************************************************************************/
+
 /**
  *
  * Walk through the types in a Schema and produce readers for them.
@@ -89,7 +113,8 @@ CompositeFactory::process (const SchemaType & schema_) {
     for (const auto & i : dynamic_cast<const schema::Schema &>(schema_)) {
         for (const auto & j : i) {
             process (*j);
-            m_readersByDescriptor[j->descriptor()] = m_readersByType[j->name()];
+            m_readersByDescriptor[intern (j->descriptor())] =
+                m_readersByType[intern (j->name())];
         }
     }
 }
@@ -151,7 +176,7 @@ CompositeFactory::processComposite (
         else {
             // Insertion sorting ensures any type we depend on will have
             // already been created and thus exist in the map
-            reader = m_readersByType[field->resolvedType()];
+            reader = m_readersByType[intern (field->resolvedType())];
         }
 
 
@@ -160,7 +185,14 @@ CompositeFactory::processComposite (
         assert (readers.back().lock());
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    const auto & composite = dynamic_cast<const schema::Composite &> (type_);
+
+    return std::make_shared<reader::CompositeReader> (
+            composite,
+            readers,
+            m_evolution
+                ? m_evolution->fields (composite)
+                : std::vector<Evolution::Field>());
 }
 
 /******************************************************************************/
@@ -174,11 +206,19 @@ CompositeFactory::processEnum (
 
     return std::make_shared<reader::EnumReader> (
         enum_.name(),
-        enum_.makeChoices());
+        enum_.makeChoices(),
+        m_evolution
+            ? m_evolution->constants (enum_)
+            : std::vector<std::string>());
 }
 
 /******************************************************************************/
 
+/**
+ * The reader of the elements of a list or array, or of the keys or values
+ * of a map. For a primitive Corda numbers in those places it's the reader
+ * used for fields, wrapped in one that numbers them as well.
+ */
 std::shared_ptr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
@@ -194,8 +234,17 @@ CompositeFactory::fetchReaderForRestricted (const std::string & type_) {
                 [& type_]() -> std::shared_ptr<reader::PropertyReader> {
                     return reader::PropertyReader::make (type_);
                 });
+
+        if (reader::PropertyReader::numbered (type_)) {
+            rtn = computeIfAbsent<reader::Reader>(
+                    m_elementReaders,
+                    type_,
+                    [& rtn]() -> std::shared_ptr<reader::Reader> {
+                        return std::make_shared<reader::NumberedPropertyReader> (rtn);
+                    });
+        }
     } else {
-        rtn = m_readersByType[type_];
+        rtn = m_readersByType[intern (type_)];
     }
 
     if (!rtn) {
@@ -247,6 +296,26 @@ CompositeFactory::processArray (
 ) {
     DBG ("Processing Array - " << array_.name() << " " << array_.arrayOf() << std::endl); // NOLINT
 
+    /*
+     * Unboxed arrays of the wider numeric types can skip the per element
+     * readers entirely and be read straight into a buffer
+     */
+    const auto & name = array_.name();
+    if (name.size() > 3 && name.compare (name.size() - 3, 3, "[p]") == 0) {
+        const auto & of = array_.arrayOf();
+
+        if (of == "int") {
+            return std::make_shared<reader::PrimitiveArrayReader<int32_t>> (
+                    name, fetchReaderForRestricted (of));
+        } else if (of == "long") {
+            return std::make_shared<reader::PrimitiveArrayReader<int64_t>> (
+                    name, fetchReaderForRestricted (of));
+        } else if (of == "double") {
+            return std::make_shared<reader::PrimitiveArrayReader<double>> (
+                    name, fetchReaderForRestricted (of));
+        }
+    }
+
     return std::make_shared<reader::ArrayReader> (
             array_.name(),
             fetchReaderForRestricted (array_.arrayOf()));
@@ -292,7 +361,7 @@ CompositeFactory::processRestricted (
 const std::shared_ptr<amqp::internal::reader::IReader>
 amqp::internal::
 CompositeFactory::byType (const std::string & type_) {
-    auto it = m_readersByType.find (type_);
+    auto it = m_readersByType.find (Symbols::instance().find (type_));
 
     return (it == m_readersByType.end()) ? nullptr : it->second;
 }
@@ -302,7 +371,7 @@ CompositeFactory::byType (const std::string & type_) {
 const std::shared_ptr<amqp::internal::reader::IReader>
 amqp::internal::
 CompositeFactory::byDescriptor (const std::string & descriptor_) {
-    auto it = m_readersByDescriptor.find (descriptor_);
+    auto it = m_readersByDescriptor.find (Symbols::instance().find (descriptor_));
 
     return (it == m_readersByDescriptor.end()) ? nullptr : it->second;
 }
@@ -2,11 +2,12 @@
 
 /******************************************************************************/
 
-#include <map>
 #include <set>
 #include <memory>
 
 #include "types.h"
+#include "SymbolMap.h"
+#include "Evolution.h"
 
 #include "amqp/ICompositeFactory.h"
 #include "amqp/schema/described-types/Schema.h"
@@ -29,11 +30,25 @@ namespace amqp::internal {
             using CompositePtr = uPtr<schema::Composite>;
             using EnvelopePtr  = uPtr<schema::Envelope>;
 
-            spStrMap_t<reader::Reader> m_readersByType;
-            spStrMap_t<reader::Reader> m_readersByDescriptor;
+            SymbolMap<sPtr<reader::Reader>> m_readersByType;
+            SymbolMap<sPtr<reader::Reader>> m_readersByDescriptor;
+
+            /**
+             * Readers of those primitives numbered when they're elements
+             * of a list, array or map, by their type
+             */
+            SymbolMap<sPtr<reader::Reader>> m_elementReaders;
+
+            /**
+             * Set when the readers we build are to read values as another
+             * version of the schema has them
+             */
+            const Evolution * m_evolution;
 
         public :
-            CompositeFactory() = default;
+            CompositeFactory();
+
+            explicit CompositeFactory (const Evolution &);
 
             void process (const SchemaType &) override;
 
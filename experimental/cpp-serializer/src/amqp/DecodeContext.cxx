@@ -0,0 +1,77 @@
+#include "DecodeContext.h"
+
+/******************************************************************************
+ *
+ * class DecodeContext::TextBuffer
+ *
+ ******************************************************************************/
+
+std::streambuf::int_type
+amqp::internal::
+DecodeContext::TextBuffer::overflow (int_type c_) {
+    if (!traits_type::eq_int_type (c_, traits_type::eof())) {
+        m_text.push_back (traits_type::to_char_type (c_));
+    }
+
+    return traits_type::not_eof (c_);
+}
+
+/******************************************************************************/
+
+std::streamsize
+amqp::internal::
+DecodeContext::TextBuffer::xsputn (const char * from_, std::streamsize n_) {
+    m_text.append (from_, static_cast<size_t>(n_));
+
+    return n_;
+}
+
+/******************************************************************************
+ *
+ * class DecodeContext
+ *
+ ******************************************************************************/
+
+amqp::internal::
+DecodeContext::DecodeContext()
+    : m_data (nullptr, 0)
+    , m_payload (nullptr, 0)
+    , m_text (&m_buffer)
+    , m_blobs (0)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+DecodeContext::reset (const char * bytes_, size_t size_) {
+    m_data.reset (bytes_, size_);
+
+    m_descriptor.clear();
+    m_buffer.str().clear();
+    m_text.clear();
+
+    if (m_json) {
+        m_json->reset();
+    }
+
+    ++m_blobs;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::JsonWriter &
+amqp::internal::
+DecodeContext::json (
+    reader::JsonWriter::Style style_,
+    reader::JsonWriter::Binary binary_
+) {
+    if (!m_json || m_json->style() != style_ || m_json->binary() != binary_) {
+        m_json.emplace (style_, -1, binary_);
+    }
+
+    return *m_json;
+}
+
+/******************************************************************************/
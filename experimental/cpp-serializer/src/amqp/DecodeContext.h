@@ -0,0 +1,118 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <ostream>
+#include <optional>
+#include <streambuf>
+
+#include "amqp/Classifier.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/visitors/JsonWriter.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::DecodeContext
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Everything reading a blob needs bar the blob itself and its schema,
+     * the cursors we walk it with, somewhere to keep the descriptor of its
+     * payload and the buffers its text or JSON is written into.
+     *
+     * One is meant to be made once and [reset] for every blob that follows.
+     * Nothing it owns gives back the capacity it grew to, so a long run
+     * over blobs of much the same shape soon stops allocating for any of
+     * this at all.
+     *
+     * Not to be shared between threads, one each.
+     */
+    class DecodeContext {
+        private :
+            /**
+             * What's written to [m_text] is appended to a string we keep,
+             * a std::stringstream would build a new one every time we
+             * asked it for what it held
+             */
+            class TextBuffer : public std::streambuf {
+                private :
+                    std::string m_text;
+
+                protected :
+                    int_type overflow (int_type) override;
+                    std::streamsize xsputn (const char *, std::streamsize) override;
+
+                public :
+                    std::string & str() { return m_text; }
+            };
+
+            decoder::Decoder m_data;
+
+            /**
+             * A second cursor left on the payload whilst [m_data] goes on
+             * to the schema that follows it
+             */
+            decoder::Decoder m_payload;
+
+            std::string m_descriptor;
+
+            TextBuffer   m_buffer;
+            std::ostream m_text;
+
+            /**
+             * Made the first time JSON is asked for, and again should it
+             * be asked for in a different style
+             */
+            std::optional<reader::JsonWriter> m_json;
+
+            Classifier m_classifier;
+
+            size_t m_blobs;
+
+        public :
+            DecodeContext();
+
+            DecodeContext (const DecodeContext &) = delete;
+            DecodeContext & operator = (const DecodeContext &) = delete;
+
+            /**
+             * Start on a new blob, [data] is left on its first value and
+             * the text and JSON written for the last one is thrown away
+             */
+            void reset (const char *, size_t);
+
+            decoder::Decoder & data() { return m_data; }
+            decoder::Decoder & payload() { return m_payload; }
+
+            std::string & descriptor() { return m_descriptor; }
+
+            Classifier & classifier() { return m_classifier; }
+
+            std::ostream & text() { return m_text; }
+
+            /**
+             * Everything written to [text] since the last [reset]
+             */
+            const std::string & str() { return m_buffer.str(); }
+
+            /**
+             * A writer that keeps everything in its buffer, emptied by
+             * [reset]
+             */
+            reader::JsonWriter & json (
+                reader::JsonWriter::Style,
+                reader::JsonWriter::Binary = reader::JsonWriter::hex_t);
+
+            /**
+             * How many times we've been [reset]
+             */
+            size_t blobs() const { return m_blobs; }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,188 @@
+#include "Evolution.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+/******************************************************************************/
+
+amqp::internal::
+Evolution::Evolution (
+    const schema::Schema & reader_,
+    const schema::TransformsSchema & readerTransforms_,
+    const schema::TransformsSchema & writerTransforms_
+) {
+    for (const auto & i : reader_) {
+        for (const auto & j : i) {
+            m_types[j->name()] = j.get();
+        }
+    }
+
+    add (readerTransforms_);
+    add (writerTransforms_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Evolution::add (const schema::TransformsSchema & transforms_) {
+    for (const auto & type : transforms_) {
+        auto & renames = m_renames[type.first];
+        auto & defaults = m_defaults[type.first];
+
+        renames.resize (2);
+
+        for (const auto & transform : type.second) {
+            switch (transform->type()) {
+                case schema::Transform::rename_t :
+                    renames[0].emplace (transform->from(), transform->to());
+                    renames[1].emplace (transform->to(), transform->from());
+                    break;
+                case schema::Transform::enumDefault_t :
+                    defaults.emplace (transform->from(), transform->to());
+                    break;
+                default :
+                    break;
+            }
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Follow renames, in either direction, and then defaults until we reach a
+ * constant the reader knows, never going back to one we've already tried
+ *
+ * @return empty if we never do
+ */
+std::string
+amqp::internal::
+Evolution::resolve (
+        const std::string & type_,
+        const std::string & constant_,
+        const std::vector<std::string> & known_
+) const {
+    auto renames = m_renames.find (type_);
+    auto defaults = m_defaults.find (type_);
+
+    std::unordered_set<std::string> tried;
+    std::string constant { constant_ };
+
+    while (tried.insert (constant).second) {
+        if (std::find (known_.begin(), known_.end(), constant) != known_.end()) {
+            return constant;
+        }
+
+        const std::string * next { nullptr };
+
+        if (renames != m_renames.end()) {
+            for (const auto & direction : renames->second) {
+                auto it = direction.find (constant);
+
+                if (it != direction.end() && !tried.count (it->second)) {
+                    next = &it->second;
+                    break;
+                }
+            }
+        }
+
+        if (!next && defaults != m_defaults.end()) {
+            auto it = defaults->second.find (constant);
+
+            if (it != defaults->second.end()) {
+                next = &it->second;
+            }
+        }
+
+        if (!next) {
+            break;
+        }
+
+        constant = *next;
+    }
+
+    return { };
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::Evolution::Field>
+amqp::internal::
+Evolution::fields (const schema::Composite & writer_) const {
+    auto it = m_types.find (writer_.name());
+
+    if (it == m_types.end()
+        || it->second->type() != schema::AMQPTypeNotation::composite_t
+    ) {
+        return { };
+    }
+
+    const auto & written = writer_.fields();
+    const auto & wanted = dynamic_cast<const schema::Composite &> (
+            *it->second).fields();
+
+    std::vector<Field> rtn;
+    rtn.reserve (wanted.size());
+
+    bool same { wanted.size() == written.size() };
+
+    for (size_t i { 0 } ; i < wanted.size() ; ++i) {
+        Field field { wanted[i]->name(), npos };
+
+        for (size_t j { 0 } ; j < written.size() ; ++j) {
+            if (written[j]->name() == field.name) {
+                field.from = j;
+                break;
+            }
+        }
+
+        same = same && field.from == i;
+
+        rtn.push_back (std::move (field));
+    }
+
+    return same ? std::vector<Field>() : rtn;
+}
+
+/******************************************************************************/
+
+std::vector<std::string>
+amqp::internal::
+Evolution::constants (const schema::Enum & writer_) const {
+    auto it = m_types.find (writer_.name());
+
+    if (it == m_types.end()) {
+        return { };
+    }
+
+    const auto * wanted = dynamic_cast<const schema::Enum *> (it->second);
+
+    if (!wanted) {
+        return { };
+    }
+
+    auto known = wanted->makeChoices();
+    auto written = writer_.makeChoices();
+
+    std::vector<std::string> rtn;
+    rtn.reserve (written.size());
+
+    bool same { true };
+
+    for (const auto & constant : written) {
+        auto resolved = resolve (writer_.name(), constant, known);
+
+        if (resolved.empty()) {
+            resolved = constant;
+        }
+
+        same = same && resolved == constant;
+
+        rtn.push_back (std::move (resolved));
+    }
+
+    return same ? std::vector<std::string>() : rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,94 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
+#include "amqp/schema/restricted-types/Enum.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::Evolution
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * What it takes to read values written with one version of a set of
+     * types as though they'd been written with another, the reader's.
+     *
+     * Types are matched by name. A composite's fields are then matched by
+     * name too, those the writer didn't have reading as null and those the
+     * reader doesn't have being dropped. An enum's constants are carried
+     * across any renames and, where the reader still doesn't know them,
+     * their EnumDefaults, using the transforms from both sides.
+     *
+     * All of this is worked out as the [CompositeFactory] builds its readers
+     * so none of it is revisited per value.
+     */
+    class Evolution {
+        public :
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            struct Field {
+                std::string name;
+
+                /**
+                 * The writer's field it's read from, npos if it had none
+                 */
+                size_t from;
+            };
+
+        private :
+            using Constants = std::unordered_map<std::string, std::string>;
+
+            std::unordered_map<std::string, const schema::AMQPTypeNotation *> m_types;
+
+            /**
+             * By type, each rename in both directions as which way round
+             * it's needed depends on which of the two sides is newer
+             */
+            std::unordered_map<std::string, std::vector<Constants>> m_renames;
+            std::unordered_map<std::string, Constants> m_defaults;
+
+            void add (const schema::TransformsSchema &);
+
+            std::string resolve (
+                const std::string &,
+                const std::string &,
+                const std::vector<std::string> &) const;
+
+        public :
+            Evolution (
+                const schema::Schema & reader_,
+                const schema::TransformsSchema & readerTransforms_,
+                const schema::TransformsSchema & writerTransforms_);
+
+            /**
+             * The reader's fields, in its order, for a composite written
+             * as [writer_]
+             *
+             * @return empty where it can be read as written
+             */
+            std::vector<Field> fields (const schema::Composite & writer_) const;
+
+            /**
+             * What each of [writer_]'s constants, in its order, should be
+             * read as. Anything we can't find a home for is left as it is.
+             *
+             * @return empty where it can be read as written
+             */
+            std::vector<std::string> constants (const schema::Enum & writer_) const;
+    };
+
+}
+
+/******************************************************************************/
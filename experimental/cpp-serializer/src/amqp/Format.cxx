@@ -0,0 +1,164 @@
+#include "Format.h"
+
+#include <cstdint>
+
+#if defined (__SSE2__)
+#   include <emmintrin.h>
+#   if defined (__AVX2__)
+#       include <immintrin.h>
+#   endif
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+#   include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    const char HEX[] = "0123456789abcdef";
+
+    inline bool
+    escapable (char c_) {
+        auto c = static_cast<unsigned char>(c_);
+
+        return c < 0x20 || c == '"' || c == '\\';
+    }
+
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+jsonEscape (const char * from_, size_t n_) {
+    size_t i { 0 };
+
+#if defined (__AVX2__)
+    {
+        const auto quote = _mm256_set1_epi8 ('"');
+        const auto slash = _mm256_set1_epi8 ('\\');
+        const auto control = _mm256_set1_epi8 (0x1F);
+
+        for ( ; i + 32 <= n_ ; i += 32) {
+            auto v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(from_ + i));
+
+            // unsigned v <= 0x1F is min (v, 0x1F) == v
+            auto hits = _mm256_or_si256 (
+                    _mm256_or_si256 (
+                            _mm256_cmpeq_epi8 (v, quote),
+                            _mm256_cmpeq_epi8 (v, slash)),
+                    _mm256_cmpeq_epi8 (_mm256_min_epu8 (v, control), v));
+
+            if (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8 (hits))) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+    }
+#endif
+
+#if defined (__SSE2__)
+    {
+        const auto quote = _mm_set1_epi8 ('"');
+        const auto slash = _mm_set1_epi8 ('\\');
+        const auto control = _mm_set1_epi8 (0x1F);
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i));
+
+            auto hits = _mm_or_si128 (
+                    _mm_or_si128 (
+                            _mm_cmpeq_epi8 (v, quote),
+                            _mm_cmpeq_epi8 (v, slash)),
+                    _mm_cmpeq_epi8 (_mm_min_epu8 (v, control), v));
+
+            if (auto mask = _mm_movemask_epi8 (hits)) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+    }
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+    {
+        const auto quote = vdupq_n_u8 ('"');
+        const auto slash = vdupq_n_u8 ('\\');
+        const auto control = vdupq_n_u8 (0x20);
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = vld1q_u8 (reinterpret_cast<const uint8_t *>(from_ + i));
+
+            auto hits = vorrq_u8 (
+                    vorrq_u8 (vceqq_u8 (v, quote), vceqq_u8 (v, slash)),
+                    vcltq_u8 (v, control));
+
+            // there's no movemask, leave finding which to the loop below
+            if (vmaxvq_u8 (hits)) {
+                break;
+            }
+        }
+    }
+#endif
+
+    for ( ; i < n_ ; ++i) {
+        if (escapable (from_[i])) {
+            return i;
+        }
+    }
+
+    return n_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+appendJsonString (std::string & to_, std::string_view value_) {
+    to_.reserve (to_.size() + value_.size() + 2);
+    to_.append (1, '"');
+
+    for (;;) {
+        auto run = jsonEscape (value_.data(), value_.size());
+
+        to_.append (value_.data(), run);
+
+        if (run == value_.size()) {
+            break;
+        }
+
+        auto c = static_cast<unsigned char>(value_[run]);
+
+        switch (c) {
+            case '"'  : to_.append ("\\\""); break;
+            case '\\' : to_.append ("\\\\"); break;
+            case '\b' : to_.append ("\\b"); break;
+            case '\f' : to_.append ("\\f"); break;
+            case '\n' : to_.append ("\\n"); break;
+            case '\r' : to_.append ("\\r"); break;
+            case '\t' : to_.append ("\\t"); break;
+            default :
+                to_.append ("\\u00")
+                   .append (1, HEX[c >> 4])
+                   .append (1, HEX[c & 0xf]);
+        }
+
+        value_.remove_prefix (run + 1);
+    }
+
+    to_.append (1, '"');
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::
+formatImplementation() {
+#if defined (__AVX2__)
+    return "avx2";
+#elif defined (__SSE2__)
+    return "sse2";
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/******************************************************************************/
@@ -0,0 +1,77 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <charconv>
+#include <iterator>
+#include <string_view>
+#include <type_traits>
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Room enough for any number we'll be asked to write
+     */
+    using NumberBuffer = char[32];
+
+    /**
+     * Write [value_] into [buffer_] with std::to_chars, the shortest form
+     * that reads back as the same value for floating point, booleans as
+     * 1 or 0.
+     *
+     * @return what was written
+     */
+    template<typename T>
+    inline std::string_view
+    toChars (NumberBuffer & buffer_, T value_) {
+        if constexpr (std::is_same_v<T, bool>) {
+            buffer_[0] = value_ ? '1' : '0';
+            return { buffer_, 1 };
+        } else {
+            auto [end, ec] = std::to_chars (std::begin (buffer_), std::end (buffer_), value_);
+
+            return { buffer_, static_cast<size_t>(end - buffer_) };
+        }
+    }
+
+    /**
+     * As [toChars] but straight onto the end of [to_], a std::string or
+     * std::pmr::string
+     */
+    template<class String, typename T>
+    inline void
+    appendNumber (String & to_, T value_) {
+        NumberBuffer buffer;
+
+        auto text = toChars (buffer, value_);
+        to_.append (text.data(), text.size());
+    }
+
+    /**
+     * @return the offset of the first character in [from_] JSON won't
+     * allow in a string unescaped, a quote, backslash or control
+     * character, or [n_] if there are none.
+     *
+     * Almost every string we write has nothing to escape so this is what
+     * writing one costs. It looks at 32 bytes at a time with AVX2, 16 with
+     * SSE2 or NEON on AArch64, and one at a time otherwise.
+     */
+    size_t jsonEscape (const char * from_, size_t n_);
+
+    /**
+     * Append [value_] to [to_] as a quoted and escaped JSON string
+     */
+    void appendJsonString (std::string & to_, std::string_view value_);
+
+    /**
+     * @return which [jsonEscape] we were built with
+     */
+    const char * formatImplementation();
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,106 @@
+#include "Hash.h"
+
+#include <cstring>
+
+/******************************************************************************/
+
+namespace {
+
+    const uint64_t PRIME1 = 11400714785074694791ULL;
+    const uint64_t PRIME2 = 14029467366897019727ULL;
+    const uint64_t PRIME3 =  1609587929392839161ULL;
+    const uint64_t PRIME4 =  9650029242287828579ULL;
+    const uint64_t PRIME5 =  2870177450012600261ULL;
+
+    uint64_t
+    rotl (uint64_t x_, int r_) {
+        return (x_ << r_) | (x_ >> (64 - r_));
+    }
+
+    uint64_t
+    read64 (const char * p_) {
+        uint64_t rtn;
+        std::memcpy (&rtn, p_, sizeof (rtn));
+        return rtn;
+    }
+
+    uint32_t
+    read32 (const char * p_) {
+        uint32_t rtn;
+        std::memcpy (&rtn, p_, sizeof (rtn));
+        return rtn;
+    }
+
+    uint64_t
+    round (uint64_t acc_, uint64_t input_) {
+        return rotl (acc_ + input_ * PRIME2, 31) * PRIME1;
+    }
+
+    uint64_t
+    merge (uint64_t acc_, uint64_t value_) {
+        return (acc_ ^ round (0, value_)) * PRIME1 + PRIME4;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * As the specification has it, reading the input as little endian which
+ * is all we build for
+ */
+uint64_t
+amqp::internal::
+xxh64 (std::string_view bytes_, uint64_t seed_) {
+    const char * p = bytes_.data();
+    const char * end = p + bytes_.size();
+
+    uint64_t h;
+
+    if (bytes_.size() >= 32) {
+        uint64_t v1 = seed_ + PRIME1 + PRIME2;
+        uint64_t v2 = seed_ + PRIME2;
+        uint64_t v3 = seed_;
+        uint64_t v4 = seed_ - PRIME1;
+
+        for ( ; end - p >= 32 ; p += 32) {
+            v1 = round (v1, read64 (p));
+            v2 = round (v2, read64 (p + 8));
+            v3 = round (v3, read64 (p + 16));
+            v4 = round (v4, read64 (p + 24));
+        }
+
+        h = rotl (v1, 1) + rotl (v2, 7) + rotl (v3, 12) + rotl (v4, 18);
+        h = merge (h, v1);
+        h = merge (h, v2);
+        h = merge (h, v3);
+        h = merge (h, v4);
+    } else {
+        h = seed_ + PRIME5;
+    }
+
+    h += bytes_.size();
+
+    for ( ; end - p >= 8 ; p += 8) {
+        h = rotl (h ^ round (0, read64 (p)), 27) * PRIME1 + PRIME4;
+    }
+
+    if (end - p >= 4) {
+        h = rotl (h ^ (read32 (p) * PRIME1), 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+
+    for ( ; p < end ; ++p) {
+        h = rotl (h ^ (static_cast<uint8_t>(*p) * PRIME5), 11) * PRIME1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/******************************************************************************/
@@ -0,0 +1,21 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * XXH64, for anything that needs the same hash of the same bytes
+     * whatever built it, unlike std::hash which is free to differ between
+     * standard libraries and their versions
+     */
+    uint64_t xxh64 (std::string_view bytes_, uint64_t seed_ = 0);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,296 @@
+#include "SchemaCache.h"
+
+#include <stdexcept>
+
+#include "proton/codec.h"
+
+#include "amqp/Hash.h"
+#include "amqp/Stats.h"
+
+#include "amqp/schema/descriptors/AMQPDescriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal;
+
+    template<class T>
+    uPtr<T>
+    parse (std::string_view encoded_) {
+        std::unique_ptr<pn_data_t, decltype(&pn_data_free)> data {
+            pn_data (0), pn_data_free
+        };
+
+        auto rtn = pn_data_decode (data.get(), encoded_.data(), encoded_.size());
+
+        if (rtn != static_cast<ssize_t>(encoded_.size())) {
+            throw std::runtime_error ("Failed to decode schema");
+        }
+
+        return schema::descriptors::dispatchDescribed<T> (data.get());
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::
+SchemaCache::Entry::Evolved::Evolved (
+    const Entry & entry_,
+    const sPtr<const Entry> & as_
+) : as (as_)
+  , evolution (as_->schema(), as_->transforms(), entry_.transforms())
+  , factory (evolution)
+{
+    Stats::Timer timer (Stats::readers_t);
+
+    factory.process (entry_.schema());
+}
+
+/******************************************************************************/
+
+amqp::internal::
+SchemaCache::Entry::Entry (
+    std::string_view bytes_,
+    std::string_view transformBytes_,
+    uPtr<schema::Schema> schema_,
+    uPtr<schema::TransformsSchema> transforms_
+) : m_bytes (bytes_)
+  , m_transformBytes (transformBytes_)
+  , m_fingerprint (SchemaCache::fingerprint (bytes_, transformBytes_))
+  , m_schema (std::move (schema_))
+  , m_transforms (transforms_
+        ? std::move (transforms_)
+        : std::make_unique<schema::TransformsSchema>())
+{
+    Stats::Timer timer (Stats::readers_t);
+
+    m_factory.process (*m_schema);
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::internal::
+SchemaCache::Entry::schema() const {
+    return *m_schema;
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::TransformsSchema &
+amqp::internal::
+SchemaCache::Entry::transforms() const {
+    return *m_transforms;
+}
+
+/******************************************************************************/
+
+/**
+ * Readers are all built by the constructor so this is only ever a lookup
+ */
+sPtr<amqp::internal::CompositeFactory::ReaderType>
+amqp::internal::
+SchemaCache::Entry::byDescriptor (const std::string & descriptor_) const {
+    return m_factory.byDescriptor (descriptor_);
+}
+
+/******************************************************************************/
+
+/**
+ * Building the readers the first time we're asked to read as [as_] is
+ * no more work than building our own were so we just hold the lock. As
+ * we're adding one anyway that's when any for entries that have since
+ * gone are dropped.
+ */
+sPtr<amqp::internal::CompositeFactory::ReaderType>
+amqp::internal::
+SchemaCache::Entry::byDescriptor (
+        const std::string & descriptor_,
+        const sPtr<const Entry> & as_
+) const {
+    if (!as_ || as_.get() == this) {
+        return byDescriptor (descriptor_);
+    }
+
+    Evolved * evolved;
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        auto & slot = m_evolved[as_->fingerprint()];
+
+        if (!slot || slot->as.lock() != as_) {
+            slot = std::make_unique<Evolved> (*this, as_);
+
+            for (auto it = m_evolved.begin() ; it != m_evolved.end() ;) {
+                if (it->second->as.expired()) {
+                    it = m_evolved.erase (it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        evolved = slot.get();
+    }
+
+    return evolved->factory.byDescriptor (descriptor_);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::Entry::evolutions() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    size_t rtn { 0 };
+
+    for (const auto & evolved : m_evolved) {
+        rtn += !evolved.second->as.expired();
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+SchemaCache::SchemaCache()
+    : m_hits (0)
+    , m_misses (0)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::SchemaCache &
+amqp::internal::
+SchemaCache::instance() {
+    static SchemaCache cache;
+
+    return cache;
+}
+
+/******************************************************************************/
+
+/**
+ * The schema is hashed and that hash seeds the transforms', so which bytes
+ * were in which section counts
+ */
+uint64_t
+amqp::internal::
+SchemaCache::fingerprint (
+        std::string_view encoded_,
+        std::string_view transforms_
+) {
+    return xxh64 (transforms_, xxh64 (encoded_, 0));
+}
+
+/******************************************************************************/
+
+/**
+ * We don't hold the lock whilst building a new entry, if two threads race
+ * on the same schema they'll both build it and the first one in wins.
+ */
+sPtr<const amqp::internal::SchemaCache::Entry>
+amqp::internal::
+SchemaCache::get (
+        std::string_view encoded_,
+        std::string_view transforms_
+) {
+    auto hash = fingerprint (encoded_, transforms_);
+
+    auto matches = [encoded_, transforms_](const Entry & entry_) {
+        return entry_.bytes() == encoded_
+            && entry_.transformBytes() == transforms_;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+
+        auto it = m_entries.find (hash);
+
+        if (it != m_entries.end() && matches (*it->second)) {
+            ++m_hits;
+
+            if (auto * stats = Stats::current()) {
+                ++stats->hits;
+            }
+
+            return it->second;
+        }
+
+        ++m_misses;
+    }
+
+    if (auto * stats = Stats::current()) {
+        ++stats->misses;
+    }
+
+    auto entry = std::make_shared<const Entry> (
+            encoded_,
+            transforms_,
+            parse<schema::Schema> (encoded_),
+            transforms_.empty()
+                ? nullptr
+                : parse<schema::TransformsSchema> (transforms_));
+
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    // on a genuine collision the newer schema replaces the older
+    auto & slot = m_entries[hash];
+
+    if (!slot || !matches (*slot)) {
+        slot = entry;
+    }
+
+    return slot;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+SchemaCache::clear() {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    m_entries.clear();
+    m_hits = m_misses = 0;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::size() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_entries.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::hits() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_hits;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::misses() const {
+    std::lock_guard<std::mutex> lock (m_mutex);
+
+    return m_misses;
+}
+
+/******************************************************************************/
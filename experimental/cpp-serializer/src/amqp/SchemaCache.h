@@ -0,0 +1,160 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "amqp/Evolution.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::SchemaCache
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Blobs pulled from the same vault overwhelmingly share a small number
+     * of schemas, so rather than parse the schema and build the reader graph
+     * for every blob we keep them around, keyed by a hash of the raw schema
+     * section.
+     *
+     * Entries are immutable once built and handed out as shared pointers so
+     * they can be used from several threads at once.
+     *
+     * Each entry also keeps the readers for reading its blobs as any other
+     * entry's types, built the first time they're asked for, so blobs
+     * written by an older or newer version of a CorDapp cost no more to
+     * read than anything else once the first has been seen.
+     */
+    class SchemaCache {
+        public :
+            class Entry {
+                private :
+                    struct Evolved {
+                        /**
+                         * Only watched, an entry owning another could
+                         * end up owning itself through it. Once it's gone
+                         * nothing can ask to read as it, the evolution's
+                         * pointers into its schema are never used again
+                         * and we're replaced should a new entry with the
+                         * same fingerprint turn up.
+                         */
+                        std::weak_ptr<const Entry> as;
+                        Evolution                  evolution;
+                        CompositeFactory           factory;
+
+                        Evolved (const Entry &, const sPtr<const Entry> &);
+                    };
+
+                    /**
+                     * The encoded schema and transforms sections, kept
+                     * to rule out hash collisions
+                     */
+                    std::string                     m_bytes;
+                    std::string                     m_transformBytes;
+                    uint64_t                        m_fingerprint;
+                    uPtr<schema::Schema>            m_schema;
+                    uPtr<schema::TransformsSchema>  m_transforms;
+                    mutable CompositeFactory        m_factory;
+
+                    mutable std::mutex m_mutex;
+                    /**
+                     * By the fingerprint of the entry read as
+                     */
+                    mutable std::unordered_map<uint64_t, uPtr<Evolved>> m_evolved;
+
+                public :
+                    Entry (
+                        std::string_view,
+                        std::string_view,
+                        uPtr<schema::Schema>,
+                        uPtr<schema::TransformsSchema>);
+
+                    const std::string & bytes() const { return m_bytes; }
+
+                    const std::string & transformBytes() const {
+                        return m_transformBytes;
+                    }
+
+                    uint64_t fingerprint() const { return m_fingerprint; }
+
+                    const schema::Schema & schema() const;
+
+                    const schema::TransformsSchema & transforms() const;
+
+                    sPtr<CompositeFactory::ReaderType> byDescriptor (
+                            const std::string &) const;
+
+                    /**
+                     * A reader for values written with our types that
+                     * reports them as [as_] has them
+                     */
+                    sPtr<CompositeFactory::ReaderType> byDescriptor (
+                            const std::string &,
+                            const sPtr<const Entry> & as_) const;
+
+                    /**
+                     * @return how many other entries, still around, we've
+                     * built readers to read as
+                     */
+                    size_t evolutions() const;
+            };
+
+        private :
+            mutable std::mutex m_mutex;
+
+            std::unordered_map<uint64_t, sPtr<const Entry>> m_entries;
+
+            size_t m_hits;
+            size_t m_misses;
+
+        public :
+            SchemaCache();
+
+            /**
+             * The process wide cache
+             */
+            static SchemaCache & instance();
+
+            /**
+             * @param encoded_ the complete AMQP encoding of a described
+             * Schema, as it appears in an Envelope
+             * @param transforms_ likewise the TransformsSchema that follows
+             * it, if there is one
+             */
+            sPtr<const Entry> get (
+                std::string_view encoded_,
+                std::string_view transforms_ = { });
+
+            /**
+             * What a schema and its transforms are keyed on, XXH64 so the
+             * same bytes give the same fingerprint on any build and in
+             * any process
+             */
+            static uint64_t fingerprint (
+                std::string_view encoded_,
+                std::string_view transforms_ = { });
+
+            void clear();
+
+            size_t size() const;
+            size_t hits() const;
+            size_t misses() const;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,54 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+/******************************************************************************
+ *
+ * amqp::internal::Span
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A view of a contiguous run of T that someone else owns, what
+     * std::span will be once we can use C++20
+     */
+    template<typename T>
+    class Span {
+        private :
+            T *    m_data;
+            size_t m_size;
+
+        public :
+            constexpr Span() : m_data (nullptr), m_size (0) { }
+
+            constexpr Span (T * data_, size_t size_)
+                : m_data (data_)
+                , m_size (size_)
+            { }
+
+            /**
+             * Anything with data() and size(), a vector say
+             */
+            template<class Container>
+            constexpr Span (Container & container_)
+                : m_data (container_.data())
+                , m_size (container_.size())
+            { }
+
+            constexpr T * data() const { return m_data; }
+            constexpr size_t size() const { return m_size; }
+            constexpr bool empty() const { return m_size == 0; }
+
+            constexpr T * begin() const { return m_data; }
+            constexpr T * end() const { return m_data + m_size; }
+
+            constexpr T & operator [] (size_t i_) const { return m_data[i_]; }
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,211 @@
+#include "Stats.h"
+
+#include <sstream>
+#include <iomanip>
+
+/******************************************************************************/
+
+namespace {
+
+    struct Collecting {
+        amqp::internal::Stats *        stats;
+        amqp::internal::Stats::Timer * timer;
+        uint64_t                       allocations;
+    };
+
+    thread_local Collecting collecting { nullptr, nullptr, 0 };
+
+    /**
+     * Set during static initialisation, if at all, so never raced on
+     */
+    bool counting { false };
+
+}
+
+/******************************************************************************
+ *
+ * class Stats::Scope
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Stats::Scope::Scope (Stats & stats_)
+    : m_stats (stats_)
+    , m_previous (collecting.stats)
+    , m_allocations (collecting.allocations)
+{
+    collecting.stats = &m_stats;
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Stats::Scope::~Scope() {
+    m_stats.allocations += collecting.allocations - m_allocations;
+    collecting.stats = m_previous;
+}
+
+/******************************************************************************
+ *
+ * class Stats::Timer
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Stats::Timer::Timer (Stage stage_)
+    : m_stats (collecting.stats)
+    , m_stage (stage_)
+    , m_outer (nullptr)
+    , m_inner (0)
+{
+    if (m_stats) {
+        m_outer = collecting.timer;
+        collecting.timer = this;
+        m_start = std::chrono::steady_clock::now();
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::
+Stats::Timer::~Timer() {
+    if (!m_stats) {
+        return;
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - m_start;
+
+    m_stats->time[m_stage] += elapsed - m_inner;
+
+    if (m_outer) {
+        m_outer->m_inner += elapsed;
+    }
+
+    collecting.timer = m_outer;
+}
+
+/******************************************************************************
+ *
+ * class Stats
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Stats::Stats()
+    : time { }
+    , blobs (0)
+    , bytes (0)
+    , types (0)
+    , values (0)
+    , nodes (0)
+    , allocations (0)
+    , hits (0)
+    , misses (0)
+{
+}
+
+/******************************************************************************/
+
+amqp::internal::Stats &
+amqp::internal::
+Stats::operator += (const Stats & other_) {
+    for (size_t i { 0 } ; i < STAGES ; ++i) {
+        time[i] += other_.time[i];
+    }
+
+    blobs += other_.blobs;
+    bytes += other_.bytes;
+    types += other_.types;
+    values += other_.values;
+    nodes += other_.nodes;
+    allocations += other_.allocations;
+    hits += other_.hits;
+    misses += other_.misses;
+
+    return *this;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::
+Stats::summary() const {
+    std::stringstream ss;
+
+    ss << "blobs " << blobs
+       << ", bytes " << bytes
+       << ", types " << types
+       << ", values " << values
+       << ", nodes " << nodes;
+
+    if (counting) {
+        ss << ", allocations " << allocations;
+    }
+
+    ss << ", schema hits " << hits
+       << ", misses " << misses
+       << " |" << std::fixed << std::setprecision (3);
+
+    std::chrono::nanoseconds total { 0 };
+
+    for (size_t i { 0 } ; i < STAGES ; ++i) {
+        ss << " " << stageName (static_cast<Stage>(i)) << " "
+           << time[i].count() / 1e6 << "ms,";
+
+        total += time[i];
+    }
+
+    ss << " total " << total.count() / 1e6 << "ms";
+
+    return ss.str();
+}
+
+/******************************************************************************/
+
+amqp::internal::Stats *
+amqp::internal::
+Stats::current() {
+    return collecting.stats;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Stats::allocated() {
+    ++collecting.allocations;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+Stats::countingAllocations() {
+    counting = true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::
+Stats::allocationsCounted() {
+    return counting;
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::
+Stats::stageName (Stage stage_) {
+    switch (stage_) {
+        case read_t     : return "read";
+        case envelope_t : return "envelope";
+        case schema_t   : return "schema";
+        case readers_t  : return "readers";
+        case render_t   : return "render";
+    }
+
+    return "unknown";
+}
+
+/******************************************************************************/
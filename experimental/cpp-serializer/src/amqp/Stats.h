@@ -0,0 +1,148 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <cstdint>
+
+/******************************************************************************
+ *
+ * amqp::internal::Stats
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Where the time reading blobs goes, stage by stage, and how much of
+     * each thing there was.
+     *
+     * Collecting is per thread, a [Scope] makes a Stats the one its thread
+     * records into until it goes. The stages time themselves with a
+     * [Timer] wherever they are, which comes down to a thread local read
+     * when nothing's collecting and a pair of clock reads when something
+     * is, cheap enough to leave on.
+     *
+     * Timers nest, each stage is charged only for the time not spent in
+     * the stages inside it.
+     */
+    class Stats {
+        public :
+            enum Stage {
+                /**
+                 * Opening, and for anything we can't map reading, the file
+                 */
+                read_t,
+
+                /**
+                 * Finding our way through the envelope to the payload
+                 */
+                envelope_t,
+
+                /**
+                 * Looking the schema up and, when it's new, decoding it
+                 * and sorting its types
+                 */
+                schema_t,
+
+                /**
+                 * Building the readers for a new schema
+                 */
+                readers_t,
+
+                /**
+                 * Reading the payload and writing out what it holds
+                 */
+                render_t
+            };
+
+            static constexpr size_t STAGES = render_t + 1;
+
+            /**
+             * Collects into a Stats whilst it's in scope, counting the
+             * allocations made by its thread meanwhile
+             */
+            class Scope {
+                private :
+                    Stats &  m_stats;
+                    Stats *  m_previous;
+                    uint64_t m_allocations;
+
+                public :
+                    explicit Scope (Stats &);
+                    Scope (const Scope &) = delete;
+                    ~Scope();
+            };
+
+            class Timer {
+                private :
+                    Stats * m_stats;
+                    Stage   m_stage;
+                    Timer * m_outer;
+
+                    std::chrono::steady_clock::time_point m_start;
+
+                    /**
+                     * Spent in the timers inside us
+                     */
+                    std::chrono::nanoseconds m_inner;
+
+                public :
+                    explicit Timer (Stage);
+                    Timer (const Timer &) = delete;
+                    ~Timer();
+            };
+
+            std::array<std::chrono::nanoseconds, STAGES> time;
+
+            uint64_t blobs;
+            uint64_t bytes;
+            uint64_t types;
+            uint64_t values;
+
+            /**
+             * The values plus every composite, list and map holding them
+             */
+            uint64_t nodes;
+
+            uint64_t allocations;
+
+            uint64_t hits;
+            uint64_t misses;
+
+            Stats();
+
+            Stats & operator += (const Stats &);
+
+            /**
+             * On one line, the counts and then the time in each stage
+             */
+            std::string summary() const;
+
+            /**
+             * What the calling thread is collecting into, null if nothing
+             */
+            static Stats * current();
+
+            /**
+             * Allocations are only counted where something calls this for
+             * each one, a replacement operator new say
+             */
+            static void allocated();
+
+            /**
+             * Whatever calls [allocated] says so once, before anything is
+             * collected. Until it has [summary] leaves allocations out
+             * rather than report there being none.
+             */
+            static void countingAllocations();
+            static bool allocationsCounted();
+
+            static const char * stageName (Stage);
+    };
+
+}
+
+/******************************************************************************/
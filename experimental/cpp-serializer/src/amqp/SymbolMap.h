@@ -0,0 +1,167 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "Symbols.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::SymbolMap
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A flat, open addressed, hash map keyed on interned symbols.
+     *
+     * Entries live contiguously in the order they were inserted with a
+     * separate linearly probed index over them, so finding something is a
+     * multiply to hash the symbol and, almost always, a single integer
+     * compare. Nothing is ever erased, these are built once from a schema
+     * and then only read.
+     */
+    template<class V>
+    class SymbolMap {
+        public :
+            using mapped_type    = V;
+            using value_type     = std::pair<Symbol, V>;
+            using iterator       = typename std::vector<value_type>::iterator;
+            using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        private :
+            std::vector<value_type> m_entries;
+
+            /**
+             * Each slot being an index into m_entries plus one so zero can
+             * mean empty
+             */
+            std::vector<uint32_t> m_slots;
+
+            size_t slot (Symbol) const;
+
+            void grow();
+
+        public :
+            SymbolMap() : m_slots (16, 0) { }
+
+            iterator find (Symbol);
+            const_iterator find (Symbol) const;
+
+            template<class... Args>
+            std::pair<iterator, bool> emplace (Symbol, Args && ...);
+
+            V & operator [] (Symbol key_) {
+                return emplace (key_).first->second;
+            }
+
+            size_t size() const { return m_entries.size(); }
+            bool empty() const { return m_entries.empty(); }
+
+            iterator begin() { return m_entries.begin(); }
+            iterator end() { return m_entries.end(); }
+
+            const_iterator begin() const { return m_entries.cbegin(); }
+            const_iterator end() const { return m_entries.cend(); }
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Symbols are handed out sequentially so Fibonacci hashing them spreads
+ * neighbours across the table, and we take the top bits since those are
+ * the well mixed ones.
+ *
+ * @return the index of either the slot holding [key_] or the empty slot
+ * it would go in
+ */
+template<class V>
+size_t
+amqp::internal::
+SymbolMap<V>::slot (Symbol key_) const {
+    const size_t mask = m_slots.size() - 1;
+
+    size_t i = ((key_.id() * UINT64_C (0x9E3779B97F4A7C15)) >> 32) & mask;
+
+    while (m_slots[i] && m_entries[m_slots[i] - 1].first != key_) {
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+/******************************************************************************/
+
+template<class V>
+void
+amqp::internal::
+SymbolMap<V>::grow() {
+    m_slots.assign (m_slots.size() * 2, 0);
+
+    for (size_t i { 0 } ; i < m_entries.size() ; ++i) {
+        m_slots[slot (m_entries[i].first)] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+/******************************************************************************/
+
+template<class V>
+typename amqp::internal::SymbolMap<V>::iterator
+amqp::internal::
+SymbolMap<V>::find (Symbol key_) {
+    auto i = m_slots[slot (key_)];
+
+    return i ? m_entries.begin() + (i - 1) : m_entries.end();
+}
+
+/******************************************************************************/
+
+template<class V>
+typename amqp::internal::SymbolMap<V>::const_iterator
+amqp::internal::
+SymbolMap<V>::find (Symbol key_) const {
+    auto i = m_slots[slot (key_)];
+
+    return i ? m_entries.cbegin() + (i - 1) : m_entries.cend();
+}
+
+/******************************************************************************/
+
+/**
+ * Like std::map::emplace, if [key_] is already present nothing is
+ * constructed and we hand back what's there.
+ */
+template<class V>
+template<class... Args>
+std::pair<typename amqp::internal::SymbolMap<V>::iterator, bool>
+amqp::internal::
+SymbolMap<V>::emplace (Symbol key_, Args && ... args_) {
+    auto i = slot (key_);
+
+    if (m_slots[i]) {
+        return { m_entries.begin() + (m_slots[i] - 1), false };
+    }
+
+    m_entries.emplace_back (
+            std::piecewise_construct,
+            std::forward_as_tuple (key_),
+            std::forward_as_tuple (std::forward<Args> (args_)...));
+
+    // keep the index at most half full
+    if (m_entries.size() * 2 > m_slots.size()) {
+        grow();
+    } else {
+        m_slots[i] = static_cast<uint32_t>(m_entries.size());
+    }
+
+    return { m_entries.end() - 1, true };
+}
+
+/******************************************************************************/
@@ -0,0 +1,166 @@
+#include "Symbols.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <functional>
+
+/******************************************************************************
+ *
+ * amqp::internal::Symbol
+ *
+ ******************************************************************************/
+
+const std::string &
+amqp::internal::
+Symbol::str() const {
+    return Symbols::instance().str (*this);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Symbols
+ *
+ ******************************************************************************/
+
+amqp::internal::
+Symbols::Symbols() : m_slots (64, 0) {
+}
+
+/******************************************************************************/
+
+amqp::internal::Symbols &
+amqp::internal::
+Symbols::instance() {
+    static Symbols symbols;
+
+    return symbols;
+}
+
+/******************************************************************************/
+
+/**
+ * Callers need to hold the lock
+ */
+amqp::internal::Symbol
+amqp::internal::
+Symbols::find (std::string_view name_, size_t hash_) const {
+    const size_t mask = m_slots.size() - 1;
+
+    for (size_t i { hash_ & mask } ; m_slots[i] ; i = (i + 1) & mask) {
+        auto id = m_slots[i] - 1;
+
+        if (m_hashes[id] == hash_ && m_names[id] == name_) {
+            return Symbol (id);
+        }
+    }
+
+    return Symbol();
+}
+
+/******************************************************************************/
+
+/**
+ * Callers need to hold the lock exclusively
+ */
+void
+amqp::internal::
+Symbols::grow() {
+    std::vector<uint32_t> slots (m_slots.size() * 2, 0);
+
+    const size_t mask = slots.size() - 1;
+
+    for (size_t id { 0 } ; id < m_names.size() ; ++id) {
+        size_t i { m_hashes[id] & mask };
+
+        while (slots[i]) {
+            i = (i + 1) & mask;
+        }
+
+        slots[i] = static_cast<uint32_t>(id + 1);
+    }
+
+    m_slots = std::move (slots);
+}
+
+/******************************************************************************/
+
+amqp::internal::Symbol
+amqp::internal::
+Symbols::intern (std::string_view name_) {
+    auto hash = std::hash<std::string_view>{}(name_);
+
+    {
+        std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+        if (auto symbol = find (name_, hash); symbol.valid()) {
+            return symbol;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock (m_mutex);
+
+    // someone may have beaten us to it whilst we weren't holding the lock
+    if (auto symbol = find (name_, hash); symbol.valid()) {
+        return symbol;
+    }
+
+    // keep the table at most half full so probe runs stay short
+    if ((m_names.size() + 1) * 2 > m_slots.size()) {
+        grow();
+    }
+
+    Symbol symbol (static_cast<uint32_t>(m_names.size()));
+
+    m_names.emplace_back (name_);
+    m_hashes.push_back (hash);
+
+    const size_t mask = m_slots.size() - 1;
+    size_t i { hash & mask };
+
+    while (m_slots[i]) {
+        i = (i + 1) & mask;
+    }
+
+    m_slots[i] = symbol.id() + 1;
+
+    return symbol;
+}
+
+/******************************************************************************/
+
+amqp::internal::Symbol
+amqp::internal::
+Symbols::find (std::string_view name_) const {
+    auto hash = std::hash<std::string_view>{}(name_);
+
+    std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+    return find (name_, hash);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::
+Symbols::str (Symbol symbol_) const {
+    std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+    if (!symbol_.valid() || symbol_.id() >= m_names.size()) {
+        throw std::out_of_range (
+                "Unknown symbol " + std::to_string (symbol_.id()));
+    }
+
+    return m_names[symbol_.id()];
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+Symbols::size() const {
+    std::shared_lock<std::shared_mutex> lock (m_mutex);
+
+    return m_names.size();
+}
+
+/******************************************************************************/
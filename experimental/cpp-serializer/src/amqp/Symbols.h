@@ -0,0 +1,126 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <deque>
+#include <limits>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <shared_mutex>
+
+/******************************************************************************
+ *
+ * amqp::internal::Symbol
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * An interned type name or descriptor. Two symbols are equal if and only
+     * if the strings they were interned from are, so once we have one
+     * comparing it is a single integer compare rather than walking what are
+     * generally very long Java class names.
+     */
+    class Symbol {
+        private :
+            static constexpr uint32_t npos = std::numeric_limits<uint32_t>::max();
+
+            uint32_t m_id;
+
+        public :
+            constexpr Symbol() : m_id (npos) { }
+
+            explicit constexpr Symbol (uint32_t id_) : m_id (id_) { }
+
+            constexpr uint32_t id() const { return m_id; }
+
+            /**
+             * A default constructed symbol is what looking up a string
+             * that has never been interned gives back
+             */
+            constexpr bool valid() const { return m_id != npos; }
+
+            const std::string & str() const;
+
+            constexpr bool operator == (const Symbol & rhs_) const {
+                return m_id == rhs_.m_id;
+            }
+
+            constexpr bool operator != (const Symbol & rhs_) const {
+                return m_id != rhs_.m_id;
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::Symbols
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * The process wide intern table. Names are only ever added, whilst a
+     * schema is being parsed, so a symbol stays valid for the life of the
+     * process and can be shared between every schema and reader that uses
+     * the same type.
+     */
+    class Symbols {
+        private :
+            mutable std::shared_mutex m_mutex;
+
+            /**
+             * Indexed by symbol, a deque so growing never moves a name
+             * someone holds a reference to
+             */
+            std::deque<std::string> m_names;
+            std::vector<size_t>     m_hashes;
+
+            /**
+             * Open addressed, linearly probed, each slot being a symbol
+             * plus one so zero can mean empty
+             */
+            std::vector<uint32_t>   m_slots;
+
+            Symbol find (std::string_view, size_t) const;
+
+            void grow();
+
+        public :
+            Symbols();
+
+            static Symbols & instance();
+
+            Symbol intern (std::string_view);
+
+            /**
+             * Never adds, anything not already interned gives back an
+             * invalid symbol
+             */
+            Symbol find (std::string_view) const;
+
+            const std::string & str (Symbol) const;
+
+            size_t size() const;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal {
+
+    inline
+    Symbol
+    intern (std::string_view name_) {
+        return Symbols::instance().intern (name_);
+    }
+
+}
+
+/******************************************************************************/
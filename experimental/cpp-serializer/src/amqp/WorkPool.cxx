@@ -0,0 +1,213 @@
+#include "WorkPool.h"
+
+/******************************************************************************/
+
+/**
+ * What's left of a call to [run]
+ */
+struct amqp::internal::WorkPool::Batch {
+    std::mutex              mutex;
+    std::condition_variable done;
+    size_t                  remaining;
+    std::exception_ptr      error;
+};
+
+/******************************************************************************/
+
+namespace {
+
+    std::unique_ptr<amqp::internal::WorkPool> & pool() {
+        static std::unique_ptr<amqp::internal::WorkPool> pool;
+
+        return pool;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::WorkPool
+ *
+ ******************************************************************************/
+
+amqp::internal::
+WorkPool::WorkPool (size_t threads_, size_t grain_)
+    : m_grain (grain_ ? grain_ : 1)
+    , m_pending (0)
+    , m_next (0)
+    , m_stop (false)
+{
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_queues.emplace_back (std::make_unique<Queue>());
+    }
+
+    for (size_t i { 0 } ; i < threads_ ; ++i) {
+        m_workers.emplace_back (&WorkPool::work, this, i);
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::
+WorkPool::~WorkPool() {
+    {
+        std::lock_guard<std::mutex> lock (m_mutex);
+        m_stop = true;
+    }
+
+    m_wake.notify_all();
+
+    for (auto & worker : m_workers) {
+        worker.join();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkPool::configure (size_t threads_, size_t grain_) {
+    pool() = threads_ ? std::make_unique<WorkPool> (threads_, grain_) : nullptr;
+}
+
+/******************************************************************************/
+
+amqp::internal::WorkPool *
+amqp::internal::
+WorkPool::instance() {
+    return pool().get();
+}
+
+/******************************************************************************/
+
+/**
+ * Our own queue first, newest first since that's what's most likely still
+ * in cache, then the oldest task from anyone else's
+ */
+bool
+amqp::internal::
+WorkPool::steal (size_t own_, Task & task_) {
+    for (size_t i { 0 } ; i < m_queues.size() ; ++i) {
+        auto & queue = *m_queues[(own_ + i) % m_queues.size()];
+
+        std::lock_guard<std::mutex> lock (queue.mutex);
+
+        if (queue.tasks.empty()) {
+            continue;
+        }
+
+        if (i == 0) {
+            task_ = std::move (queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task_ = std::move (queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        --m_pending;
+
+        return true;
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkPool::execute (Task & task_) {
+    try {
+        task_.work();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock (task_.batch->mutex);
+
+        if (!task_.batch->error) {
+            task_.batch->error = std::current_exception();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock (task_.batch->mutex);
+
+    if (!--task_.batch->remaining) {
+        task_.batch->done.notify_all();
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkPool::work (size_t id_) {
+    Task task;
+
+    while (true) {
+        if (steal (id_, task)) {
+            execute (task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock (m_mutex);
+
+        m_wake.wait (lock, [this] { return m_stop || m_pending > 0; });
+
+        if (m_stop) {
+            return;
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkPool::run (std::vector<std::function<void()>> tasks_) {
+    Batch batch;
+    batch.remaining = tasks_.size();
+
+    if (!batch.remaining) {
+        return;
+    }
+
+    // spread them out, starting somewhere different each time so
+    // concurrent batches don't all pile onto the first queue
+    auto first = m_next.fetch_add (1);
+
+    for (size_t i { 0 } ; i < tasks_.size() ; ++i) {
+        auto & queue = *m_queues[(first + i) % m_queues.size()];
+
+        std::lock_guard<std::mutex> lock (queue.mutex);
+        queue.tasks.push_back (Task { std::move (tasks_[i]), &batch });
+        ++m_pending;
+    }
+
+    {
+        // taking the lock means no worker can be between deciding to
+        // sleep and actually sleeping when we wake them
+        std::lock_guard<std::mutex> lock (m_mutex);
+    }
+
+    m_wake.notify_all();
+
+    // rather than sit idle, help out, possibly with someone else's batch
+    Task task;
+    while (steal (first, task)) {
+        execute (task);
+
+        std::lock_guard<std::mutex> lock (batch.mutex);
+
+        if (!batch.remaining) {
+            break;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock (batch.mutex);
+
+    batch.done.wait (lock, [&batch] { return batch.remaining == 0; });
+
+    if (batch.error) {
+        std::rethrow_exception (batch.error);
+    }
+}
+
+/******************************************************************************/
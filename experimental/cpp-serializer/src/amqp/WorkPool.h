@@ -0,0 +1,104 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+/******************************************************************************
+ *
+ * amqp::internal::WorkPool
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A small work stealing thread pool for splitting up the decode of a
+     * single large value.
+     *
+     * Each worker has a queue of its own which it works through from the
+     * back, when that runs dry it steals from the front of everyone else's.
+     * Whoever hands over a batch of tasks steals alongside the workers until
+     * the batch is done, so a batch always makes progress even when every
+     * worker is busy with something else.
+     *
+     * There's no pool unless one is [configure]d, decoding stays entirely
+     * on the calling thread by default.
+     */
+    class WorkPool {
+        private :
+            struct Batch;
+
+            struct Task {
+                std::function<void()> work;
+                Batch *               batch;
+            };
+
+            struct Queue {
+                std::mutex       mutex;
+                std::deque<Task> tasks;
+            };
+
+            std::vector<std::unique_ptr<Queue>> m_queues;
+            std::vector<std::thread>            m_workers;
+
+            /**
+             * The fewest elements of a container worth handing to a thread
+             * of their own
+             */
+            size_t m_grain;
+
+            std::mutex              m_mutex;
+            std::condition_variable m_wake;
+
+            /**
+             * Tasks queued but not yet picked up, lets idle workers sleep
+             */
+            std::atomic<size_t> m_pending;
+            std::atomic<size_t> m_next;
+
+            bool m_stop;
+
+            bool steal (size_t, Task &);
+            void work (size_t);
+            static void execute (Task &);
+
+        public :
+            explicit WorkPool (size_t threads_, size_t grain_ = 256);
+            ~WorkPool();
+
+            WorkPool (const WorkPool &) = delete;
+            WorkPool & operator = (const WorkPool &) = delete;
+
+            /**
+             * Set up the process wide pool, zero threads meaning none
+             */
+            static void configure (size_t threads_, size_t grain_ = 256);
+
+            /**
+             * @return the process wide pool, nullptr if there isn't one
+             */
+            static WorkPool * instance();
+
+            size_t threads() const { return m_workers.size(); }
+            size_t grain() const { return m_grain; }
+
+            /**
+             * Run every task and return once they've all finished. If any of
+             * them threw the first exception is rethrown, after the rest
+             * have finished.
+             */
+            void run (std::vector<std::function<void()>> tasks_);
+    };
+
+}
+
+/******************************************************************************/
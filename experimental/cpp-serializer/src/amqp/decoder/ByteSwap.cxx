@@ -0,0 +1,178 @@
+#include "ByteSwap.h"
+
+#include <cstring>
+
+#if defined (__AVX2__)
+#   include <immintrin.h>
+#elif defined (__SSSE3__)
+#   include <tmmintrin.h>
+#elif defined (__SSE2__)
+#   include <emmintrin.h>
+#elif defined (__ARM_NEON)
+#   include <arm_neon.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    constexpr bool bigEndianHost = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+
+    inline uint16_t swap (uint16_t value_) { return __builtin_bswap16 (value_); }
+    inline uint32_t swap (uint32_t value_) { return __builtin_bswap32 (value_); }
+    inline uint64_t swap (uint64_t value_) { return __builtin_bswap64 (value_); }
+
+    template<typename T>
+    void
+    scalar (const uint8_t * from_, uint8_t * to_, size_t n_) {
+        for (size_t i { 0 } ; i < n_ ; ++i) {
+            T value;
+
+            std::memcpy (&value, from_ + i * sizeof (T), sizeof (T));
+            value = swap (value);
+            std::memcpy (to_ + i * sizeof (T), &value, sizeof (T));
+        }
+    }
+
+#if defined (__AVX2__) || defined (__SSSE3__)
+
+    /**
+     * The byte order that reverses each [W] byte lane of 16
+     */
+    template<size_t W>
+    __m128i
+    reverse() {
+        alignas (16) int8_t order[16];
+
+        for (size_t i { 0 } ; i < 16 ; ++i) {
+            order[i] = static_cast<int8_t>((i / W) * W + (W - 1 - i % W));
+        }
+
+        return _mm_load_si128 (reinterpret_cast<const __m128i *>(order));
+    }
+
+#endif
+
+    /**
+     * @return how many bytes were dealt with, always whole vectors
+     */
+    template<size_t W>
+    size_t
+    vectors (const uint8_t * from_, uint8_t * to_, size_t bytes_) {
+        size_t i { 0 };
+
+#if defined (__AVX2__)
+        const auto order = _mm256_broadcastsi128_si256 (reverse<W>());
+
+        for ( ; i + 32 <= bytes_ ; i += 32) {
+            auto v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(from_ + i));
+            _mm256_storeu_si256 (
+                    reinterpret_cast<__m256i *>(to_ + i),
+                    _mm256_shuffle_epi8 (v, order));
+        }
+#elif defined (__SSSE3__)
+        const auto order = reverse<W>();
+
+        for ( ; i + 16 <= bytes_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i));
+            _mm_storeu_si128 (
+                    reinterpret_cast<__m128i *>(to_ + i),
+                    _mm_shuffle_epi8 (v, order));
+        }
+#elif defined (__SSE2__)
+        // no byte shuffle so swap the bytes of each 16 bit word and then,
+        // for the wider types, the order of the words
+        for ( ; i + 16 <= bytes_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(from_ + i));
+
+            v = _mm_or_si128 (_mm_slli_epi16 (v, 8), _mm_srli_epi16 (v, 8));
+
+            if (W == 4) {
+                v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+                v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (2, 3, 0, 1));
+            } else if (W == 8) {
+                v = _mm_shufflelo_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+                v = _mm_shufflehi_epi16 (v, _MM_SHUFFLE (0, 1, 2, 3));
+            }
+
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(to_ + i), v);
+        }
+#elif defined (__ARM_NEON)
+        for ( ; i + 16 <= bytes_ ; i += 16) {
+            auto v = vld1q_u8 (from_ + i);
+
+            if (W == 2) {
+                v = vrev16q_u8 (v);
+            } else if (W == 4) {
+                v = vrev32q_u8 (v);
+            } else {
+                v = vrev64q_u8 (v);
+            }
+
+            vst1q_u8 (to_ + i, v);
+        }
+#endif
+
+        return i;
+    }
+
+    template<typename T>
+    void
+    fromBigEndian (const uint8_t * from_, void * to_, size_t n_) {
+        auto * to = static_cast<uint8_t *>(to_);
+
+        if (bigEndianHost) {
+            std::memcpy (to, from_, n_ * sizeof (T));
+            return;
+        }
+
+        auto done = vectors<sizeof (T)> (from_, to, n_ * sizeof (T));
+
+        scalar<T> (from_ + done, to + done, n_ - done / sizeof (T));
+    }
+
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+fromBigEndian16 (const uint8_t * from_, void * to_, size_t n_) {
+    fromBigEndian<uint16_t> (from_, to_, n_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+fromBigEndian32 (const uint8_t * from_, void * to_, size_t n_) {
+    fromBigEndian<uint32_t> (from_, to_, n_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+fromBigEndian64 (const uint8_t * from_, void * to_, size_t n_) {
+    fromBigEndian<uint64_t> (from_, to_, n_);
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::decoder::
+byteSwapImplementation() {
+#if defined (__AVX2__)
+    return "avx2";
+#elif defined (__SSSE3__)
+    return "ssse3";
+#elif defined (__SSE2__)
+    return "sse2";
+#elif defined (__ARM_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/******************************************************************************/
@@ -0,0 +1,32 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * Copy [n_] big endian values, of 2, 4 or 8 bytes each, out of [from_]
+     * into [to_] in host byte order. Neither needs to be aligned.
+     *
+     * AMQP is big endian throughout so on anything we're likely to run on
+     * this is a byte swap. It's done a vector at a time where the target
+     * allows, AVX2, SSSE3 or plain SSE2 on x86 and NEON on ARM, and with a
+     * scalar loop otherwise and for whatever's left over.
+     */
+    void fromBigEndian16 (const uint8_t * from_, void * to_, size_t n_);
+    void fromBigEndian32 (const uint8_t * from_, void * to_, size_t n_);
+    void fromBigEndian64 (const uint8_t * from_, void * to_, size_t n_);
+
+    /**
+     * @return which of the above we were built with
+     */
+    const char * byteSwapImplementation();
+
+}
+
+/******************************************************************************/
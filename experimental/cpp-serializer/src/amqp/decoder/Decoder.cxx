@@ -0,0 +1,1343 @@
+#include "Decoder.h"
+#include "ByteSwap.h"
+
+#include <cstring>
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * AMQP 1.0 format codes, see part 1.6 of the specification
+ *
+ ******************************************************************************/
+
+namespace {
+
+    const uint8_t DESCRIBED  = 0x00;
+
+    const uint8_t NULL_      = 0x40;
+    const uint8_t TRUE_      = 0x41;
+    const uint8_t FALSE_     = 0x42;
+    const uint8_t UINT0      = 0x43;
+    const uint8_t ULONG0     = 0x44;
+    const uint8_t LIST0      = 0x45;
+    const uint8_t UBYTE      = 0x50;
+    const uint8_t BYTE       = 0x51;
+    const uint8_t SMALLUINT  = 0x52;
+    const uint8_t SMALLULONG = 0x53;
+    const uint8_t SMALLINT   = 0x54;
+    const uint8_t SMALLLONG  = 0x55;
+    const uint8_t BOOLEAN    = 0x56;
+    const uint8_t USHORT     = 0x60;
+    const uint8_t SHORT      = 0x61;
+    const uint8_t UINT       = 0x70;
+    const uint8_t INT        = 0x71;
+    const uint8_t FLOAT      = 0x72;
+    const uint8_t CHAR       = 0x73;
+    const uint8_t DECIMAL32  = 0x74;
+    const uint8_t ULONG      = 0x80;
+    const uint8_t LONG       = 0x81;
+    const uint8_t DOUBLE     = 0x82;
+    const uint8_t TIMESTAMP  = 0x83;
+    const uint8_t DECIMAL64  = 0x84;
+    const uint8_t DECIMAL128 = 0x94;
+    const uint8_t UUID       = 0x98;
+    const uint8_t VBIN8      = 0xa0;
+    const uint8_t STR8       = 0xa1;
+    const uint8_t SYM8       = 0xa3;
+    const uint8_t VBIN32     = 0xb0;
+    const uint8_t STR32      = 0xb1;
+    const uint8_t SYM32      = 0xb3;
+    const uint8_t LIST8      = 0xc0;
+    const uint8_t MAP8       = 0xc1;
+    const uint8_t LIST32     = 0xd0;
+    const uint8_t MAP32      = 0xd1;
+    const uint8_t ARRAY8     = 0xe0;
+    const uint8_t ARRAY32    = 0xf0;
+
+    amqp::internal::decoder::Type
+    typeOf (uint8_t code_) {
+        using namespace amqp::internal::decoder;
+
+        switch (code_) {
+            case DESCRIBED  : return described_t;
+            case NULL_      : return null_t;
+            case TRUE_      :
+            case FALSE_     :
+            case BOOLEAN    : return bool_t;
+            case UBYTE      : return ubyte_t;
+            case BYTE       : return byte_t;
+            case USHORT     : return ushort_t;
+            case SHORT      : return short_t;
+            case UINT0      :
+            case SMALLUINT  :
+            case UINT       : return uint_t;
+            case SMALLINT   :
+            case INT        : return int_t;
+            case CHAR       : return char_t;
+            case ULONG0     :
+            case SMALLULONG :
+            case ULONG      : return ulong_t;
+            case SMALLLONG  :
+            case LONG       : return long_t;
+            case TIMESTAMP  : return timestamp_t;
+            case FLOAT      : return float_t;
+            case DOUBLE     : return double_t;
+            case DECIMAL32  : return decimal32_t;
+            case DECIMAL64  : return decimal64_t;
+            case DECIMAL128 : return decimal128_t;
+            case UUID       : return uuid_t;
+            case VBIN8      :
+            case VBIN32     : return binary_t;
+            case STR8       :
+            case STR32      : return string_t;
+            case SYM8       :
+            case SYM32      : return symbol_t;
+            case LIST0      :
+            case LIST8      :
+            case LIST32     : return list_t;
+            case MAP8       :
+            case MAP32      : return map_t;
+            case ARRAY8     :
+            case ARRAY32    : return array_t;
+            default         : return invalid_t;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::decoder::
+typeName (Type type_) {
+    switch (type_) {
+        case null_t       : return "null";
+        case bool_t       : return "bool";
+        case ubyte_t      : return "ubyte";
+        case byte_t       : return "byte";
+        case ushort_t     : return "ushort";
+        case short_t      : return "short";
+        case uint_t       : return "uint";
+        case int_t        : return "int";
+        case char_t       : return "char";
+        case ulong_t      : return "ulong";
+        case long_t       : return "long";
+        case timestamp_t  : return "timestamp";
+        case float_t      : return "float";
+        case double_t     : return "double";
+        case decimal32_t  : return "decimal32";
+        case decimal64_t  : return "decimal64";
+        case decimal128_t : return "decimal128";
+        case uuid_t       : return "uuid";
+        case binary_t     : return "binary";
+        case string_t     : return "string";
+        case symbol_t     : return "symbol";
+        case described_t  : return "described";
+        case array_t      : return "array";
+        case list_t       : return "list";
+        case map_t        : return "map";
+        case invalid_t    : return "invalid";
+    }
+
+    return "invalid";
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Decoder
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+Decoder::Decoder (const char * bytes_, size_t size_) {
+    reset (bytes_, size_);
+}
+
+/**
+ * Everything but the objects we've remembered, for [branch]
+ */
+amqp::internal::decoder::
+Decoder::Decoder (const Decoder & other_, bool)
+    : m_begin (other_.m_begin)
+    , m_end (other_.m_end)
+    , m_frames (other_.m_frames)
+    , m_recall (other_.m_recall)
+    , m_parent (other_.m_parent)
+    , m_base (other_.m_base)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Decoder::reset (const char * bytes_, size_t size_) {
+    m_begin = reinterpret_cast<const uint8_t *>(bytes_);
+    m_end = m_begin + size_;
+
+    m_frames.clear();
+    m_frames.push_back (Frame {
+        m_begin, m_end, npos, npos, Node { }, 0, m_begin, false });
+
+    m_objects.clear();
+    m_recall = 0;
+    m_parent = nullptr;
+    m_base = 0;
+
+    next();
+}
+
+/******************************************************************************/
+
+/**
+ * A size prefix can put [p_] past the end of the buffer as easily as before
+ * its start, neither can be left to the subtraction
+ */
+const uint8_t *
+amqp::internal::decoder::
+Decoder::check (const uint8_t * p_, size_t n_) const {
+    if (p_ < m_begin || p_ > m_end || static_cast<size_t>(m_end - p_) < n_) {
+        throw std::runtime_error ("Truncated AMQP value");
+    }
+
+    return p_ + n_;
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::decoder::
+Decoder::read8 (const uint8_t * p_) const {
+    check (p_, 1);
+    return p_[0];
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::internal::decoder::
+Decoder::read16 (const uint8_t * p_) const {
+    check (p_, 2);
+    return static_cast<uint16_t>((p_[0] << 8) | p_[1]);
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Decoder::read32 (const uint8_t * p_) const {
+    check (p_, 4);
+    return (static_cast<uint32_t>(p_[0]) << 24)
+         | (static_cast<uint32_t>(p_[1]) << 16)
+         | (static_cast<uint32_t>(p_[2]) << 8)
+         |  static_cast<uint32_t>(p_[3]);
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Decoder::read64 (const uint8_t * p_) const {
+    return (static_cast<uint64_t>(read32 (p_)) << 32) | read32 (p_ + 4);
+}
+
+/******************************************************************************/
+
+/**
+ * The element count of a list, map or array. Each element takes at least
+ * a byte so a count bigger than the bytes that follow it can only be a
+ * lie, one we'd otherwise go on to size buffers from. Arrays of a zero
+ * width type are the exception, their elements are just the constructor.
+ */
+size_t
+amqp::internal::decoder::
+Decoder::countOf (const uint8_t * payload_, uint8_t code_) const {
+    const bool   wide  = code_ == LIST32 || code_ == MAP32 || code_ == ARRAY32;
+    const size_t width = wide ? 4 : 1;
+    const size_t size  = wide ? read32 (payload_) : read8 (payload_);
+    const size_t count = wide ? read32 (payload_ + width) : read8 (payload_ + width);
+
+    if (size < width) {
+        throw std::runtime_error ("AMQP size smaller than its count");
+    }
+
+    if ((code_ == ARRAY8 || code_ == ARRAY32)
+            && size > width
+            && (read8 (payload_ + 2 * width) >> 4) == 0x4)
+    {
+        return count;
+    }
+
+    if (count > size - width) {
+        throw std::runtime_error ("AMQP count larger than its size");
+    }
+
+    return count;
+}
+
+/******************************************************************************/
+
+/**
+ * The high nibble of a format code tells us how wide the payload is, or
+ * how wide its size prefix is, so we can always step over a value without
+ * looking inside it. Only described values need more than one step.
+ */
+const uint8_t *
+amqp::internal::decoder::
+Decoder::payloadEnd (const uint8_t * payload_, uint8_t code_) const {
+    switch (code_ >> 4) {
+        case 0x4 : return payload_;
+        case 0x5 : return check (payload_, 1);
+        case 0x6 : return check (payload_, 2);
+        case 0x7 : return check (payload_, 4);
+        case 0x8 : return check (payload_, 8);
+        case 0x9 : return check (payload_, 16);
+        case 0xa :
+        case 0xc :
+        case 0xe : return check (payload_ + 1, read8 (payload_));
+        case 0xb :
+        case 0xd :
+        case 0xf : return check (payload_ + 4, read32 (payload_));
+        default  : {
+            std::stringstream ss;
+            ss << "Unknown AMQP format code 0x" << std::hex << (int)code_;
+            throw std::runtime_error (ss.str());
+        }
+    }
+}
+
+/******************************************************************************/
+
+const uint8_t *
+amqp::internal::decoder::
+Decoder::valueEnd (const uint8_t * start_) const {
+    auto code = read8 (start_);
+
+    if (code == DESCRIBED) {
+        // step over the descriptor and then the value it describes
+        return valueEnd (valueEnd (start_ + 1));
+    }
+
+    return payloadEnd (start_ + 1, code);
+}
+
+/******************************************************************************/
+
+const uint8_t *
+amqp::internal::decoder::
+Decoder::nodeEnd (const Node & node_) const {
+    return node_.code == DESCRIBED
+        ? valueEnd (node_.start)
+        : payloadEnd (node_.payload, node_.code);
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Decoder::Node
+amqp::internal::decoder::
+Decoder::valueAt (const uint8_t * start_) const {
+    return Node { start_, start_ + 1, read8 (start_) };
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::next() {
+    auto & f = m_frames.back();
+
+    const uint8_t * pos;
+
+    if (f.index == npos) {
+        pos = f.first;
+    } else if (f.index + 1 >= f.count) {
+        return false;
+    } else if (f.describedArray && f.index == 0) {
+        pos = f.elements;
+    } else {
+        pos = nodeEnd (f.current);
+    }
+
+    if (pos >= f.end) {
+        return false;
+    }
+
+    auto index = (f.index == npos) ? 0 : f.index + 1;
+
+    if (f.elementCode && !(f.describedArray && index == 0)) {
+        f.current = Node { pos, pos, f.elementCode };
+    } else {
+        f.current = valueAt (pos);
+    }
+
+    f.index = index;
+
+    return true;
+}
+
+/******************************************************************************/
+
+/**
+ * Like pn_data_enter we can "enter" anything, entering a value that isn't
+ * a compound just leaves us somewhere with no children.
+ */
+bool
+amqp::internal::decoder::
+Decoder::enter() {
+    const auto & f = frame();
+
+    if (f.index == npos) {
+        return false;
+    }
+
+    const auto & n = f.current;
+    const auto * p = n.payload;
+
+    Frame child { p, p, 0, npos, Node { }, 0, p, false };
+
+    switch (n.code) {
+        case DESCRIBED : {
+            child.count = 2;
+            child.end = valueEnd (n.start);
+            break;
+        }
+        case LIST8  :
+        case MAP8   :
+        case ARRAY8 : {
+            child.end = check (p + 1, read8 (p));
+            child.count = countOf (p, n.code);
+            child.first = p + 2;
+            break;
+        }
+        case LIST32  :
+        case MAP32   :
+        case ARRAY32 : {
+            child.end = check (p + 4, read32 (p));
+            child.count = countOf (p, n.code);
+            child.first = p + 8;
+            break;
+        }
+        default : break;
+    }
+
+    if (n.code == ARRAY8 || n.code == ARRAY32) {
+        if (read8 (child.first) == DESCRIBED) {
+            /*
+             * 0x00 <descriptor> <element constructor> <elements...>, the
+             * descriptor becomes our first child
+             */
+            child.describedArray = true;
+            child.first += 1;
+            auto constructor = valueEnd (child.first);
+            child.elementCode = read8 (constructor);
+            child.elements = constructor + 1;
+            child.count += 1;
+        } else {
+            child.elementCode = read8 (child.first);
+            child.elements = child.first + 1;
+            child.first = child.elements;
+        }
+    }
+
+    m_frames.push_back (child);
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::exit() {
+    if (m_frames.size() <= 1) {
+        return false;
+    }
+
+    if (m_frames.size() == m_recall) {
+        m_recall = 0;
+    }
+
+    m_frames.pop_back();
+
+    return true;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Decoder::remember (size_t offset_) {
+    m_objects.push_back (offset_);
+
+    return m_base + m_objects.size() - 1;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Decoder::recall (size_t object_) {
+    if (m_parent && object_ >= m_base) {
+        throw std::runtime_error (
+                "Reference to object " + std::to_string (object_)
+                    + " from a branch taken at " + std::to_string (m_base));
+    }
+
+    if (object_ >= remembered()) {
+        throw std::runtime_error (
+                "Reference to object " + std::to_string (object_)
+                    + " of " + std::to_string (remembered()));
+    }
+
+    const auto * p = m_begin + (m_parent
+        ? (*m_parent)[object_]
+        : m_objects[object_]);
+
+    check (p, 1);
+
+    m_frames.push_back (Frame {
+        p, valueEnd (p), 1, 0, valueAt (p), 0, p, false });
+
+    if (!recalling()) {
+        m_recall = m_frames.size();
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::recalling() const {
+    return m_recall != 0;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Decoder
+amqp::internal::decoder::
+Decoder::branch() const {
+    if (m_parent) {
+        throw std::runtime_error ("Can't branch a branch");
+    }
+
+    Decoder rtn { *this, false };
+
+    rtn.m_parent = &m_objects;
+    rtn.m_base = m_objects.size();
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Decoder::join (const Decoder & branch_) {
+    if (branch_.m_parent != &m_objects) {
+        throw std::runtime_error ("Can only join our own branches");
+    }
+
+    m_objects.insert (
+            m_objects.end(),
+            branch_.m_objects.begin(),
+            branch_.m_objects.end());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+Decoder::reposition (const Decoder & branch_) {
+    if (branch_.m_parent != &m_objects) {
+        throw std::runtime_error ("Can only move to our own branches");
+    }
+
+    m_frames = branch_.m_frames;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::Type
+amqp::internal::decoder::
+Decoder::type() const {
+    if (frame().index == npos) {
+        return invalid_t;
+    }
+
+    return typeOf (node().code);
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::decoder::
+Decoder::code() const {
+    return node().code;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Decoder::encoded() const {
+    if (frame().index == npos) {
+        return { };
+    }
+
+    const auto & n = node();
+
+    return std::string_view (
+            reinterpret_cast<const char *>(n.start),
+            nodeEnd (n) - n.start);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Decoder::offset() const {
+    return (frame().index == npos ? frame().first : node().start) - m_begin;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Decoder::get_list() const {
+    if (type() != list_t) return 0;
+
+    switch (code()) {
+        case LIST8  :
+        case LIST32 : return countOf (node().payload, code());
+        default     : return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Decoder::get_map() const {
+    if (type() != map_t) return 0;
+
+    return countOf (node().payload, code());
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+Decoder::get_array() const {
+    if (type() != array_t) return 0;
+
+    return countOf (node().payload, code());
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::is_array_described() const {
+    if (type() != array_t) return false;
+
+    return read8 (node().payload + (code() == ARRAY8 ? 2 : 8)) == DESCRIBED;
+}
+
+/******************************************************************************/
+
+/**
+ * The encoded elements of an undescribed array, back to back, with
+ * [code_] set to the constructor they share. Empty, with [code_] zero, if
+ * we're not on one
+ */
+std::string_view
+amqp::internal::decoder::
+Decoder::arrayElements (uint8_t & code_) const {
+    code_ = 0;
+
+    if (type() != array_t || is_array_described()) return { };
+
+    const auto * constructor = node().payload + (code() == ARRAY8 ? 2 : 8);
+
+    code_ = read8 (constructor);
+
+    return std::string_view (
+            reinterpret_cast<const char *>(constructor + 1),
+            nodeEnd (node()) - constructor - 1);
+}
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The compact encodings are a single byte, no need to swap anything
+     * just sign extend it
+     */
+    template<typename T>
+    void
+    widen (std::string_view from_, std::vector<T> & to_, size_t n_) {
+        to_.resize (n_);
+
+        for (size_t i { 0 } ; i < n_ ; ++i) {
+            to_[i] = static_cast<int8_t>(from_[i]);
+        }
+    }
+
+    template<typename T>
+    void
+    swapped (std::string_view from_, std::vector<T> & to_, size_t n_) {
+        to_.resize (n_);
+
+        const auto * from = reinterpret_cast<const uint8_t *>(from_.data());
+
+        if (sizeof (T) == 4) {
+            amqp::internal::decoder::fromBigEndian32 (from, to_.data(), n_);
+        } else {
+            amqp::internal::decoder::fromBigEndian64 (from, to_.data(), n_);
+        }
+    }
+
+    void
+    truncated (std::string_view elements_, size_t n_, size_t width_) {
+        if (elements_.size() < n_ * width_) {
+            throw std::runtime_error ("Truncated array");
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::get_array_values (std::vector<int32_t> & to_) const {
+    uint8_t code;
+    auto elements = arrayElements (code);
+    auto n = get_array();
+
+    switch (code) {
+        case INT :
+            truncated (elements, n, 4);
+            swapped (elements, to_, n);
+            return true;
+        case SMALLINT :
+            truncated (elements, n, 1);
+            widen (elements, to_, n);
+            return true;
+        default :
+            return false;
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::get_array_values (std::vector<int64_t> & to_) const {
+    uint8_t code;
+    auto elements = arrayElements (code);
+    auto n = get_array();
+
+    switch (code) {
+        case LONG :
+            truncated (elements, n, 8);
+            swapped (elements, to_, n);
+            return true;
+        case SMALLLONG :
+            truncated (elements, n, 1);
+            widen (elements, to_, n);
+            return true;
+        default :
+            return false;
+    }
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::get_array_values (std::vector<double> & to_) const {
+    uint8_t code;
+    auto elements = arrayElements (code);
+    auto n = get_array();
+
+    if (code != DOUBLE) {
+        return false;
+    }
+
+    truncated (elements, n, 8);
+    swapped (elements, to_, n);
+
+    return true;
+}
+
+/******************************************************************************
+ *
+ * Typed getters. Like proton these return a zero value if the cursor isn't
+ * on a value of the requested type, callers are expected to check the
+ * type first where that matters.
+ *
+ ******************************************************************************/
+
+bool
+amqp::internal::decoder::
+Decoder::get_bool() const {
+    if (type() != bool_t) return false;
+
+    switch (code()) {
+        case TRUE_  : return true;
+        case FALSE_ : return false;
+        default     : return read8 (node().payload) != 0;
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+amqp::internal::decoder::
+Decoder::get_ubyte() const {
+    return type() == ubyte_t ? read8 (node().payload) : 0;
+}
+
+/******************************************************************************/
+
+int8_t
+amqp::internal::decoder::
+Decoder::get_byte() const {
+    return type() == byte_t ? static_cast<int8_t>(read8 (node().payload)) : 0;
+}
+
+/******************************************************************************/
+
+uint16_t
+amqp::internal::decoder::
+Decoder::get_ushort() const {
+    return type() == ushort_t ? read16 (node().payload) : 0;
+}
+
+/******************************************************************************/
+
+int16_t
+amqp::internal::decoder::
+Decoder::get_short() const {
+    return type() == short_t ? static_cast<int16_t>(read16 (node().payload)) : 0;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Decoder::get_uint() const {
+    switch (type() == uint_t ? code() : 0) {
+        case UINT      : return read32 (node().payload);
+        case SMALLUINT : return read8 (node().payload);
+        default        : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int32_t
+amqp::internal::decoder::
+Decoder::get_int() const {
+    switch (type() == int_t ? code() : 0) {
+        case INT      : return static_cast<int32_t>(read32 (node().payload));
+        case SMALLINT : return static_cast<int8_t>(read8 (node().payload));
+        default       : return 0;
+    }
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Decoder::get_char() const {
+    return type() == char_t ? read32 (node().payload) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Decoder::get_ulong() const {
+    switch (type() == ulong_t ? code() : 0) {
+        case ULONG      : return read64 (node().payload);
+        case SMALLULONG : return read8 (node().payload);
+        default         : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::decoder::
+Decoder::get_long() const {
+    switch (type() == long_t ? code() : 0) {
+        case LONG      : return static_cast<int64_t>(read64 (node().payload));
+        case SMALLLONG : return static_cast<int8_t>(read8 (node().payload));
+        default        : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+amqp::internal::decoder::
+Decoder::get_timestamp() const {
+    return type() == timestamp_t
+        ? static_cast<int64_t>(read64 (node().payload))
+        : 0;
+}
+
+/******************************************************************************/
+
+float
+amqp::internal::decoder::
+Decoder::get_float() const {
+    if (type() != float_t) return 0;
+
+    auto bits = read32 (node().payload);
+    float rtn;
+    std::memcpy (&rtn, &bits, sizeof (rtn));
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+double
+amqp::internal::decoder::
+Decoder::get_double() const {
+    if (type() != double_t) return 0;
+
+    auto bits = read64 (node().payload);
+    double rtn;
+    std::memcpy (&rtn, &bits, sizeof (rtn));
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+uint32_t
+amqp::internal::decoder::
+Decoder::get_decimal32() const {
+    return type() == decimal32_t ? read32 (node().payload) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+amqp::internal::decoder::
+Decoder::get_decimal64() const {
+    return type() == decimal64_t ? read64 (node().payload) : 0;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::bytes16_t
+amqp::internal::decoder::
+Decoder::get_decimal128() const {
+    bytes16_t rtn { };
+
+    if (type() == decimal128_t) {
+        check (node().payload, rtn.size());
+        std::memcpy (rtn.data(), node().payload, rtn.size());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::bytes16_t
+amqp::internal::decoder::
+Decoder::get_uuid() const {
+    bytes16_t rtn { };
+
+    if (type() == uuid_t) {
+        check (node().payload, rtn.size());
+        std::memcpy (rtn.data(), node().payload, rtn.size());
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Decoder::bytesOf (uint8_t short_, uint8_t long_) const {
+    if (frame().index == npos) return { };
+
+    const auto & n = node();
+
+    if (n.code == short_) {
+        auto size = read8 (n.payload);
+        check (n.payload + 1, size);
+        return std::string_view (
+                reinterpret_cast<const char *>(n.payload + 1), size);
+    } else if (n.code == long_) {
+        auto size = read32 (n.payload);
+        check (n.payload + 4, size);
+        return std::string_view (
+                reinterpret_cast<const char *>(n.payload + 4), size);
+    }
+
+    return { };
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Decoder::get_binary() const {
+    return bytesOf (VBIN8, VBIN32);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Decoder::get_string() const {
+    return bytesOf (STR8, STR32);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::decoder::
+Decoder::get_symbol() const {
+    return bytesOf (SYM8, SYM32);
+}
+
+/******************************************************************************
+ *
+ * Non member functions
+ *
+ ******************************************************************************/
+
+std::ostream &
+operator << (std::ostream & stream_, const amqp::internal::decoder::Decoder * data_) {
+    using namespace amqp::internal::decoder;
+
+    auto type = data_->type();
+    stream_ << std::setw (2) << type << " " << typeName (type);
+
+    switch (type) {
+        case ulong_t  : stream_ << " " << data_->get_ulong(); break;
+        case long_t   : stream_ << " " << data_->get_long(); break;
+        case int_t    : stream_ << " " << data_->get_int(); break;
+        case double_t : stream_ << " " << data_->get_double(); break;
+        case list_t   : stream_ << " #entries: " << data_->get_list(); break;
+        case map_t    : stream_ << " #entries: " << data_->get_map(); break;
+        case string_t : stream_ << " " << data_->get_string(); break;
+        case symbol_t : stream_ << " " << data_->get_symbol(); break;
+        case bool_t   : stream_ << " " << (data_->get_bool() ? "true" : "false"); break;
+        default       : break;
+    }
+
+    return stream_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+is_described (const Decoder * data_) {
+    if (data_->type() != described_t) {
+        throw std::runtime_error ("Expected a described type");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+is_ulong (const Decoder * data_) {
+    auto t = data_->type();
+    if (t != ulong_t) {
+        std::stringstream ss;
+        ss << "Expected an unsigned long but received " << typeName (t);
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+is_symbol (const Decoder * data_) {
+    if (data_->type() != symbol_t) {
+        throw std::runtime_error ("Expected a symbol");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+is_list (const Decoder * data_) {
+    if (data_->type() != list_t) {
+        throw std::runtime_error ("Expected a list");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::decoder::
+is_string (const Decoder * data_, bool allowNull) {
+    auto t = data_->type();
+    if (t != string_t && !(allowNull && t == null_t)) {
+        throw std::runtime_error ("Expected a String");
+    }
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::decoder::
+get_string (const Decoder * data_, bool allowNull) {
+    if (data_->type() == string_t) {
+        return std::string (data_->get_string());
+    } else if (allowNull && data_->type() == null_t) {
+        return "";
+    }
+    throw std::runtime_error ("Expected a String");
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+amqp::internal::decoder::
+get_symbol<std::string> (const Decoder * data_) {
+    is_symbol (data_);
+    return std::string (data_->get_symbol());
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::decoder::
+get_boolean (const Decoder * data_) {
+    if (data_->type() == bool_t) {
+        return data_->get_bool();
+    }
+    throw std::runtime_error ("Expected a boolean");
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_enter
+ *
+ ******************************************************************************/
+
+/**
+ * Like proton::auto_enter we land on the first child rather than before it
+ */
+amqp::internal::decoder::
+auto_enter::auto_enter (Decoder * data_, bool next_)
+    : m_data (data_)
+{
+    m_data->enter();
+    m_data->next();
+    if (next_) m_data->next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_enter::~auto_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_next
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_next::auto_next (Decoder * data_)
+    : m_data (data_)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_next::~auto_next() {
+    m_data->next();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_list_enter
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_list_enter::auto_list_enter (Decoder * data_, bool next_)
+    : m_elements (data_->get_list())
+    , m_data (data_)
+{
+    m_data->enter();
+    if (next_) m_data->next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_list_enter::~auto_list_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+auto_list_enter::elements() const {
+    return m_elements;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::auto_map_enter
+ *
+ ******************************************************************************/
+
+amqp::internal::decoder::
+auto_map_enter::auto_map_enter (Decoder * data_, bool next_)
+    : m_elements (data_->get_map())
+    , m_data (data_)
+{
+    m_data->enter();
+    if (next_) m_data->next();
+}
+
+/******************************************************************************/
+
+amqp::internal::decoder::
+auto_map_enter::~auto_map_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::decoder::
+auto_map_enter::elements() const {
+    return m_elements;
+}
+
+/******************************************************************************
+ *
+ * readAndNext
+ *
+ ******************************************************************************/
+
+template<>
+int32_t
+amqp::internal::decoder::
+readAndNext<int32_t> (Decoder * data_, bool) {
+    auto_next an (data_);
+    return data_->get_int();
+}
+
+/******************************************************************************/
+
+template<>
+long
+amqp::internal::decoder::
+readAndNext<long> (Decoder * data_, bool) {
+    auto_next an (data_);
+    return data_->get_long();
+}
+
+/******************************************************************************/
+
+template<>
+unsigned long
+amqp::internal::decoder::
+readAndNext<unsigned long> (Decoder * data_, bool) {
+    auto_next an (data_);
+    return data_->get_ulong();
+}
+
+/******************************************************************************/
+
+template<>
+bool
+amqp::internal::decoder::
+readAndNext<bool> (Decoder * data_, bool) {
+    auto_next an (data_);
+    return data_->get_bool();
+}
+
+/******************************************************************************/
+
+template<>
+double
+amqp::internal::decoder::
+readAndNext<double> (Decoder * data_, bool) {
+    auto_next an (data_);
+    return data_->get_double();
+}
+
+/******************************************************************************/
+
+/**
+ * As for std::string but the result is a view into the buffer, no copy
+ */
+template<>
+std::string_view
+amqp::internal::decoder::
+readAndNext<std::string_view> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    if (data_->type() == string_t) {
+        return data_->get_string();
+    } else if (data_->type() == symbol_t) {
+        return data_->get_symbol();
+    } else if (tolerateDeviance_ && data_->type() == null_t) {
+        return { };
+    }
+
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+amqp::internal::decoder::
+readAndNext<std::string> (
+    Decoder * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    if (data_->type() == string_t) {
+        return std::string (data_->get_string());
+    } else if (data_->type() == symbol_t) {
+        return std::string (data_->get_symbol());
+    } else if (tolerateDeviance_ && data_->type() == null_t) {
+        return "";
+    }
+
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
@@ -0,0 +1,374 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Type
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * The type of the value under the cursor. These line up with the
+     * categories qpid-proton exposes through pn_type_t, variable width
+     * and compact encodings of the same type are folded together.
+     */
+    enum Type {
+        null_t, bool_t, ubyte_t, byte_t, ushort_t, short_t, uint_t, int_t,
+        char_t, ulong_t, long_t, timestamp_t, float_t, double_t,
+        decimal32_t, decimal64_t, decimal128_t, uuid_t, binary_t, string_t,
+        symbol_t, described_t, array_t, list_t, map_t, invalid_t
+    };
+
+    const char * typeName (Type);
+
+    using bytes16_t = std::array<char, 16>;
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::decoder::Decoder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    /**
+     * A cursor over a raw AMQP 1.0 encoded buffer.
+     *
+     * Navigation mirrors pn_data_t, we have a current node and can move to
+     * the next sibling, enter a compound (positioned before its first child)
+     * and exit back out to it. Unlike pn_data_t nothing is decoded up front,
+     * values are read straight out of the buffer as the cursor passes over
+     * them so there is no node tree to build, and strings, symbols and
+     * binaries are handed out as views into the buffer.
+     *
+     * The buffer must outlive the Decoder.
+     *
+     * On construction the cursor sits on the first value in the buffer, the
+     * same place pn_data_decode leaves a pn_data_t. At the top level next()
+     * moves across successive values until the buffer is exhausted.
+     */
+    class Decoder {
+        private :
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            struct Node {
+                /**
+                 * Where the encoding starts, the constructor for ordinary
+                 * values and the payload itself for array elements which
+                 * share the array's constructor
+                 */
+                const uint8_t * start;
+                const uint8_t * payload;
+
+                /**
+                 * 0x00 for described values
+                 */
+                uint8_t code;
+            };
+
+            /**
+             * One per level we've entered, the bottom frame represents the
+             * buffer itself
+             */
+            struct Frame {
+                const uint8_t * first;
+                const uint8_t * end;
+
+                size_t count;
+                size_t index;
+                Node   current;
+
+                /**
+                 * Arrays only, elements have no constructor of their own. Where
+                 * the array is described the descriptor is the first child and
+                 * the elements start after the element constructor
+                 */
+                uint8_t         elementCode;
+                const uint8_t * elements;
+                bool            describedArray;
+            };
+
+            const uint8_t * m_begin;
+            const uint8_t * m_end;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Where each object we've been asked to [remember] starts
+             */
+            std::vector<size_t> m_objects;
+
+            /**
+             * The depth of the frame [recall] pushed, zero when we're not
+             * revisiting anything
+             */
+            size_t m_recall;
+
+            /**
+             * Set if we're a [branch], the objects of whoever we branched
+             * from and how many of them there were at the time. Ours are
+             * numbered on from there.
+             */
+            const std::vector<size_t> * m_parent;
+            size_t                      m_base;
+
+            const Frame & frame() const { return m_frames.back(); }
+            const Node & node() const { return m_frames.back().current; }
+
+            const uint8_t * check (const uint8_t *, size_t) const;
+
+            uint8_t  read8 (const uint8_t *) const;
+            uint16_t read16 (const uint8_t *) const;
+            uint32_t read32 (const uint8_t *) const;
+            uint64_t read64 (const uint8_t *) const;
+
+            const uint8_t * payloadEnd (const uint8_t *, uint8_t) const;
+            size_t countOf (const uint8_t *, uint8_t) const;
+            const uint8_t * valueEnd (const uint8_t *) const;
+            const uint8_t * nodeEnd (const Node &) const;
+
+            Node valueAt (const uint8_t *) const;
+
+            std::string_view bytesOf (uint8_t, uint8_t) const;
+
+            std::string_view arrayElements (uint8_t &) const;
+
+            Decoder (const Decoder &, bool);
+
+        public :
+            Decoder (const char *, size_t);
+            Decoder (const Decoder &) = default;
+            Decoder (Decoder &&) = default;
+            Decoder & operator = (const Decoder &) = default;
+            Decoder & operator = (Decoder &&) = default;
+
+            /**
+             * Reset to the first value of a new buffer, keeping whatever
+             * storage the frame stack has already grown to
+             */
+            void reset (const char *, size_t);
+
+            Type type() const;
+
+            /**
+             * The raw AMQP format code of the current value
+             */
+            uint8_t code() const;
+
+            bool next();
+            bool enter();
+            bool exit();
+
+            /**
+             * The complete encoding of the current value, constructor
+             * included
+             */
+            std::string_view encoded() const;
+
+            /**
+             * How far into the buffer the current value starts
+             */
+            size_t offset() const;
+
+            size_t depth() const { return m_frames.size() - 1; }
+
+            /**
+             * Corda numbers every object it writes, in the order it finishes
+             * writing them, and rather than write one twice it writes a
+             * reference to that number. We keep a table of where each one
+             * started, [remember] adds the value at the given offset and
+             * returns its number.
+             *
+             * [recall] moves the cursor onto a remembered value, in a frame
+             * of its own, so it can be read again. [exit] returns to where
+             * we were. Whilst anything is being recalled [recalling] is true
+             * so the objects inside it aren't remembered a second time.
+             */
+            size_t remember (size_t);
+            void recall (size_t);
+            bool recalling() const;
+            size_t remembered() const { return m_base + m_objects.size(); }
+
+            /**
+             * A copy of us, over the same buffer and sitting on the same
+             * value, that can be moved about independently. Used to decode
+             * parts of a container on other threads.
+             *
+             * A branch can recall anything we'd remembered when it was
+             * taken, but it can't know how many objects other branches of
+             * the same container will add before its own so it refuses to
+             * recall those, throwing instead. It numbers the objects it
+             * remembers as if nothing came between us and it, [join]
+             * adds them to our own once whatever came between has been.
+             *
+             * We mustn't remember anything whilst we have branches.
+             */
+            Decoder branch() const;
+            void join (const Decoder &);
+            bool branched() const { return m_parent != nullptr; }
+
+            /**
+             * Move our cursor back to where a [branch] of ours is
+             */
+            void reposition (const Decoder &);
+
+            size_t get_list() const;
+            size_t get_map() const;
+            size_t get_array() const;
+            bool is_array_described() const;
+
+            /**
+             * Every element of an undescribed array of ints, longs or
+             * doubles copied into [to_] in one go, which is possible as
+             * they're all the same width and back to back in the buffer.
+             *
+             * @return false, leaving [to_] alone, if we're not on one
+             */
+            bool get_array_values (std::vector<int32_t> & to_) const;
+            bool get_array_values (std::vector<int64_t> & to_) const;
+            bool get_array_values (std::vector<double> & to_) const;
+
+            bool get_bool() const;
+            uint8_t get_ubyte() const;
+            int8_t get_byte() const;
+            uint16_t get_ushort() const;
+            int16_t get_short() const;
+            uint32_t get_uint() const;
+            int32_t get_int() const;
+            uint32_t get_char() const;
+            uint64_t get_ulong() const;
+            int64_t get_long() const;
+            int64_t get_timestamp() const;
+            float get_float() const;
+            double get_double() const;
+            uint32_t get_decimal32() const;
+            uint64_t get_decimal64() const;
+            bytes16_t get_decimal128() const;
+            bytes16_t get_uuid() const;
+
+            std::string_view get_binary() const;
+            std::string_view get_string() const;
+            std::string_view get_symbol() const;
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Friendly ostream operator for the value under a Decoder's cursor
+ */
+std::ostream& operator << (std::ostream &, const amqp::internal::decoder::Decoder *);
+
+/******************************************************************************
+ *
+ * Utility functions and auto objects to make working with the Decoder
+ * look like working with proton through proton_wrapper
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    void is_list (const Decoder *);
+    void is_ulong (const Decoder *);
+    void is_symbol (const Decoder *);
+    void is_string (const Decoder *, bool allowNull = false);
+    void is_described (const Decoder *);
+
+    /**
+     * Specialised in the CXX file
+     */
+    template<typename T>
+    T get_symbol (const Decoder *) {
+        return T {};
+    }
+
+    bool get_boolean (const Decoder *);
+    std::string get_string (const Decoder *, bool allowNull = false);
+
+    class auto_enter {
+        private :
+            Decoder * m_data;
+
+        public :
+            explicit auto_enter (Decoder *, bool next_ = false);
+            auto_enter (const auto_enter &) = delete;
+            ~auto_enter();
+    };
+
+    class auto_next {
+        private :
+            Decoder * m_data;
+
+        public :
+            explicit auto_next (Decoder *);
+            auto_next (const auto_next &) = delete;
+            ~auto_next();
+    };
+
+    class auto_list_enter {
+        private :
+            size_t    m_elements;
+            Decoder * m_data;
+
+        public :
+            explicit auto_list_enter (Decoder *, bool next_ = false);
+            auto_list_enter (const auto_list_enter &) = delete;
+            ~auto_list_enter();
+
+            size_t elements() const;
+    };
+
+    class auto_map_enter {
+        private :
+            size_t    m_elements;
+            Decoder * m_data;
+
+        public :
+            explicit auto_map_enter (Decoder *, bool next_ = false);
+            auto_map_enter (const auto_map_enter &) = delete;
+            ~auto_map_enter();
+
+            size_t elements() const;
+    };
+
+    /**
+     * Specialised in the CXX file
+     */
+    template<typename T>
+    T
+    readAndNext (Decoder *, bool tolerateDeviance_ = false) {
+        return T{};
+    }
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    template<> std::string get_symbol<std::string> (const Decoder *);
+
+    template<> int32_t readAndNext<int32_t> (Decoder *, bool);
+    template<> long readAndNext<long> (Decoder *, bool);
+    template<> unsigned long readAndNext<unsigned long> (Decoder *, bool);
+    template<> bool readAndNext<bool> (Decoder *, bool);
+    template<> double readAndNext<double> (Decoder *, bool);
+    template<> std::string readAndNext<std::string> (Decoder *, bool);
+    template<> std::string_view readAndNext<std::string_view> (Decoder *, bool);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,529 @@
+#include "Encoder.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * How much we let build up before writing it out
+     */
+    const size_t HIGH_WATER = 1 << 20;
+
+    const uint8_t DESCRIBED  = 0x00;
+    const uint8_t NULL_      = 0x40;
+    const uint8_t TRUE_      = 0x41;
+    const uint8_t FALSE_     = 0x42;
+    const uint8_t UINT0      = 0x43;
+    const uint8_t ULONG0     = 0x44;
+    const uint8_t UBYTE      = 0x50;
+    const uint8_t BYTE       = 0x51;
+    const uint8_t SMALLUINT  = 0x52;
+    const uint8_t SMALLULONG = 0x53;
+    const uint8_t SMALLINT   = 0x54;
+    const uint8_t SMALLLONG  = 0x55;
+    const uint8_t USHORT     = 0x60;
+    const uint8_t SHORT      = 0x61;
+    const uint8_t UINT       = 0x70;
+    const uint8_t INT        = 0x71;
+    const uint8_t FLOAT      = 0x72;
+    const uint8_t CHAR       = 0x73;
+    const uint8_t ULONG      = 0x80;
+    const uint8_t LONG       = 0x81;
+    const uint8_t DOUBLE     = 0x82;
+    const uint8_t TIMESTAMP  = 0x83;
+    const uint8_t UUID       = 0x98;
+    const uint8_t VBIN8      = 0xa0;
+    const uint8_t STR8       = 0xa1;
+    const uint8_t SYM8       = 0xa3;
+    const uint8_t VBIN32     = 0xb0;
+    const uint8_t STR32      = 0xb1;
+    const uint8_t SYM32      = 0xb3;
+    const uint8_t LIST32     = 0xd0;
+    const uint8_t MAP32      = 0xd1;
+
+    void
+    bigEndian32 (uint32_t value_, char * to_) {
+        value_ = __builtin_bswap32 (value_);
+        std::memcpy (to_, &value_, sizeof (value_));
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::encoder::
+Encoder::Encoder (int fd_)
+    : m_fd (fd_)
+    , m_seekable (false)
+    , m_base (0)
+    , m_flushed (0)
+{
+    if (m_fd >= 0) {
+        auto at = ::lseek (m_fd, 0, SEEK_CUR);
+
+        m_seekable = at >= 0;
+        m_base = m_seekable ? static_cast<uint64_t>(at) : 0;
+    } else {
+        m_buffer.reserve (4096);
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::encoder::
+Encoder::~Encoder() {
+    try {
+        flush();
+    } catch (...) {
+        // nowhere left to report it
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * A value's been finished, count it as one of whatever it's in. When that's
+ * a described value with both its descriptor and value the described value
+ * is itself finished.
+ */
+void
+amqp::internal::encoder::
+Encoder::counted() {
+    while (!m_compounds.empty()) {
+        auto & compound = m_compounds.back();
+
+        ++compound.count;
+
+        if (!compound.described || compound.count < 2) {
+            break;
+        }
+
+        m_compounds.pop_back();
+    }
+
+    drain();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::put8 (uint8_t value_) {
+    m_buffer.push_back (static_cast<char>(value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::put16 (uint16_t value_) {
+    value_ = __builtin_bswap16 (value_);
+    m_buffer.append (reinterpret_cast<const char *>(&value_), sizeof (value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::put32 (uint32_t value_) {
+    value_ = __builtin_bswap32 (value_);
+    m_buffer.append (reinterpret_cast<const char *>(&value_), sizeof (value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::put64 (uint64_t value_) {
+    value_ = __builtin_bswap64 (value_);
+    m_buffer.append (reinterpret_cast<const char *>(&value_), sizeof (value_));
+}
+
+/******************************************************************************/
+
+/**
+ * Fill in a size or count, in the file if it's already been written there
+ */
+void
+amqp::internal::encoder::
+Encoder::patch32 (uint64_t at_, uint32_t value_) {
+    if (at_ >= m_flushed) {
+        bigEndian32 (value_, &m_buffer[at_ - m_flushed]);
+        return;
+    }
+
+    char bytes[4];
+    bigEndian32 (value_, bytes);
+
+    if (::pwrite (m_fd, bytes, sizeof (bytes), m_base + at_) != sizeof (bytes)) {
+        throw std::runtime_error ("Failed to write output");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::variable (uint8_t code8_, uint8_t code32_, std::string_view value_) {
+    if (value_.size() < 256) {
+        put8 (code8_);
+        put8 (static_cast<uint8_t>(value_.size()));
+    } else {
+        put8 (code32_);
+        put32 (static_cast<uint32_t>(value_.size()));
+    }
+
+    m_buffer.append (value_.data(), value_.size());
+    counted();
+}
+
+/******************************************************************************/
+
+/**
+ * Leave room for the size and count, they're filled in by [end]
+ */
+void
+amqp::internal::encoder::
+Encoder::begin (uint8_t code_) {
+    put8 (code_);
+    m_compounds.push_back ({ size(), 0, false });
+    put32 (0);
+    put32 (0);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::end() {
+    if (m_compounds.empty() || m_compounds.back().described) {
+        throw std::runtime_error ("Nothing to close");
+    }
+
+    auto compound = m_compounds.back();
+    m_compounds.pop_back();
+
+    // the size counts everything after itself, the count included
+    patch32 (compound.at, static_cast<uint32_t>(size() - compound.at - 4));
+    patch32 (compound.at + 4, compound.count);
+
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::drain() {
+    if (m_fd >= 0 && m_buffer.size() >= HIGH_WATER) {
+        flush();
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Write everything up to [to_] out
+ */
+void
+amqp::internal::encoder::
+Encoder::write (uint64_t to_) {
+    const char * p = m_buffer.data();
+    size_t left = to_ - m_flushed;
+
+    while (left) {
+        auto written = ::write (m_fd, p, left);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            throw std::runtime_error ("Failed to write output");
+        }
+
+        p += written;
+        left -= written;
+    }
+
+    m_buffer.erase (0, to_ - m_flushed);
+    m_flushed = to_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::flush() {
+    if (m_fd < 0) {
+        return;
+    }
+
+    write (m_seekable || m_compounds.empty()
+        ? size()
+        : m_compounds.front().at);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putNull() {
+    put8 (NULL_);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putBool (bool value_) {
+    put8 (value_ ? TRUE_ : FALSE_);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUbyte (uint8_t value_) {
+    put8 (UBYTE);
+    put8 (value_);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putByte (int8_t value_) {
+    put8 (BYTE);
+    put8 (static_cast<uint8_t>(value_));
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUshort (uint16_t value_) {
+    put8 (USHORT);
+    put16 (value_);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putShort (int16_t value_) {
+    put8 (SHORT);
+    put16 (static_cast<uint16_t>(value_));
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUint (uint32_t value_) {
+    if (value_ == 0) {
+        put8 (UINT0);
+    } else if (value_ < 256) {
+        put8 (SMALLUINT);
+        put8 (static_cast<uint8_t>(value_));
+    } else {
+        put8 (UINT);
+        put32 (value_);
+    }
+
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putInt (int32_t value_) {
+    if (value_ >= -128 && value_ <= 127) {
+        put8 (SMALLINT);
+        put8 (static_cast<uint8_t>(value_));
+    } else {
+        put8 (INT);
+        put32 (static_cast<uint32_t>(value_));
+    }
+
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putChar (uint32_t value_) {
+    put8 (CHAR);
+    put32 (value_);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUlong (uint64_t value_) {
+    if (value_ == 0) {
+        put8 (ULONG0);
+    } else if (value_ < 256) {
+        put8 (SMALLULONG);
+        put8 (static_cast<uint8_t>(value_));
+    } else {
+        put8 (ULONG);
+        put64 (value_);
+    }
+
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putLong (int64_t value_) {
+    if (value_ >= -128 && value_ <= 127) {
+        put8 (SMALLLONG);
+        put8 (static_cast<uint8_t>(value_));
+    } else {
+        put8 (LONG);
+        put64 (static_cast<uint64_t>(value_));
+    }
+
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putTimestamp (int64_t value_) {
+    put8 (TIMESTAMP);
+    put64 (static_cast<uint64_t>(value_));
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putFloat (float value_) {
+    uint32_t bits;
+    std::memcpy (&bits, &value_, sizeof (bits));
+
+    put8 (FLOAT);
+    put32 (bits);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDouble (double value_) {
+    uint64_t bits;
+    std::memcpy (&bits, &value_, sizeof (bits));
+
+    put8 (DOUBLE);
+    put64 (bits);
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putUuid (const std::array<char, 16> & value_) {
+    put8 (UUID);
+    m_buffer.append (value_.data(), value_.size());
+    counted();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putBinary (std::string_view value_) {
+    variable (VBIN8, VBIN32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putString (std::string_view value_) {
+    variable (STR8, STR32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putSymbol (std::string_view value_) {
+    variable (SYM8, SYM32, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putDescribed() {
+    put8 (DESCRIBED);
+    m_compounds.push_back ({ size(), 0, true });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::beginList() {
+    begin (LIST32);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::endList() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::beginMap() {
+    begin (MAP32);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::endMap() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::encoder::
+Encoder::putRaw (std::string_view bytes_) {
+    m_buffer.append (bytes_.data(), bytes_.size());
+    drain();
+}
+
+/******************************************************************************/
@@ -0,0 +1,160 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * amqp::internal::encoder::Encoder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::encoder {
+
+    /**
+     * Writes AMQP 1.0 encoded values, the other half of the Decoder.
+     *
+     * Values are appended in the order they're put. Lists and maps are
+     * opened with [beginList] or [beginMap], everything put before the
+     * matching end is one of their elements, and their size and count are
+     * filled in once they're closed. A described value is [putDescribed]
+     * followed by its descriptor and then the value itself.
+     *
+     * Lists and maps always have the 32 bit encoding, as their size isn't
+     * known when they're opened. Scalars have the most compact one their
+     * value allows, as Corda and proton write them.
+     *
+     * Without a file descriptor everything is kept in memory for [str].
+     * Given one, output is written to it whenever enough has built up. If
+     * the descriptor can be seeked everything goes, and the sizes of the
+     * compounds still open are written into the file when they close.
+     * Otherwise only what comes before the outermost open compound can
+     * be written.
+     */
+    class Encoder {
+        private :
+            struct Compound {
+                /**
+                 * Where its size is, from the start of our output
+                 */
+                uint64_t at;
+                uint32_t count;
+
+                /**
+                 * Described values aren't compounds as such but count
+                 * off their descriptor and value, and so are counted as
+                 * one value by whatever they're in
+                 */
+                bool     described;
+            };
+
+            std::string m_buffer;
+
+            int  m_fd;
+            bool m_seekable;
+
+            /**
+             * Where in the file we started
+             */
+            uint64_t m_base;
+
+            /**
+             * How much of our output has been written to [m_fd], [m_buffer]
+             * holds what comes after
+             */
+            uint64_t m_flushed;
+
+            std::vector<Compound> m_compounds;
+
+            void counted();
+
+            void put8 (uint8_t);
+            void put16 (uint16_t);
+            void put32 (uint32_t);
+            void put64 (uint64_t);
+
+            void patch32 (uint64_t, uint32_t);
+
+            void variable (uint8_t, uint8_t, std::string_view);
+
+            void begin (uint8_t);
+            void end();
+
+            void drain();
+            void write (uint64_t);
+
+        public :
+            /**
+             * @param fd_ where to write the output, -1 to keep it all in
+             * memory
+             */
+            explicit Encoder (int fd_ = -1);
+
+            Encoder (const Encoder &) = delete;
+            Encoder & operator = (const Encoder &) = delete;
+
+            ~Encoder();
+
+            void putNull();
+            void putBool (bool);
+            void putUbyte (uint8_t);
+            void putByte (int8_t);
+            void putUshort (uint16_t);
+            void putShort (int16_t);
+            void putUint (uint32_t);
+            void putInt (int32_t);
+            void putChar (uint32_t);
+            void putUlong (uint64_t);
+            void putLong (int64_t);
+            void putTimestamp (int64_t);
+            void putFloat (float);
+            void putDouble (double);
+            void putUuid (const std::array<char, 16> &);
+            void putBinary (std::string_view);
+            void putString (std::string_view);
+            void putSymbol (std::string_view);
+
+            /**
+             * The descriptor and then the value follow
+             */
+            void putDescribed();
+
+            void beginList();
+            void endList();
+
+            /**
+             * Keys and values alternate, each is an element
+             */
+            void beginMap();
+            void endMap();
+
+            /**
+             * Bytes that aren't AMQP, the Corda header say, copied out as
+             * they are. Not counted as an element of anything.
+             */
+            void putRaw (std::string_view);
+
+            /**
+             * How many bytes we've produced
+             */
+            uint64_t size() const { return m_flushed + m_buffer.size(); }
+
+            /**
+             * Everything, when we've no descriptor to write it to
+             */
+            const std::string & str() const { return m_buffer; }
+
+            /**
+             * Write out all we can, everything once nothing is left open
+             */
+            void flush();
+    };
+
+}
+
+/******************************************************************************/
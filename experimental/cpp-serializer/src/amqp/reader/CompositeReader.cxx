@@ -4,12 +4,13 @@
 #include <iostream>
 #include <assert.h>
 
-#include <proton/codec.h>
 #include <sstream>
 #include "debug.h"
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
-#include "proton/proton_wrapper.h"
+#include "Projection.h"
+#include "amqp/decoder/Decoder.h"
+#include "visitors/RecordingVisitor.h"
 
 /******************************************************************************/
 
@@ -26,16 +27,57 @@ CompositeReader::m_name { // NOLINT
 
 amqp::internal::reader::
 CompositeReader::CompositeReader (
-        std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
-) : m_readers (readers_)
-  , m_type (std::move (type_))
+        const schema::Composite & composite_,
+        const sVec<std::weak_ptr<Reader>> & readers_,
+        std::vector<Evolution::Field> evolved_
+) : m_evolved (std::move (evolved_))
+  , m_reordered (false)
+  , m_flat (true)
+  , m_type (composite_.name())
+  , m_descriptor (composite_.descriptor())
 {
-    DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
-    for (auto const reader : m_readers) {
-        assert (reader.lock());
-        if (auto r = reader.lock()) {
-            DBG ("  prop: " << r->name() << " " << r->type() << std::endl); // NOLINT
+    const auto & fields = composite_.fields();
+
+    if (fields.size() != readers_.size()) {
+        throw std::runtime_error (
+                "Reader count doesn't match fields for " + m_type);
+    }
+
+    DBG ("MAKE CompositeReader: " << m_type << ": " << readers_.size() << std::endl); // NOLINT
+
+    m_plan.reserve (fields.size());
+
+    for (size_t i { 0 } ; i < fields.size() ; ++i) {
+        auto reader = readers_[i].lock();
+
+        if (!reader) {
+            throw std::runtime_error ("null field reader: " + fields[i]->name());
+        }
+
+        DBG ("  prop: " << reader->name() << " " << reader->type() << std::endl); // NOLINT
+
+        auto name = intern (fields[i]->name());
+
+        m_plan.push_back ({ reader.get(), name, &name.str() });
+
+        if (dynamic_cast<const ObjectReader *>(reader.get())) {
+            m_flat = false;
+        }
+    }
+
+    if (!m_evolved.empty()) {
+        m_to.assign (m_plan.size(), Evolution::npos);
+
+        size_t last { 0 };
+
+        for (size_t i { 0 } ; i < m_evolved.size() ; ++i) {
+            auto from = m_evolved[i].from;
+
+            if (from == Evolution::npos) continue;
+
+            m_to[from] = i;
+            m_reordered = m_reordered || from < last;
+            last = from;
         }
     }
 }
@@ -60,7 +102,7 @@ CompositeReader::type() const  {
 
 std::any
 amqp::internal::reader::
-CompositeReader::read (pn_data_t * data_) const {
+CompositeReader::read (decoder::Decoder * data_) const {
     return std::any(1);
 }
 
@@ -68,9 +110,9 @@ CompositeReader::read (pn_data_t * data_) const {
 
 std::string
 amqp::internal::reader::
-CompositeReader::readString (pn_data_t * data_) const {
-    pn_data_next (data_);
-    proton::auto_enter ae (data_);
+CompositeReader::readString (decoder::Decoder * data_) const {
+    data_->next();
+    decoder::auto_enter ae (data_);
 
     return "Composite";
 }
@@ -78,11 +120,37 @@ CompositeReader::readString (pn_data_t * data_) const {
 /******************************************************************************/
 
 
-sVec<uPtr<amqp::reader::IValue>>
+/**
+ * Only needed when a blob describes a value with something other than the
+ * descriptor of the type we were built for
+ */
+const std::vector<uPtr<amqp::internal::schema::Field>> &
 amqp::internal::reader::
-CompositeReader::_dump (
-        pn_data_t * data_,
+CompositeReader::fieldsFor (
+        std::string_view descriptor_,
         const SchemaType & schema_
+) const {
+    const auto & it = schema_.fromDescriptor (std::string (descriptor_));
+
+    auto & fields = dynamic_cast<schema::Composite &> (
+            *(it->second.get())).fields();
+
+    if (fields.size() != m_plan.size()) {
+        throw std::runtime_error (
+                "Field count mismatch reading " + std::string (descriptor_));
+    }
+
+    return fields;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CompositeReader::visitObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
 ) const {
     DBG ("Read Composite: "
         << m_name
@@ -90,75 +158,189 @@ CompositeReader::_dump (
         << type()
         << std::endl); // NOLINT
 
-    proton::is_described (data_);
-    proton::auto_enter ae (data_);
+    decoder::auto_next an (data_);
 
-    const auto & it = schema_.fromDescriptor (
-            proton::get_symbol<std::string>(data_));
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
 
-    auto & fields = dynamic_cast<schema::Composite &> (
-            *(it->second.get())).fields();
+    decoder::is_symbol (data_);
+    auto descriptor = decoder::readAndNext<std::string_view> (data_);
 
-    assert (fields.size() == m_readers.size());
+    decoder::is_list (data_);
+    {
+        decoder::auto_enter ae (data_);
 
-    pn_data_next (data_);
+        visitor_.beginComposite (m_type);
 
-    sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+        if (!m_evolved.empty() && descriptor == m_descriptor) {
+            visitEvolved (data_, schema_, visitor_);
+        } else if (descriptor == m_descriptor) {
+            for (const auto & step : m_plan) {
+                visitor_.key (*step.key);
+                step.reader->visit (data_, schema_, visitor_);
+            }
+        } else {
+            const auto & fields = fieldsFor (descriptor, schema_);
 
-    proton::is_list (data_);
-    {
-        proton::auto_enter ae (data_);
+            for (size_t i { 0 } ; i < m_plan.size() ; ++i) {
+                visitor_.key (fields[i]->name());
+                m_plan[i].reader->visit (data_, schema_, visitor_);
+            }
+        }
 
-        for (int i (0) ; i < m_readers.size() ; ++i) {
-            if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " "
-                    << (l ? "true" : "false") << std::endl); // NOLINT
+        visitor_.endComposite();
+    }
+}
 
-                read.emplace_back (l->dump (fields[i]->name(), data_, schema_));
+/******************************************************************************/
+
+/**
+ * Our fields come off the wire in the order they were written, each is
+ * passed straight on if it's the next one to be reported and otherwise
+ * recorded, to be played back once its turn comes. Where nothing has
+ * moved, only been added or dropped, nothing is ever recorded.
+ */
+void
+amqp::internal::reader::
+CompositeReader::visitEvolved (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    std::vector<RecordingVisitor> held (m_reordered ? m_evolved.size() : 0);
+
+    size_t next { 0 };
+
+    // report everything we can up to the first field we've not yet seen
+    auto flush = [&]() {
+        for ( ; next < m_evolved.size() ; ++next) {
+            const auto & field = m_evolved[next];
+
+            if (field.from == Evolution::npos) {
+                visitor_.key (field.name);
+                visitor_.nullValue();
+            } else if (m_reordered && held[next].size()) {
+                visitor_.key (field.name);
+                held[next].replay (visitor_);
             } else {
-                std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
-                throw std::runtime_error (s.str());
+                break;
             }
         }
+    };
+
+    flush();
+
+    for (size_t i { 0 } ; i < m_plan.size() ; ++i) {
+        auto to = m_to[i];
+
+        if (to == Evolution::npos) {
+            m_plan[i].reader->skip (data_, schema_);
+        } else if (to == next) {
+            visitor_.key (m_evolved[to].name);
+            m_plan[i].reader->visit (data_, schema_, visitor_);
+
+            ++next;
+            flush();
+        } else {
+            m_plan[i].reader->visit (data_, schema_, held[to]);
+        }
     }
 
-    return read;
+    flush();
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-CompositeReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    proton::auto_next an (data_);
+CompositeReader::projectObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        const Selection & selection_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    decoder::auto_next an (data_);
+
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
 
-    return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>> (
-        name_,
-        _dump(data_, schema_));
+    decoder::is_symbol (data_);
+    auto descriptor = decoder::readAndNext<std::string_view> (data_);
+
+    const auto * fields = descriptor == m_descriptor
+        ? nullptr
+        : &fieldsFor (descriptor, schema_);
+
+    decoder::is_list (data_);
+    {
+        decoder::auto_enter ae (data_);
+
+        visitor_.beginComposite (m_type);
+
+        for (size_t i { 0 } ; i < m_plan.size() ; ++i) {
+            if (const auto * selected = selection_.field (i)) {
+                visitor_.key (fields ? (*fields)[i]->name() : *m_plan[i].key);
+                m_plan[i].reader->project (data_, schema_, *selected, visitor_);
+            } else {
+                m_plan[i].reader->skip (data_, schema_);
+            }
+        }
+
+        visitor_.endComposite();
+    }
 }
 
 /******************************************************************************/
 
-/**
- *
- */
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-CompositeReader::dump (
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    proton::auto_next an (data_);
+CompositeReader::skipObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_
+) const {
+    if (m_flat) {
+        data_->next();
+        return;
+    }
+
+    decoder::auto_next an (data_);
+
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
+
+    decoder::is_symbol (data_);
+    auto descriptor = decoder::readAndNext<std::string_view> (data_);
+
+    if (descriptor != m_descriptor) {
+        fieldsFor (descriptor, schema_);
+    }
 
-    return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>> (
-        _dump (data_, schema_));
+    decoder::is_list (data_);
+    {
+        decoder::auto_enter ae (data_);
+
+        for (const auto & step : m_plan) {
+            step.reader->skip (data_, schema_);
+        }
+    }
 }
 
 /******************************************************************************/
 
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+CompositeReader::field (std::string_view name_, size_t & index_) const {
+    // a name that was never interned can't be one of our fields
+    auto name = Symbols::instance().find (name_);
+
+    for (size_t i { 0 } ; i < m_plan.size() ; ++i) {
+        if (m_plan[i].name == name) {
+            index_ = i;
+            return m_plan[i].reader;
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
@@ -8,46 +8,106 @@
 #include <vector>
 #include <iostream>
 #include <amqp/schema/described-types/Schema.h>
+#include <amqp/schema/described-types/Composite.h>
+
+#include "amqp/Symbols.h"
+#include "amqp/Evolution.h"
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
-    class CompositeReader : public Reader {
+    class CompositeReader : public ObjectReader {
         private :
-            std::vector<std::weak_ptr<Reader>> m_readers;
+            /**
+             * One step per field, everything we need to read it worked out
+             * up front so reading a value costs no lookups. The readers are
+             * owned by the factory that built us and live as long as it does.
+             * The field's name is interned, [key] being the symbol's text
+             * which the intern table never moves, held so reporting it
+             * costs neither a copy nor the table's lock.
+             */
+            struct Step {
+                const Reader *      reader;
+                Symbol              name;
+                const std::string * key;
+            };
+
+            std::vector<Step> m_plan;
+
+            /**
+             * Only set when we're reading values written with another
+             * version of our type, the fields as they're to be reported
+             * and, for each of ours, where among them it goes, npos if
+             * it's dropped
+             */
+            std::vector<Evolution::Field> m_evolved;
+            std::vector<size_t> m_to;
+
+            /**
+             * Whether the fields we keep come in a different order to the
+             * one they're reported in, in which case some will have to be
+             * held back until the ones before them have been seen
+             */
+            bool m_reordered;
+
+            /**
+             * None of our fields are objects in their own right so we can
+             * be skipped over whole. Primitive fields never are, it's only
+             * as elements that Corda numbers them.
+             */
+            bool m_flat;
 
             static const std::string m_name;
 
             std::string m_type;
+            std::string m_descriptor;
+
+            const std::vector<uPtr<schema::Field>> & fieldsFor (
+                std::string_view,
+                const SchemaType &) const;
+
+            void visitEvolved (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const;
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void projectObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const override;
+
+            void skipObject (
+                decoder::Decoder *,
+                const SchemaType &) const override;
 
         public :
+            /**
+             * @param evolved_ set to read the composite as another version
+             * of it, see [Evolution::fields]
+             */
             CompositeReader (
-                std::string,
-                std::vector<std::weak_ptr<Reader>> &);
+                const schema::Composite &,
+                const std::vector<std::weak_ptr<Reader>> &,
+                std::vector<Evolution::Field> evolved_ = { });
 
             ~CompositeReader() override = default;
 
-            std::any read (pn_data_t *) const override;
+            std::any read (decoder::Decoder *) const override;
 
-            std::string readString (pn_data_t *) const override;
-
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
-
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override;
+            std::string readString (decoder::Decoder *) const override;
 
             const std::string & name() const override;
             const std::string & type() const override;
 
-        private :
-            std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
-                pn_data_t *,
-                const SchemaType &) const;
+            const Reader * field (std::string_view, size_t &) const override;
     };
 
 }
@@ -0,0 +1,370 @@
+#include "Projection.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Selection
+ *
+ ******************************************************************************/
+
+namespace {
+
+    using Children = std::vector<std::pair<size_t,
+            uPtr<amqp::internal::reader::Selection>>>;
+
+    Children::const_iterator
+    lookup (const Children & children_, size_t i_) {
+        return std::lower_bound (
+                children_.begin(),
+                children_.end(),
+                i_,
+                [](const auto & child_, size_t i_) { return child_.first < i_; });
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Selection &
+amqp::internal::reader::
+Selection::child (Children & children_, size_t i_) {
+    auto it = lookup (children_, i_);
+
+    if (it == children_.end() || it->first != i_) {
+        it = children_.emplace (it, i_, std::make_unique<Selection>());
+    }
+
+    return *it->second;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Selection *
+amqp::internal::reader::
+Selection::field (size_t i_) const {
+    auto it = lookup (m_fields, i_);
+
+    return it == m_fields.end() || it->first != i_ ? nullptr : it->second.get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Selection *
+amqp::internal::reader::
+Selection::element (size_t i_) const {
+    auto it = lookup (m_elements, i_);
+
+    return it == m_elements.end() || it->first != i_
+        ? m_every.get()
+        : it->second.get();
+}
+
+/******************************************************************************/
+
+/**
+ * Want everything [selection_] does as well as whatever we already did
+ */
+void
+amqp::internal::reader::
+Selection::merge (const Selection & selection_) {
+    if (m_whole) {
+        return;
+    }
+
+    if (selection_.m_whole) {
+        m_whole = true;
+        m_fields.clear();
+        m_elements.clear();
+        m_every.reset();
+
+        return;
+    }
+
+    for (const auto & field : selection_.m_fields) {
+        child (m_fields, field.first).merge (*field.second);
+    }
+
+    for (const auto & element : selection_.m_elements) {
+        child (m_elements, element.first).merge (*element.second);
+    }
+
+    if (selection_.m_every) {
+        if (!m_every) {
+            m_every = std::make_unique<Selection>();
+        }
+
+        m_every->merge (*selection_.m_every);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * An element picked out by position is still one of every element, so
+ * anything wanted of all of them is wanted of it as well
+ */
+void
+amqp::internal::reader::
+Selection::spread() {
+    if (m_every) {
+        for (auto & element : m_elements) {
+            element.second->merge (*m_every);
+        }
+
+        m_every->spread();
+    }
+
+    for (auto & field : m_fields) {
+        field.second->spread();
+    }
+
+    for (auto & element : m_elements) {
+        element.second->spread();
+    }
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Projection
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * Passes everything on bar the object numbering, that's meaningless
+     * once parts of the blob have been skipped, so references are always
+     * followed
+     */
+    class Expanding : public amqp::reader::IVisitor {
+        private :
+            amqp::reader::IVisitor & m_visitor;
+
+        public :
+            explicit Expanding (amqp::reader::IVisitor & visitor_)
+                : m_visitor (visitor_)
+            { }
+
+            void beginComposite (const std::string & type_) override {
+                m_visitor.beginComposite (type_);
+            }
+
+            void endComposite() override { m_visitor.endComposite(); }
+
+            void beginList() override { m_visitor.beginList(); }
+            void endList() override { m_visitor.endList(); }
+
+            void beginMap() override { m_visitor.beginMap(); }
+            void endMap() override { m_visitor.endMap(); }
+
+            void key (const std::string & key_) override {
+                m_visitor.key (key_);
+            }
+
+            void intValue (int32_t value_) override {
+                m_visitor.intValue (value_);
+            }
+
+            void longValue (int64_t value_) override {
+                m_visitor.longValue (value_);
+            }
+
+            void boolValue (bool value_) override {
+                m_visitor.boolValue (value_);
+            }
+
+            void doubleValue (double value_) override {
+                m_visitor.doubleValue (value_);
+            }
+
+            void stringValue (std::string_view value_) override {
+                m_visitor.stringValue (value_);
+            }
+
+            void enumValue (std::string_view value_) override {
+                m_visitor.enumValue (value_);
+            }
+
+            void binaryValue (std::string_view value_) override {
+                m_visitor.binaryValue (value_);
+            }
+
+            void numberValue (std::string_view value_) override {
+                m_visitor.numberValue (value_);
+            }
+
+            void nullValue() override {
+                m_visitor.nullValue();
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+Projection::Projection (std::vector<std::string> paths_)
+    : m_paths (std::move (paths_))
+{
+    if (m_paths.empty()) {
+        throw std::runtime_error ("Empty projection");
+    }
+
+    for (const auto & path : m_paths) {
+        m_steps.push_back (parse (path));
+    }
+}
+
+/******************************************************************************/
+
+std::vector<amqp::internal::reader::Projection::Step>
+amqp::internal::reader::
+Projection::parse (const std::string & path_) {
+    auto bad = [&path_](const std::string & why_) {
+        return std::runtime_error (
+                "Bad projection \"" + path_ + "\", " + why_);
+    };
+
+    std::vector<Step> steps;
+
+    size_t i { 0 };
+
+    while (i < path_.size()) {
+        if (path_[i] == '[') {
+            auto close = path_.find (']', i);
+
+            if (close == std::string::npos) {
+                throw bad ("unterminated subscript");
+            }
+
+            auto subscript = path_.substr (i + 1, close - i - 1);
+
+            if (subscript == "*") {
+                steps.push_back ({ "", npos });
+            } else if (!subscript.empty()
+                && subscript.find_first_not_of ("0123456789") == std::string::npos
+            ) {
+                steps.push_back ({ "", std::stoul (subscript) });
+            } else {
+                throw bad ("subscripts are an index or *");
+            }
+
+            i = close + 1;
+        } else {
+            auto end = std::min (path_.find_first_of (".[", i), path_.size());
+
+            if (end == i) {
+                throw bad ("missing field name");
+            }
+
+            steps.push_back ({ path_.substr (i, end - i), 0 });
+
+            i = end;
+        }
+
+        if (i < path_.size() && path_[i] == '.') {
+            if (++i == path_.size()) {
+                throw bad ("missing field name");
+            }
+        } else if (i < path_.size() && path_[i] != '[') {
+            throw bad ("expected . or [ after a subscript");
+        }
+    }
+
+    if (steps.empty()) {
+        throw bad ("nothing to select");
+    }
+
+    return steps;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::Selection
+amqp::internal::reader::
+Projection::compile (const Reader & reader_) const {
+    Selection root;
+
+    for (size_t p { 0 } ; p < m_paths.size() ; ++p) {
+        const Reader * reader = &reader_;
+
+        // once something is wanted in full there's no need to go any
+        // deeper, but we still check the rest of the path exists
+        Selection * selection = &root;
+
+        for (const auto & step : m_steps[p]) {
+            if (selection && selection->whole()) {
+                selection = nullptr;
+            }
+
+            const Reader * next;
+
+            if (!step.name.empty()) {
+                size_t field;
+
+                if (!(next = reader->field (step.name, field))) {
+                    throw std::runtime_error (
+                            m_paths[p] + ": " + reader->type()
+                                + " has no field " + step.name);
+                }
+
+                if (selection) {
+                    selection = &Selection::child (selection->m_fields, field);
+                }
+            } else {
+                if (!(next = reader->element())) {
+                    throw std::runtime_error (
+                            m_paths[p] + ": " + reader->type()
+                                + " has no elements");
+                }
+
+                if (selection && step.index == npos) {
+                    if (!selection->m_every) {
+                        selection->m_every = std::make_unique<Selection>();
+                    }
+
+                    selection = selection->m_every.get();
+                } else if (selection) {
+                    selection = &Selection::child (
+                            selection->m_elements, step.index);
+                }
+            }
+
+            reader = next;
+        }
+
+        if (selection) {
+            Selection whole;
+            whole.m_whole = true;
+
+            selection->merge (whole);
+        }
+    }
+
+    root.spread();
+
+    return root;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Projection::visit (
+        const Reader & reader_,
+        decoder::Decoder * data_,
+        const Reader::SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    auto selection = compile (reader_);
+
+    Expanding expanding (visitor_);
+
+    reader_.project (data_, schema_, selection, expanding);
+}
+
+/******************************************************************************/
@@ -0,0 +1,157 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::decoder {
+
+    class Decoder;
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Selection
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The parts of a single value a [Projection] wants, compiled against the
+     * readers that will be reading it so that picking them out as we go is
+     * no more than a lookup by position.
+     *
+     * Either the whole value is wanted or only some of its fields, or of its
+     * elements, each of those with a selection of its own.
+     */
+    class Selection {
+        private :
+            using Children = std::vector<std::pair<size_t, uPtr<Selection>>>;
+
+            bool m_whole;
+
+            /**
+             * By field number for a composite, sorted
+             */
+            Children m_fields;
+
+            /**
+             * By position for a list, array or map, sorted
+             */
+            Children m_elements;
+
+            /**
+             * What we want of any element not in [m_elements]
+             */
+            uPtr<Selection> m_every;
+
+            static Selection & child (Children &, size_t);
+
+            void merge (const Selection &);
+            void spread();
+
+            friend class Projection;
+
+        public :
+            Selection() : m_whole (false) { }
+
+            bool whole() const { return m_whole; }
+
+            /**
+             * @return what's wanted of the [i_]th field, nullptr for nothing
+             */
+            const Selection * field (size_t i_) const;
+
+            /**
+             * @return what's wanted of the [i_]th element, nullptr for nothing
+             */
+            const Selection * element (size_t i_) const;
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Projection
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A set of paths into a blob, only the values at the end of which we
+     * want decoding. Everything else is skipped over, where the encoding
+     * allows without looking inside it at all.
+     *
+     * Paths are written relative to the top level object as field names
+     * separated by dots, each of which may be followed by any number of
+     * subscripts picking out elements of lists, arrays and maps, an index
+     * or * for all of them
+     *
+     *      owner
+     *      amount.quantity
+     *      a.b[3].c
+     *      outputs[*].owner
+     *
+     * What's selected comes out in the same shape it has in the blob,
+     * composites with only the selected fields, lists with only the
+     * selected elements and, for maps, the selected entries with their keys.
+     */
+    class Projection {
+        private :
+            struct Step {
+                /**
+                 * Empty for a subscript
+                 */
+                std::string name;
+
+                /**
+                 * Of a subscript, npos meaning all of them
+                 */
+                size_t index;
+            };
+
+            std::vector<std::string>       m_paths;
+            std::vector<std::vector<Step>> m_steps;
+
+            static std::vector<Step> parse (const std::string &);
+
+        public :
+            static constexpr size_t npos = ~static_cast<size_t>(0);
+
+            explicit Projection (std::vector<std::string>);
+
+            const std::vector<std::string> & paths() const { return m_paths; }
+
+            /**
+             * Work out what we want of a value [reader_] reads, throws if
+             * any of the paths don't exist in it
+             */
+            Selection compile (const Reader & reader_) const;
+
+            /**
+             * Visit only the selected parts of the value under the cursor,
+             * leaving the cursor on the next value.
+             *
+             * Everything selected is written out in full, references
+             * included, since whatever they refer to may well not have been.
+             */
+            void visit (
+                const Reader &,
+                decoder::Decoder *,
+                const Reader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+    };
+
+}
+
+/******************************************************************************/
@@ -5,15 +5,23 @@
 #include "amqp/reader/property-readers/LongPropertyReader.h"
 #include "amqp/reader/property-readers/StringPropertyReader.h"
 #include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/FloatPropertyReader.h"
+#include "amqp/reader/property-readers/CharPropertyReader.h"
+#include "amqp/reader/property-readers/IntegralPropertyReader.h"
+#include "amqp/reader/property-readers/DecimalPropertyReader.h"
+#include "amqp/reader/property-readers/TimestampPropertyReader.h"
+#include "amqp/reader/property-readers/UUIDPropertyReader.h"
+#include "amqp/reader/property-readers/BinaryPropertyReader.h"
+#include "amqp/reader/property-readers/SymbolPropertyReader.h"
 
-#include <map>
 #include <string>
 #include <iostream>
+#include <stdexcept>
 #include <functional>
 
-#include <proton/codec.h>
+#include "amqp/SymbolMap.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************/
 
@@ -21,36 +29,81 @@ namespace {
 
     using namespace amqp::internal::reader;
 
-    std::map<
-            std::string,
-            std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
-    > propertyMap = { // NOLINT
-        {
-            "int", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<IntPropertyReader> ();
-            }
-        },
-        {
-            "string", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<StringPropertyReader> ();
-            }
-        },
-        {
-            "boolean", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<BoolPropertyReader> ();
-            }
-        },
-        {
-            "long", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<LongPropertyReader> ();
-            }
-        },
-        {
-            "double", []() -> std::shared_ptr<PropertyReader> {
-                return std::make_shared<DoublePropertyReader> ();
+    using PropertyReaderFactory = std::shared_ptr<PropertyReader>(*)();
+
+    template<class T>
+    std::shared_ptr<PropertyReader>
+    make() {
+        return std::make_shared<T>();
+    }
+
+    struct Property {
+        const char *          type;
+        PropertyReaderFactory make;
+
+        /**
+         * Whether the JVM numbers a value of this type written as an
+         * element or entry, everything but its own primitives, boxed or
+         * not, and byte arrays
+         */
+        bool                  numbered;
+    };
+
+    /**
+     * Every AMQP primitive, under the name Corda gives it in a schema
+     */
+    const Property properties[] = {
+        { "int",        make<IntPropertyReader>,                false },
+        { "string",     make<StringPropertyReader>,             true  },
+        { "boolean",    make<BoolPropertyReader>,               false },
+        { "long",       make<LongPropertyReader>,               false },
+        { "double",     make<DoublePropertyReader>,             false },
+        { "float",      make<FloatPropertyReader>,              false },
+        { "char",       make<CharPropertyReader>,               false },
+        { "byte",       make<IntegralPropertyReader<int8_t>>,   false },
+        { "short",      make<IntegralPropertyReader<int16_t>>,  false },
+        { "ubyte",      make<IntegralPropertyReader<uint8_t>>,  true  },
+        { "ushort",     make<IntegralPropertyReader<uint16_t>>, true  },
+        { "uint",       make<IntegralPropertyReader<uint32_t>>, true  },
+        { "ulong",      make<IntegralPropertyReader<uint64_t>>, true  },
+        { "decimal32",  make<DecimalPropertyReader<32>>,        true  },
+        { "decimal64",  make<DecimalPropertyReader<64>>,        true  },
+        { "decimal128", make<DecimalPropertyReader<128>>,       true  },
+        { "timestamp",  make<TimestampPropertyReader>,          true  },
+        { "uuid",       make<UUIDPropertyReader>,               true  },
+        { "binary",     make<BinaryPropertyReader>,             false },
+        { "symbol",     make<SymbolPropertyReader>,             true  }
+    };
+
+    /**
+     * Keyed on the interned primitive type names
+     */
+    const amqp::internal::SymbolMap<const Property *> &
+    propertyMap() {
+        static const auto map = [] {
+            amqp::internal::SymbolMap<const Property *> rtn;
+
+            for (const auto & property : properties) {
+                rtn.emplace (amqp::internal::intern (property.type), &property);
             }
+
+            return rtn;
+        }();
+
+        return map;
+    }
+
+    const Property &
+    property (const std::string & type_) {
+        auto it = propertyMap().find (
+                amqp::internal::Symbols::instance().find (type_));
+
+        if (it == propertyMap().end()) {
+            throw std::runtime_error ("No property reader for " + type_);
         }
-    };
+
+        return *it->second;
+    }
 
 }
 
@@ -63,7 +116,7 @@ namespace {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+    return property (field_->type()).make();
 }
 
 /******************************************************************************/
@@ -71,7 +124,7 @@ PropertyReader::make (const FieldPtr & field_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+    return property (type_).make();
 }
 
 /******************************************************************************/
@@ -79,7 +132,15 @@ PropertyReader::make (const std::string & type_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const internal::schema::Field & field_) {
-    return propertyMap[field_.type()]();
+    return property (field_.type()).make();
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+PropertyReader::numbered (const std::string & type_) {
+    return property (type_).numbered;
 }
 
 /******************************************************************************/
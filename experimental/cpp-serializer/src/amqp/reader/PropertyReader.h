@@ -22,23 +22,28 @@ namespace amqp::internal::reader {
             static std::shared_ptr<PropertyReader> make (const FieldPtr &);
             static std::shared_ptr<PropertyReader> make (const std::string &);
 
+            /**
+             * Corda never numbers a primitive that's the field of a
+             * composite, but when one's an element of a list or array, or
+             * a key or value of a map, it's written as any other object
+             * would be and numbered unless it's one of the JVM's own.
+             *
+             * @return whether values of the named primitive type are
+             * numbered as elements
+             */
+            static bool numbered (const std::string &);
+
             PropertyReader() = default;
             ~PropertyReader() override = default;
 
-            std::string readString (pn_data_t *) const override = 0;
+            std::string readString (decoder::Decoder *) const override = 0;
 
-            std::any read (pn_data_t *) const override = 0;
+            std::any read (decoder::Decoder *) const override = 0;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &
-            ) const override = 0;
-
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &
-            ) const override = 0;
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
 
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
@@ -48,4 +53,3 @@ namespace amqp::internal::reader {
 
 /******************************************************************************/
 
-
@@ -1,90 +1,139 @@
 #include "Reader.h"
 
+#include <list>
+#include <vector>
 #include <memory>
-#include <sstream>
+#include <memory_resource>
+
+#include "Projection.h"
+#include "visitors/TreeVisitor.h"
+
+#include "amqp/decoder/Decoder.h"
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
 
 /******************************************************************************/
 
 namespace {
 
-    struct AutoMap {
-        std::stringstream & m_stream;
+    struct AsMap {
+        static constexpr const char * open = "{ ";
+        static constexpr const char * close = " }";
+    };
 
-        AutoMap (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : { ";
-        }
+    struct AsList {
+        static constexpr const char * open = "[ ";
+        static constexpr const char * close = " ]";
+    };
 
-        explicit AutoMap (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "{ ";
-        }
+    template<class As, class T>
+    void
+    dumpSingle (std::string & out_, const T & begin_, const T & end_) {
+        out_.append (As::open);
 
-        ~AutoMap() {
-            m_stream << " }";
+        for (auto it (begin_) ; it != end_ ; ++it) {
+            if (it != begin_) {
+                out_.append (", ");
+            }
+
+            (*it)->dumpTo (out_);
         }
-    };
 
-    struct AutoList {
-        std::stringstream & m_stream;
+        out_.append (As::close);
+    }
 
-        AutoList (
-                const std::string & s,
-                std::stringstream & stream_
-        ) : m_stream (stream_) {
-            m_stream << s << " : [ ";
-        }
+    template<class As, class T>
+    void
+    dumpPair (
+        std::string & out_,
+        std::string_view name_,
+        const T & begin_,
+        const T & end_
+    ) {
+        out_.append (name_).append (" : ");
+        dumpSingle<As> (out_, begin_, end_);
+    }
 
-        explicit AutoList (std::stringstream & stream_)
-            : m_stream (stream_)
-        {
-            m_stream << "[ ";
-        }
+}
 
-        ~AutoList() {
-            m_stream << " ]";
-        }
+/******************************************************************************
+ *
+ * amqp::internal::reader::Value
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * Sits in front of every Value so we know how to give the memory back
+     */
+    struct alignas (std::max_align_t) Header {
+        std::pmr::memory_resource * resource;
+        size_t size;
     };
 
-    template<class Auto, class T>
-    std::string
-    dumpPair (const std::string & name_, const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (name_, rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
-            }
-        }
+}
 
-        return rtn.str();
-    }
+/******************************************************************************/
 
-    template<class Auto, class T>
-    std::string
-    dumpSingle (const T & begin_, const T & end_) {
-        std::stringstream rtn;
-        {
-            Auto am (rtn);
-
-            if (begin_ != end_) {
-                rtn << (*(begin_))->dump();
-                for (auto it(std::next(begin_)); it != end_; ++it) {
-                    rtn << ", " << (*it)->dump();
-                }
-            }
-        }
+void *
+amqp::internal::reader::
+Value::operator new (size_t size_) {
+    return operator new (size_, std::pmr::new_delete_resource());
+}
+
+/******************************************************************************/
+
+void *
+amqp::internal::reader::
+Value::operator new (size_t size_, std::pmr::memory_resource * resource_) {
+    auto size = sizeof (Header) + size_;
+    auto header = static_cast<Header *>(
+            resource_->allocate (size, alignof (Header)));
+
+    header->resource = resource_;
+    header->size = size;
 
-        return rtn.str();
+    return header + 1;
+}
+
+/******************************************************************************/
+
+/**
+ * For an arena this does nothing at all, the memory goes when the arena does
+ */
+void
+amqp::internal::reader::
+Value::operator delete (void * value_) {
+    if (!value_) {
+        return;
     }
 
+    auto header = static_cast<Header *>(value_) - 1;
+
+    header->resource->deallocate (header, header->size, alignof (Header));
+}
+
+/******************************************************************************/
+
+/**
+ * Only called if a constructor throws
+ */
+void
+amqp::internal::reader::
+Value::operator delete (void * value_, std::pmr::memory_resource *) {
+    operator delete (value_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+Value::dump() const {
+    std::string rtn;
+    dumpTo (rtn);
+
+    return rtn;
 }
 
 /******************************************************************************
@@ -93,14 +142,12 @@ namespace {
  *
  ******************************************************************************/
 
-std::string
+void
 amqp::internal::reader::
-ValuePair::dump() const {
-    std::stringstream ss;
-
-    ss << m_key->dump() << " : " << m_value->dump();
-
-    return ss.str();
+ValuePair::dumpTo (std::string & out_) const {
+    m_key->dumpTo (out_);
+    out_.append (" : ");
+    m_value->dumpTo (out_);
 }
 
 /******************************************************************************
@@ -110,31 +157,45 @@ ValuePair::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsMap> (out_, m_property, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsMap> (out_, m_property, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoMap> (m_property, m_value.begin(), m_value.end());
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsMap> (out_, m_property, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
+amqp::internal::reader::
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsList> (out_, m_property, m_value.begin(), m_value.end());
+}
+
+template<>
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpPair<AutoList> (m_property, m_value.begin(), m_value.end());
+TypedPair<std::pmr::vector<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsMap> (out_, m_property, m_value.begin(), m_value.end());
+}
+
+template<>
+void
+amqp::internal::reader::
+TypedPair<std::pmr::list<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpPair<AsList> (out_, m_property, m_value.begin(), m_value.end());
 }
 
 /******************************************************************************
@@ -144,31 +205,285 @@ TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const {
  ******************************************************************************/
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsList> (out_, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsMap> (out_, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoList> (m_value.begin(), m_value.end());
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsList> (out_, m_value.begin(), m_value.end());
 }
 
 template<>
-std::string
+void
+amqp::internal::reader::
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsMap> (out_, m_value.begin(), m_value.end());
+}
+
+template<>
+void
+amqp::internal::reader::
+TypedSingle<std::pmr::vector<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsMap> (out_, m_value.begin(), m_value.end());
+}
+
+template<>
+void
+amqp::internal::reader::
+TypedSingle<std::pmr::list<uPtr<amqp::reader::IValue>>>::dumpTo (std::string & out_) const {
+    ::dumpSingle<AsList> (out_, m_value.begin(), m_value.end());
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Reader
+ *
+ ******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Reader::dump (
+    const std::string & name_,
+    decoder::Decoder * data_,
+    const SchemaType & schema_) const
+{
+    TreeVisitor visitor;
+
+    visitor.key (name_);
+    visit (data_, schema_, visitor);
+
+    return visitor.result();
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Reader::dump (
+    decoder::Decoder * data_,
+    const SchemaType & schema_) const
+{
+    TreeVisitor visitor;
+
+    visit (data_, schema_, visitor);
+
+    return visitor.result();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+Reader::field (std::string_view, size_t &) const {
+    return nullptr;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+Reader::element() const {
+    return nullptr;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Reader::project (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        const Selection &,
+        amqp::reader::IVisitor & visitor_
+) const {
+    visit (data_, schema_, visitor_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Reader::skip (decoder::Decoder * data_, const SchemaType &) const {
+    data_->next();
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::ObjectReader
+ *
+ ******************************************************************************/
+
+namespace {
+
+    /**
+     * A reference is written as a uint described by REFERENCED_OBJECT
+     */
+    bool
+    isReference (amqp::internal::decoder::Decoder * data_, size_t & object_) {
+        namespace decoder = amqp::internal::decoder;
+
+        if (data_->type() != decoder::described_t) {
+            return false;
+        }
+
+        decoder::auto_enter ae (data_);
+
+        if (data_->type() != decoder::ulong_t
+            || amqp::stripCorda (data_->get_ulong())
+                != static_cast<uint32_t>(amqp::schema::descriptors::REFERENCED_OBJECT)
+        ) {
+            return false;
+        }
+
+        data_->next();
+        object_ = data_->get_uint();
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Objects are numbered once they've been read, so anything inside one comes
+ * before it. Unless the visitor can make use of what it was handed the
+ * first time a reference is read by going back and reading the original
+ * again.
+ */
+void
+amqp::internal::reader::
+ObjectReader::visit (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    size_t object;
+
+    if (isReference (data_, object)) {
+        decoder::auto_next an (data_);
+
+        if (!visitor_.reference (object)) {
+            data_->recall (object);
+            visitObject (data_, schema_, visitor_);
+            data_->exit();
+        }
+
+        return;
+    }
+
+    auto offset = data_->offset();
+
+    visitObject (data_, schema_, visitor_);
+
+    if (!data_->recalling()) {
+        visitor_.object (data_->remember (offset));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Where only part of an object is wanted it's never worth the visitor
+ * knowing about it, nor about references to it, it'd only ever have part
+ * of it to hand.
+ */
+void
+amqp::internal::reader::
+ObjectReader::project (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        const Selection & selection_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    if (selection_.whole()) {
+        visit (data_, schema_, visitor_);
+        return;
+    }
+
+    size_t object;
+
+    if (isReference (data_, object)) {
+        decoder::auto_next an (data_);
+
+        data_->recall (object);
+        projectObject (data_, schema_, selection_, visitor_);
+        data_->exit();
+
+        return;
+    }
+
+    auto offset = data_->offset();
+
+    projectObject (data_, schema_, selection_, visitor_);
+
+    if (!data_->recalling()) {
+        data_->remember (offset);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ObjectReader::skip (
+        decoder::Decoder * data_,
+        const SchemaType & schema_
+) const {
+    size_t object;
+
+    if (isReference (data_, object)) {
+        data_->next();
+        return;
+    }
+
+    auto offset = data_->offset();
+
+    skipObject (data_, schema_);
+
+    if (!data_->recalling()) {
+        data_->remember (offset);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ObjectReader::projectObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        const Selection &,
+        amqp::reader::IVisitor & visitor_
+) const {
+    visitObject (data_, schema_, visitor_);
+}
+
+/******************************************************************************/
+
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
-    return ::dumpSingle<AutoMap> (m_value.begin(), m_value.end());
+ObjectReader::skipObject (
+        decoder::Decoder * data_,
+        const SchemaType &
+) const {
+    data_->next();
 }
 
 /******************************************************************************/
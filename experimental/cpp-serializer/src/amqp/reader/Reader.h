@@ -7,9 +7,12 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <string_view>
+#include <memory_resource>
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/reader/IReader.h"
+#include "amqp/Format.h"
 
 /******************************************************************************/
 
@@ -17,13 +20,30 @@ namespace amqp::internal::reader {
 
     class Value : public amqp::reader::IValue {
         public :
-            std::string dump() const override = 0;
+            /**
+             * Implemented in terms of [dumpTo]
+             */
+            std::string dump() const override;
+
+            void dumpTo (std::string &) const override = 0;
 
             ~Value() override = default;
+
+            /**
+             * Values can be placed in a memory resource, typically an arena
+             * that'll be released in one go once the tree is finished with.
+             * Each allocation records where it came from so the usual
+             * delete, through a unique_ptr or otherwise, works either way.
+             */
+            static void * operator new (size_t);
+            static void * operator new (size_t, std::pmr::memory_resource *);
+
+            static void operator delete (void *);
+            static void operator delete (void *, std::pmr::memory_resource *);
     };
 
     /*
-     * A Single represents some value read out of a proton tree that
+     * A Single represents some value read out of an AMQP stream that
      * exists without an association. The canonical example is an
      * element of a list. The list itself would be a pair,
      *
@@ -37,7 +57,7 @@ namespace amqp::internal::reader {
      */
     class Single : public Value {
         public :
-            std::string dump() const override = 0;
+            void dumpTo (std::string &) const override = 0;
 
             ~Single() override = default;
     };
@@ -67,7 +87,7 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            void dumpTo (std::string &) const override;
     };
 
     /*
@@ -77,12 +97,18 @@ namespace amqp::internal::reader {
      */
     class Pair : public Value {
         protected :
-            std::string m_property;
+            std::pmr::string m_property;
 
         public:
-            explicit Pair (std::string property_)
-                : Value()
-                , m_property (std::move (property_))
+            /**
+             * @param resource_ where the property name is kept, for a pair
+             * placed in an arena that should be the arena as well
+             */
+            explicit Pair (
+                std::string_view property_,
+                std::pmr::memory_resource * resource_ = std::pmr::get_default_resource()
+            ) : Value()
+              , m_property (property_, resource_)
             { }
 
             ~Pair() override = default;
@@ -91,7 +117,7 @@ namespace amqp::internal::reader {
                 : m_property (std::move (pair_.m_property))
             { }
 
-            std::string dump() const override = 0;
+            void dumpTo (std::string &) const override = 0;
     };
 
 
@@ -101,18 +127,24 @@ namespace amqp::internal::reader {
             T m_value;
 
         public:
-            TypedPair (const std::string & property_, T & value_)
-                : Pair (property_)
-                , m_value (value_)
+            TypedPair (
+                std::string_view property_,
+                T & value_,
+                std::pmr::memory_resource * resource_ = std::pmr::get_default_resource()
+            ) : Pair (property_, resource_)
+              , m_value (value_)
             { }
 
-            TypedPair (const std::string & property_, T && value_)
-                : Pair (property_)
-                , m_value (std::move (value_))
+            TypedPair (
+                std::string_view property_,
+                T && value_,
+                std::pmr::memory_resource * resource_ = std::pmr::get_default_resource()
+            ) : Pair (property_, resource_)
+              , m_value (std::move (value_))
             { }
 
             TypedPair (TypedPair && pair_) noexcept
-                : Pair (std::move (pair_.m_property))
+                : Pair (std::move (pair_))
                 , m_value (std::move (pair_.m_value))
             { }
 
@@ -120,7 +152,7 @@ namespace amqp::internal::reader {
                 return m_value;
             }
 
-            std::string dump() const override;
+            void dumpTo (std::string &) const override;
     };
 
     /**
@@ -143,7 +175,7 @@ namespace amqp::internal::reader {
               , m_value (std::move (value_))
         { }
 
-        std::string dump() const override;
+        void dumpTo (std::string &) const override;
     };
 
 }
@@ -155,38 +187,55 @@ namespace amqp::internal::reader {
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
+amqp::internal::reader::
+TypedSingle<T>::dumpTo (std::string & out_) const {
+    appendNumber (out_, m_value);
+}
+
+template<>
+inline void
 amqp::internal::reader::
-TypedSingle<T>::dump() const {
-    return std::to_string (m_value);
+TypedSingle<std::string>::dumpTo (std::string & out_) const {
+    out_.append (m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedSingle<std::string>::dump() const {
-    return m_value;
+TypedSingle<std::pmr::string>::dumpTo (std::string & out_) const {
+    out_.append (m_value.data(), m_value.size());
 }
 
 template<>
-std::string
+void
+amqp::internal::reader::
+TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
+
+template<>
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
+TypedSingle<std::pmr::vector<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
+
+template<>
+void
+amqp::internal::reader::
+TypedSingle<std::pmr::list<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
 
 /******************************************************************************
  *
@@ -195,38 +244,56 @@ TypedSingle<sList<uPtr<amqp::internal::reader::Single>>>::dump() const;
  ******************************************************************************/
 
 template<typename T>
-inline std::string
+inline void
+amqp::internal::reader::
+TypedPair<T>::dumpTo (std::string & out_) const {
+    out_.append (m_property).append (" : ");
+    appendNumber (out_, m_value);
+}
+
+template<>
+inline void
 amqp::internal::reader::
-TypedPair<T>::dump() const {
-    return m_property + " : " + std::to_string (m_value);
+TypedPair<std::string>::dumpTo (std::string & out_) const {
+    out_.append (m_property).append (" : ").append (m_value);
 }
 
 template<>
-inline std::string
+inline void
 amqp::internal::reader::
-TypedPair<std::string>::dump() const {
-    return m_property + " : " + m_value;
+TypedPair<std::pmr::string>::dumpTo (std::string & out_) const {
+    out_.append (m_property).append (" : ").append (m_value.data(), m_value.size());
 }
 
 template<>
-std::string
+void
+amqp::internal::reader::
+TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
+
+template<>
+void
+amqp::internal::reader::
+TypedPair<sList<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
+
+template<>
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::reader::IValue>>>::dump() const;
+TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sVec<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<std::pmr::vector<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
 
 template<>
-std::string
+void
 amqp::internal::reader::
-TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
+TypedPair<std::pmr::list<uPtr<amqp::reader::IValue>>>::dumpTo (std::string &) const;
 
 /******************************************************************************
  *
@@ -236,6 +303,8 @@ TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
 
 namespace amqp::internal::reader  {
 
+    class Selection;
+
     using IReader = amqp::reader::IReader<schema::SchemaMap::const_iterator>;
 
     /**
@@ -256,17 +325,111 @@ namespace amqp::internal::reader  {
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
 
-            std::any read (struct pn_data_t *) const override = 0;
-            std::string readString (struct pn_data_t *) const override = 0;
+            std::any read (decoder::Decoder *) const override = 0;
+            std::string readString (decoder::Decoder *) const override = 0;
 
+            /**
+             * Both forms of dump are implemented in terms of [visit]
+             */
             uPtr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+                decoder::Decoder *,
+                const SchemaType &) const override;
 
             uPtr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+                decoder::Decoder *,
+                const SchemaType &) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
+            /**
+             * Readers of composites know the readers of their fields, and
+             * those of lists, arrays and maps the reader of their elements,
+             * which is what [Projection]s are compiled against.
+             *
+             * @return the reader of the named field, setting [index_] to its
+             * position, or nullptr if there isn't one
+             */
+            virtual const Reader * field (
+                std::string_view,
+                size_t & index_) const;
+
+            virtual const Reader * element() const;
+
+            /**
+             * Visit only the selected parts of the value under the cursor,
+             * leaving the cursor on the next value. Only readers that have
+             * fields or elements are ever asked for less than all of it.
+             */
+            virtual void project (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const;
+
+            /**
+             * Move the cursor past the value under it without decoding it
+             */
+            virtual void skip (
+                decoder::Decoder *,
+                const SchemaType &) const;
+    };
+
+    /**
+     * Corda gives everything it doesn't consider a primitive, composites,
+     * enums and the restricted collections, a place in a per blob table of
+     * objects and writes any it comes across again as a reference into it.
+     * Elements of those collections get one too unless they're JVM
+     * primitives, see [PropertyReader::numbered].
+     *
+     * Readers of such values implement [visitObject] and leave [visit] to
+     * resolve references and keep the table up to date around it.
+     */
+    class ObjectReader : public Reader {
+        protected :
+            virtual void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const = 0;
+
+            /**
+             * By default all of it
+             */
+            virtual void projectObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const;
+
+            /**
+             * Skipping a value still has to number any objects inside it
+             * as a later reference could be to one of them. By default we
+             * assume there are none and step straight over it.
+             */
+            virtual void skipObject (
+                decoder::Decoder *,
+                const SchemaType &) const;
+
+        public :
+            ~ObjectReader() override = default;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const final;
+
+            void project (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const final;
+
+            void skip (
+                decoder::Decoder *,
+                const SchemaType &) const final;
     };
 
 }
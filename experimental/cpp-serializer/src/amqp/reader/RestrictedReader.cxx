@@ -1,8 +1,12 @@
 #include "RestrictedReader.h"
 
 #include <iostream>
+#include <algorithm>
+#include <stdexcept>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/WorkPool.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/visitors/RecordingVisitor.h"
 
 #include "amqp/reader/IReader.h"
 #include "amqp/reader/Reader.h"
@@ -16,6 +20,109 @@ RestrictedReader::RestrictedReader (std::string type_)
 
 /******************************************************************************/
 
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+RestrictedReader::resolve (const std::weak_ptr<Reader> & reader_) {
+    auto reader = reader_.lock();
+
+    if (!reader) {
+        throw std::runtime_error ("Restricted type has no reader");
+    }
+
+    return reader.get();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RestrictedReader::visitElements (
+        decoder::Decoder * data_,
+        size_t elements_,
+        size_t stride_,
+        amqp::reader::IVisitor & visitor_,
+        const ElementVisitor & visit_
+) {
+    const auto units = elements_ / stride_;
+    auto * pool = WorkPool::instance();
+
+    // anything already off on a branch, or being revisited, stays put,
+    // the latter isn't numbering its objects so has nothing to stitch
+    if (!pool
+        || units < 2 * pool->grain()
+        || data_->branched()
+        || data_->recalling()
+    ) {
+        for (size_t i { 0 } ; i < units ; ++i) {
+            visit_ (data_, visitor_);
+        }
+
+        return;
+    }
+
+    const auto chunks = std::min (units / pool->grain(), pool->threads() * 4);
+    const auto perChunk = (units + chunks - 1) / chunks;
+
+    struct Chunk {
+        decoder::Decoder data;
+        size_t           units;
+        RecordingVisitor recording;
+    };
+
+    std::vector<Chunk> runs;
+    runs.reserve (chunks);
+
+    auto start = data_->branch();
+
+    // walk over the elements, which only needs their sizes, noting where
+    // each run starts. We finish on the last element just as we would
+    // having visited them all.
+    for (size_t i { 0 } ; i < elements_ ; ++i) {
+        if (i % (perChunk * stride_) == 0) {
+            runs.push_back (Chunk {
+                data_->branch(),
+                std::min (perChunk, units - i / stride_),
+                RecordingVisitor { } });
+        }
+
+        if (i + 1 < elements_) {
+            data_->next();
+        }
+    }
+
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve (runs.size());
+
+    for (auto & run : runs) {
+        tasks.emplace_back ([&run, &visit_]() {
+            for (size_t i { 0 } ; i < run.units ; ++i) {
+                visit_ (&run.data, run.recording);
+            }
+        });
+    }
+
+    try {
+        pool->run (std::move (tasks));
+    } catch (const std::exception &) {
+        data_->reposition (start);
+
+        for (size_t i { 0 } ; i < units ; ++i) {
+            visit_ (data_, visitor_);
+        }
+
+        return;
+    }
+
+    // each run numbered its objects as if it came straight after
+    // whatever preceded the container, by now we know what did
+    for (auto & run : runs) {
+        run.recording.replay (visitor_, data_->remembered() - start.remembered());
+        data_->join (run.data);
+    }
+}
+
+/******************************************************************************/
+
 const std::string
 amqp::internal::reader::
 RestrictedReader::m_name { // NOLINT
@@ -26,7 +133,7 @@ RestrictedReader::m_name { // NOLINT
 
 std::any
 amqp::internal::reader::
-RestrictedReader::read (pn_data_t *) const {
+RestrictedReader::read (decoder::Decoder *) const {
     return std::any(1);
 }
 
@@ -34,7 +141,7 @@ RestrictedReader::read (pn_data_t *) const {
 
 std::string
 amqp::internal::reader::
-RestrictedReader::readString (pn_data_t * data_) const {
+RestrictedReader::readString (decoder::Decoder * data_) const {
     return "hello";
 }
 
@@ -6,34 +6,63 @@
 
 #include <any>
 #include <vector>
+#include <functional>
 
 #include "amqp/schema/restricted-types/Restricted.h"
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace amqp::internal::decoder {
+
+    class Decoder;
+
+}
 
 /******************************************************************************/
 
 namespace amqp::internal::reader {
 
-    class RestrictedReader : public Reader {
+    class RestrictedReader : public ObjectReader {
         private :
             static const std::string m_name;
             const std::string m_type;
 
+        protected :
+            /**
+             * Restricted readers hold plain pointers to the readers of the
+             * types they contain, those are owned by the factory that built
+             * us and live as long as it does
+             */
+            static const Reader * resolve (const std::weak_ptr<Reader> &);
+
+            using ElementVisitor = std::function<void (
+                    decoder::Decoder *, amqp::reader::IVisitor &)>;
+
+            /**
+             * Visit the contents of a container we've just entered, [stride_]
+             * values at a time, a key and its value for a map for instance.
+             *
+             * If there's a [WorkPool] and enough of them the elements are
+             * split into runs, each decoded on a [branch] of [data_] into a
+             * [RecordingVisitor], and those are replayed to [visitor_] in
+             * order. Should any run fail we start again from the top on
+             * this thread so a genuine error is reported as it otherwise
+             * would be.
+             */
+            static void visitElements (
+                decoder::Decoder * data_,
+                size_t elements_,
+                size_t stride_,
+                amqp::reader::IVisitor & visitor_,
+                const ElementVisitor &);
+
         public :
             explicit RestrictedReader (std::string);
             ~RestrictedReader() override = default;
 
-            std::any read (pn_data_t *) const override ;
-
-            std::string readString (pn_data_t *) const override;
+            std::any read (decoder::Decoder *) const override ;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+            std::string readString (decoder::Decoder *) const override;
 
             const std::string & name() const override;
             const std::string & type() const override;
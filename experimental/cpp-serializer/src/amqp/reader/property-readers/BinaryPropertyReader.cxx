@@ -0,0 +1,101 @@
+#include "BinaryPropertyReader.h"
+
+#include <any>
+#include <string>
+
+#include "amqp/BinaryEncoding.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    std::string_view
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return data_->get_binary();
+    }
+
+}
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_name { // NOLINT
+    "Binary Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+BinaryPropertyReader::m_type { // NOLINT
+    "binary"
+};
+
+/******************************************************************************
+ *
+ * BinaryPropertyReader
+ *
+ ******************************************************************************/
+
+/**
+ * A view of the bytes in the blob, only good for as long as that is
+ */
+std::any
+amqp::internal::reader::
+BinaryPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { ::readAndNext (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+BinaryPropertyReader::readString (decoder::Decoder * data_) const {
+    auto bytes = ::readAndNext (data_);
+
+    std::string rtn (hexLength (bytes.size()), '\0');
+    toHex (reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size(), rtn.data());
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+BinaryPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    visitor_.binaryValue (::readAndNext (data_));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+BinaryPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
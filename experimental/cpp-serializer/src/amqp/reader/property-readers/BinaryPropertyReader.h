@@ -0,0 +1,37 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A byte array, a hash, key or signature more often than not. Never
+     * copied, visitors are handed a view of the bytes in the blob to write
+     * out as they see fit.
+     */
+    class BinaryPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            std::string readString (decoder::Decoder *) const override;
+
+            std::any read (decoder::Decoder *) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,6 +1,6 @@
 #include "BoolPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************
  *
@@ -19,7 +19,7 @@ BoolPropertyReader::m_name { // NOLINT
 const std::string
 amqp::internal::reader::
 BoolPropertyReader::m_type { // NOLINT
-        "bool"
+        "boolean"
 };
 
 /******************************************************************************
@@ -30,42 +30,28 @@ BoolPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-BoolPropertyReader::read (pn_data_t * data_) const {
-    return std::any (proton::readAndNext<bool> (data_));
+BoolPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any (decoder::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-BoolPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<bool> (data_));
+BoolPropertyReader::readString (decoder::Decoder * data_) const {
+    return std::to_string (decoder::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-BoolPropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+BoolPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<bool> (data_)));
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-BoolPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<bool> (data_)));
+    visitor_.boolValue (decoder::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
@@ -0,0 +1,128 @@
+#include "CharPropertyReader.h"
+
+#include <any>
+#include <string>
+
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    char32_t
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return static_cast<char32_t>(data_->get_char());
+    }
+
+    /**
+     * @return [value_] as UTF-8, written into [buffer_]. Anything that
+     * isn't a Unicode scalar value, a surrogate or beyond U+10FFFF, has
+     * no UTF-8 form and is written as the replacement character, U+FFFD
+     */
+    std::string_view
+    utf8 (char (& buffer_)[4], char32_t value_) {
+        if ((value_ >= 0xD800 && value_ <= 0xDFFF) || value_ > 0x10FFFF) {
+            value_ = 0xFFFD;
+        }
+
+        if (value_ < 0x80) {
+            buffer_[0] = static_cast<char>(value_);
+            return { buffer_, 1 };
+        } else if (value_ < 0x800) {
+            buffer_[0] = static_cast<char>(0xC0 | (value_ >> 6));
+            buffer_[1] = static_cast<char>(0x80 | (value_ & 0x3F));
+            return { buffer_, 2 };
+        } else if (value_ < 0x10000) {
+            buffer_[0] = static_cast<char>(0xE0 | (value_ >> 12));
+            buffer_[1] = static_cast<char>(0x80 | ((value_ >> 6) & 0x3F));
+            buffer_[2] = static_cast<char>(0x80 | (value_ & 0x3F));
+            return { buffer_, 3 };
+        }
+
+        buffer_[0] = static_cast<char>(0xF0 | ((value_ >> 18) & 0x07));
+        buffer_[1] = static_cast<char>(0x80 | ((value_ >> 12) & 0x3F));
+        buffer_[2] = static_cast<char>(0x80 | ((value_ >> 6) & 0x3F));
+        buffer_[3] = static_cast<char>(0x80 | (value_ & 0x3F));
+        return { buffer_, 4 };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * CharPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+CharPropertyReader::m_name { // NOLINT
+    "Char Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+CharPropertyReader::m_type { // NOLINT
+    "char"
+};
+
+/******************************************************************************
+ *
+ * CharPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+CharPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { ::readAndNext (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+CharPropertyReader::readString (decoder::Decoder * data_) const {
+    char buffer[4];
+
+    return std::string (utf8 (buffer, ::readAndNext (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CharPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    char buffer[4];
+
+    visitor_.stringValue (utf8 (buffer, ::readAndNext (data_)));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+CharPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+CharPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
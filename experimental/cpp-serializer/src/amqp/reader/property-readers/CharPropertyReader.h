@@ -0,0 +1,36 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A Java char, a single UTF-16 code unit Corda widens to an AMQP char.
+     * Reported as a one character string.
+     */
+    class CharPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            std::string readString (decoder::Decoder *) const override;
+
+            std::any read (decoder::Decoder *) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
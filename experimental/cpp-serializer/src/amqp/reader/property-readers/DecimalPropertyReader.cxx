@@ -0,0 +1,315 @@
+#include "DecimalPropertyReader.h"
+
+#include <any>
+#include <limits>
+#include <string>
+#include <cstdint>
+#include <charconv>
+
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    // a GCC and Clang extension, wide enough for a decimal128's
+    // coefficient in one go
+    __extension__ typedef unsigned __int128 uint128_t;
+
+    /**
+     * The width of the exponent, its bias and how many decimal digits the
+     * coefficient has
+     */
+    template<size_t Bits> struct Format;
+
+    template<> struct Format<32> {
+        static constexpr int exponent  = 8;
+        static constexpr int bias      = 101;
+        static constexpr int precision = 7;
+    };
+
+    template<> struct Format<64> {
+        static constexpr int exponent  = 10;
+        static constexpr int bias      = 398;
+        static constexpr int precision = 16;
+    };
+
+    template<> struct Format<128> {
+        static constexpr int exponent  = 14;
+        static constexpr int bias      = 6176;
+        static constexpr int precision = 34;
+    };
+
+    uint128_t get (const decoder::Decoder * data_, std::integral_constant<size_t, 32>) {
+        return data_->get_decimal32();
+    }
+
+    uint128_t get (const decoder::Decoder * data_, std::integral_constant<size_t, 64>) {
+        return data_->get_decimal64();
+    }
+
+    uint128_t get (const decoder::Decoder * data_, std::integral_constant<size_t, 128>) {
+        uint128_t rtn { 0 };
+
+        for (auto byte : data_->get_decimal128()) {
+            rtn = (rtn << 8) | static_cast<uint8_t>(byte);
+        }
+
+        return rtn;
+    }
+
+    constexpr uint128_t
+    mask (int bits_) {
+        return (uint128_t { 1 } << bits_) - 1;
+    }
+
+    constexpr uint128_t
+    pow10 (int n_) {
+        uint128_t rtn { 1 };
+
+        while (n_--) {
+            rtn *= 10;
+        }
+
+        return rtn;
+    }
+
+    struct Decimal {
+        bool      negative;
+        uint128_t coefficient;
+        int       exponent;
+
+        /**
+         * Set, to NaN or an infinity, if it's one of those
+         */
+        double    special;
+    };
+
+    /**
+     * The sign comes first, then a combination field that's either the
+     * exponent followed by the coefficient or, if its top two bits are
+     * set, those two bits, the exponent and the low bits of a coefficient
+     * that implicitly starts 100. Unless the top four bits are all set in
+     * which case it's NaN, or with the next clear an infinity.
+     */
+    template<size_t Bits>
+    Decimal
+    decode (uint128_t bits_) {
+        using F = Format<Bits>;
+
+        constexpr int small = Bits - 1 - F::exponent;
+        constexpr int large = Bits - 3 - F::exponent;
+
+        Decimal rtn { ((bits_ >> (Bits - 1)) & 1) != 0, 0, 0, 0 };
+
+        if (((bits_ >> (Bits - 3)) & 3) == 3) {
+            if (((bits_ >> (Bits - 5)) & 0xF) == 0xF) {
+                rtn.special = ((bits_ >> (Bits - 6)) & 1)
+                    ? std::numeric_limits<double>::quiet_NaN()
+                    : (rtn.negative ? -1 : 1) * std::numeric_limits<double>::infinity();
+
+                return rtn;
+            }
+
+            rtn.exponent = static_cast<int>((bits_ >> large) & mask (F::exponent));
+            rtn.coefficient = (uint128_t { 4 } << large) | (bits_ & mask (large));
+        } else {
+            rtn.exponent = static_cast<int>((bits_ >> small) & mask (F::exponent));
+            rtn.coefficient = bits_ & mask (small);
+        }
+
+        // anything wider than the precision is non canonical and means zero
+        if (rtn.coefficient >= pow10 (F::precision)) {
+            rtn.coefficient = 0;
+        }
+
+        rtn.exponent -= F::bias;
+
+        return rtn;
+    }
+
+    /**
+     * @return [value_] written out into [buffer_]
+     */
+    std::string_view
+    render (char (& buffer_)[64], const Decimal & value_) {
+        char digits[40];
+        int n { 0 };
+
+        auto coefficient = value_.coefficient;
+
+        do {
+            digits[sizeof (digits) - ++n] = static_cast<char>('0' + static_cast<int>(coefficient % 10));
+            coefficient /= 10;
+        } while (coefficient);
+
+        const char * first = digits + sizeof (digits) - n;
+        const int adjusted = value_.exponent + n - 1;
+
+        char * p = buffer_;
+
+        if (value_.negative) {
+            *p++ = '-';
+        }
+
+        if (value_.exponent <= 0 && adjusted >= -6) {
+            const int point = n + value_.exponent;
+
+            if (point <= 0) {
+                *p++ = '0';
+                *p++ = '.';
+
+                for (int i { point } ; i < 0 ; ++i) {
+                    *p++ = '0';
+                }
+
+                for (int i { 0 } ; i < n ; ++i) {
+                    *p++ = first[i];
+                }
+            } else {
+                for (int i { 0 } ; i < n ; ++i) {
+                    if (i == point) {
+                        *p++ = '.';
+                    }
+
+                    *p++ = first[i];
+                }
+            }
+        } else {
+            *p++ = first[0];
+
+            if (n > 1) {
+                *p++ = '.';
+
+                for (int i { 1 } ; i < n ; ++i) {
+                    *p++ = first[i];
+                }
+            }
+
+            *p++ = 'E';
+            *p++ = adjusted < 0 ? '-' : '+';
+
+            p = std::to_chars (p, std::end (buffer_), adjusted < 0 ? -adjusted : adjusted).ptr;
+        }
+
+        return { buffer_, static_cast<size_t>(p - buffer_) };
+    }
+
+    template<size_t Bits>
+    Decimal
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return decode<Bits> (get (data_, std::integral_constant<size_t, Bits> { }));
+    }
+
+}
+
+/******************************************************************************
+ *
+ * DecimalPropertyReader statics
+ *
+ ******************************************************************************/
+
+#define DECIMAL(BITS)                                                          \
+    template<> const std::string                                               \
+    amqp::internal::reader::                                                   \
+    DecimalPropertyReader<BITS>::m_name { /* NOLINT */                         \
+        "Decimal" #BITS " Reader"                                              \
+    };                                                                         \
+                                                                               \
+    template<> const std::string                                               \
+    amqp::internal::reader::                                                   \
+    DecimalPropertyReader<BITS>::m_type { /* NOLINT */                         \
+        "decimal" #BITS                                                        \
+    };
+
+DECIMAL (32)
+DECIMAL (64)
+DECIMAL (128)
+
+#undef DECIMAL
+
+/******************************************************************************
+ *
+ * DecimalPropertyReader
+ *
+ ******************************************************************************/
+
+template<size_t Bits>
+std::any
+amqp::internal::reader::
+DecimalPropertyReader<Bits>::read (decoder::Decoder * data_) const {
+    return std::any { readString (data_) };
+}
+
+/******************************************************************************/
+
+template<size_t Bits>
+std::string
+amqp::internal::reader::
+DecimalPropertyReader<Bits>::readString (decoder::Decoder * data_) const {
+    auto value = ::readAndNext<Bits> (data_);
+
+    if (value.special != 0) {
+        NumberBuffer buffer;
+
+        return std::string (toChars (buffer, value.special));
+    }
+
+    char buffer[64];
+
+    return std::string (render (buffer, value));
+}
+
+/******************************************************************************/
+
+template<size_t Bits>
+void
+amqp::internal::reader::
+DecimalPropertyReader<Bits>::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    auto value = ::readAndNext<Bits> (data_);
+
+    if (value.special != 0) {
+        visitor_.doubleValue (value.special);
+        return;
+    }
+
+    char buffer[64];
+
+    visitor_.numberValue (render (buffer, value));
+}
+
+/******************************************************************************/
+
+template<size_t Bits>
+const std::string &
+amqp::internal::reader::
+DecimalPropertyReader<Bits>::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+template<size_t Bits>
+const std::string &
+amqp::internal::reader::
+DecimalPropertyReader<Bits>::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::DecimalPropertyReader<32>;
+template class amqp::internal::reader::DecimalPropertyReader<64>;
+template class amqp::internal::reader::DecimalPropertyReader<128>;
+
+/******************************************************************************/
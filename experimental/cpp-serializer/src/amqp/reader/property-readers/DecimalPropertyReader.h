@@ -0,0 +1,48 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+#include <cstddef>
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * AMQP's decimal32, decimal64 and decimal128, IEEE 754-2008 decimals
+     * using the binary integer encoding.
+     *
+     * They're reported as numbers written out exactly, in plain notation
+     * where that's reasonable and scientific where it isn't, much as
+     * Java's BigDecimal.toString would. NaN and the infinities are reported
+     * as doubles, it being up to the visitor what becomes of those.
+     *
+     * Instantiated for 32, 64 and 128 bits
+     */
+    template<size_t Bits>
+    class DecimalPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            ~DecimalPropertyReader() override = default;
+
+            std::string readString (decoder::Decoder *) const override;
+
+            std::any read (decoder::Decoder *) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
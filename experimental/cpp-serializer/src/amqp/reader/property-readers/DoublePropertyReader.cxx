@@ -1,6 +1,7 @@
 #include "DoublePropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************
  *
@@ -28,42 +29,30 @@ DoublePropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-DoublePropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<double> (data_) };
+DoublePropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { decoder::readAndNext<double> (data_) };
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
-}
-
-/******************************************************************************/
+DoublePropertyReader::readString (decoder::Decoder * data_) const {
+    NumberBuffer buffer;
 
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-DoublePropertyReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<double> (data_)));
+    return std::string (toChars (buffer, decoder::readAndNext<double> (data_)));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-DoublePropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+DoublePropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+    visitor_.doubleValue (decoder::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
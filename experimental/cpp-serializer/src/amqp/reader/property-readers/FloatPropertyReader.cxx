@@ -0,0 +1,106 @@
+#include "FloatPropertyReader.h"
+
+#include <any>
+#include <cmath>
+#include <string>
+
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    float
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return data_->get_float();
+    }
+
+}
+
+/******************************************************************************
+ *
+ * FloatPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+FloatPropertyReader::m_name { // NOLINT
+    "Float Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+FloatPropertyReader::m_type { // NOLINT
+    "float"
+};
+
+/******************************************************************************
+ *
+ * FloatPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+FloatPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { ::readAndNext (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+FloatPropertyReader::readString (decoder::Decoder * data_) const {
+    NumberBuffer buffer;
+
+    return std::string (toChars (buffer, ::readAndNext (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+FloatPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    auto value = ::readAndNext (data_);
+
+    // leave whoever we are visiting to decide what NaN and infinity become
+    if (!std::isfinite (value)) {
+        visitor_.doubleValue (value);
+        return;
+    }
+
+    NumberBuffer buffer;
+
+    visitor_.numberValue (toChars (buffer, value));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+FloatPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+FloatPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,37 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Finite values are reported as the shortest decimal that reads back
+     * as the same float rather than as the double they widen to, which
+     * would otherwise show every bit of the rounding error in 0.1f
+     */
+    class FloatPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            std::string readString (decoder::Decoder *) const override;
+
+            std::any read (decoder::Decoder *) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
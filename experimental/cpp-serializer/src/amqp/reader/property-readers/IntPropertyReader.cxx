@@ -3,9 +3,9 @@
 
 #include <any>
 #include <string>
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
 #include "amqp/reader/IReader.h"
 
 /******************************************************************************
@@ -36,42 +36,30 @@ IntPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-IntPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<int> (data_) };
+IntPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { decoder::readAndNext<int> (data_) };
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
-}
-
-/******************************************************************************/
+IntPropertyReader::readString (decoder::Decoder * data_) const {
+    NumberBuffer buffer;
 
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-IntPropertyReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<int> (data_)));
+    return std::string (toChars (buffer, decoder::readAndNext<int> (data_)));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-IntPropertyReader::dump (
-    pn_data_t * data_,
-    const SchemaType & schema_) const
+IntPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+    visitor_.intValue (decoder::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
@@ -16,20 +16,14 @@ namespace amqp::internal::reader {
     public :
         ~IntPropertyReader() override = default;
 
-        std::string readString (pn_data_t *) const override;
+        std::string readString (decoder::Decoder *) const override;
 
-        std::any read(pn_data_t *) const override;
+        std::any read(decoder::Decoder *) const override;
 
-        uPtr <amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &
-        ) const override;
-
-        uPtr <amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &
-        ) const override;
+        void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
 
         const std::string &name() const override;
         const std::string &type() const override;
@@ -0,0 +1,155 @@
+#include "IntegralPropertyReader.h"
+
+#include <any>
+#include <limits>
+#include <string>
+
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    int8_t get (const decoder::Decoder * data_, int8_t) {
+        return data_->get_byte();
+    }
+
+    int16_t get (const decoder::Decoder * data_, int16_t) {
+        return data_->get_short();
+    }
+
+    uint8_t get (const decoder::Decoder * data_, uint8_t) {
+        return data_->get_ubyte();
+    }
+
+    uint16_t get (const decoder::Decoder * data_, uint16_t) {
+        return data_->get_ushort();
+    }
+
+    uint32_t get (const decoder::Decoder * data_, uint32_t) {
+        return data_->get_uint();
+    }
+
+    uint64_t get (const decoder::Decoder * data_, uint64_t) {
+        return data_->get_ulong();
+    }
+
+    template<typename T>
+    T
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return get (data_, T { });
+    }
+
+    template<typename T>
+    void
+    emit (amqp::reader::IVisitor & visitor_, T value_) {
+        if constexpr (sizeof (T) < sizeof (int32_t)) {
+            visitor_.intValue (value_);
+        } else if constexpr (sizeof (T) == sizeof (int32_t)) {
+            visitor_.longValue (value_);
+        } else if (value_ <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            visitor_.longValue (static_cast<int64_t>(value_));
+        } else {
+            amqp::internal::NumberBuffer buffer;
+
+            visitor_.numberValue (amqp::internal::toChars (buffer, value_));
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * IntegralPropertyReader statics
+ *
+ ******************************************************************************/
+
+#define INTEGRAL(T, NAME, TYPE)                                                \
+    template<> const std::string                                               \
+    amqp::internal::reader::                                                   \
+    IntegralPropertyReader<T>::m_name { NAME }; /* NOLINT */                   \
+                                                                               \
+    template<> const std::string                                               \
+    amqp::internal::reader::                                                   \
+    IntegralPropertyReader<T>::m_type { TYPE }; /* NOLINT */
+
+INTEGRAL (int8_t,   "Byte Reader",   "byte")
+INTEGRAL (int16_t,  "Short Reader",  "short")
+INTEGRAL (uint8_t,  "UByte Reader",  "ubyte")
+INTEGRAL (uint16_t, "UShort Reader", "ushort")
+INTEGRAL (uint32_t, "UInt Reader",   "uint")
+INTEGRAL (uint64_t, "ULong Reader",  "ulong")
+
+#undef INTEGRAL
+
+/******************************************************************************
+ *
+ * IntegralPropertyReader
+ *
+ ******************************************************************************/
+
+template<typename T>
+std::any
+amqp::internal::reader::
+IntegralPropertyReader<T>::read (decoder::Decoder * data_) const {
+    return std::any { ::readAndNext<T> (data_) };
+}
+
+/******************************************************************************/
+
+template<typename T>
+std::string
+amqp::internal::reader::
+IntegralPropertyReader<T>::readString (decoder::Decoder * data_) const {
+    NumberBuffer buffer;
+
+    return std::string (toChars (buffer, ::readAndNext<T> (data_)));
+}
+
+/******************************************************************************/
+
+template<typename T>
+void
+amqp::internal::reader::
+IntegralPropertyReader<T>::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    emit (visitor_, ::readAndNext<T> (data_));
+}
+
+/******************************************************************************/
+
+template<typename T>
+const std::string &
+amqp::internal::reader::
+IntegralPropertyReader<T>::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+template<typename T>
+const std::string &
+amqp::internal::reader::
+IntegralPropertyReader<T>::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::IntegralPropertyReader<int8_t>;
+template class amqp::internal::reader::IntegralPropertyReader<int16_t>;
+template class amqp::internal::reader::IntegralPropertyReader<uint8_t>;
+template class amqp::internal::reader::IntegralPropertyReader<uint16_t>;
+template class amqp::internal::reader::IntegralPropertyReader<uint32_t>;
+template class amqp::internal::reader::IntegralPropertyReader<uint64_t>;
+
+/******************************************************************************/
@@ -0,0 +1,47 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+#include <cstdint>
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The fixed width integers that have no reader of their own, byte,
+     * short and the unsigned types.
+     *
+     * Those that fit are reported as ints, a uint as a long and a ulong as
+     * a long where it can be and written out in full where it can't.
+     *
+     * Instantiated for int8_t, int16_t, uint8_t, uint16_t, uint32_t and
+     * uint64_t
+     */
+    template<typename T>
+    class IntegralPropertyReader : public PropertyReader {
+        private :
+            static const std::string m_name;
+            static const std::string m_type;
+
+        public :
+            ~IntegralPropertyReader() override = default;
+
+            std::string readString (decoder::Decoder *) const override;
+
+            std::any read (decoder::Decoder *) const override;
+
+            void visit (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,6 +1,7 @@
 #include "LongPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "amqp/Format.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************
  *
@@ -30,42 +31,30 @@ LongPropertyReader::m_type { // NOLINT
 
 std::any
 amqp::internal::reader::
-LongPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<long> (data_) };
+LongPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { decoder::readAndNext<long> (data_) };
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
-}
-
-/******************************************************************************/
+LongPropertyReader::readString (decoder::Decoder * data_) const {
+    NumberBuffer buffer;
 
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-LongPropertyReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<long> (data_)));
+    return std::string (toChars (buffer, decoder::readAndNext<long> (data_)));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-LongPropertyReader::dump (
-    pn_data_t * data_,
-    const SchemaType & schema_) const
+LongPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+    visitor_.longValue (decoder::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
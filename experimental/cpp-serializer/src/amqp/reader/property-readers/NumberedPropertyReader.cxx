@@ -0,0 +1,65 @@
+#include "NumberedPropertyReader.h"
+
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * class NumberedPropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+NumberedPropertyReader::NumberedPropertyReader (
+        const std::weak_ptr<Reader> & reader_
+) : m_reader (reader_.lock().get())
+{
+    if (!m_reader) {
+        throw std::runtime_error ("Numbered property has no reader");
+    }
+}
+
+/******************************************************************************/
+
+std::any
+amqp::internal::reader::
+NumberedPropertyReader::read (decoder::Decoder * data_) const {
+    return m_reader->read (data_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+NumberedPropertyReader::readString (decoder::Decoder * data_) const {
+    return m_reader->readString (data_);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+NumberedPropertyReader::name() const {
+    return m_reader->name();
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+NumberedPropertyReader::type() const {
+    return m_reader->type();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+NumberedPropertyReader::visitObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    m_reader->visit (data_, schema_, visitor_);
+}
+
+/******************************************************************************/
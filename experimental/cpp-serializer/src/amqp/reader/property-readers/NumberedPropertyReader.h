@@ -0,0 +1,47 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A primitive read as an element of a list or array, or a key or value
+     * of a map, where unlike as a field Corda numbers it as it would any
+     * other object, see [PropertyReader::numbered].
+     *
+     * Wraps the property reader that's used everywhere else, adding only
+     * what [ObjectReader] does around it.
+     */
+    class NumberedPropertyReader : public ObjectReader {
+        private :
+            /**
+             * Owned by the factory that built us, as is every reader
+             */
+            const Reader * m_reader;
+
+        public :
+            explicit NumberedPropertyReader (const std::weak_ptr<Reader> &);
+
+            ~NumberedPropertyReader() final = default;
+
+            std::any read (decoder::Decoder *) const override;
+
+            std::string readString (decoder::Decoder *) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,8 +1,7 @@
 #include "StringPropertyReader.h"
 
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************
  *
@@ -32,42 +31,28 @@ StringPropertyReader::m_name { // NOLINT
 
 std::any
 amqp::internal::reader::
-StringPropertyReader::read (pn_data_t * data_) const {
-    return std::any { proton::readAndNext<std::string> (data_) };
+StringPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { decoder::readAndNext<std::string> (data_) };
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-StringPropertyReader::readString (pn_data_t * data_) const {
-    return proton::readAndNext<std::string> (data_);
+StringPropertyReader::readString (decoder::Decoder * data_) const {
+    return decoder::readAndNext<std::string> (data_);
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-StringPropertyReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
+StringPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-StringPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+    visitor_.stringValue (decoder::readAndNext<std::string_view> (data_));
 }
 
 /******************************************************************************/
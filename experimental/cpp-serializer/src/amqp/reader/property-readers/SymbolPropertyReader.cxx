@@ -0,0 +1,77 @@
+#include "SymbolPropertyReader.h"
+
+#include <any>
+#include <string>
+
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************
+ *
+ * SymbolPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+SymbolPropertyReader::m_name { // NOLINT
+    "Symbol Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+SymbolPropertyReader::m_type { // NOLINT
+    "symbol"
+};
+
+/******************************************************************************
+ *
+ * SymbolPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+SymbolPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { decoder::readAndNext<std::string> (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+SymbolPropertyReader::readString (decoder::Decoder * data_) const {
+    return decoder::readAndNext<std::string> (data_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+SymbolPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    visitor_.stringValue (decoder::readAndNext<std::string_view> (data_));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+SymbolPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+SymbolPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -0,0 +1,175 @@
+#include "TimestampPropertyReader.h"
+
+#include <any>
+#include <string>
+
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    int64_t
+    readAndNext (decoder::Decoder * data_) {
+        decoder::auto_next an (data_);
+
+        return data_->get_timestamp();
+    }
+
+    /**
+     * Write [value_], of at most [width_] digits, into [to_] padded with
+     * leading zeros
+     *
+     * @return just past what we wrote
+     */
+    char *
+    digits (char * to_, int64_t value_, int width_) {
+        for (int i { width_ - 1 } ; i >= 0 ; --i) {
+            to_[i] = static_cast<char>('0' + value_ % 10);
+            value_ /= 10;
+        }
+
+        return to_ + width_;
+    }
+
+    /**
+     * Dates either side of the epoch without gmtime, which wants a time_t
+     * and so loses the milliseconds and is limited to whatever range the
+     * platform gives it. The date arithmetic is Howard Hinnant's
+     * civil_from_days.
+     *
+     * @return [millis_] as yyyy-mm-ddThh:mm:ss.sssZ, written into [buffer_]
+     */
+    std::string_view
+    iso8601 (char (& buffer_)[32], int64_t millis_) {
+        constexpr int64_t msPerDay = 24 * 60 * 60 * 1000;
+
+        int64_t days = millis_ / msPerDay;
+        int64_t ms = millis_ % msPerDay;
+
+        if (ms < 0) {
+            ms += msPerDay;
+            --days;
+        }
+
+        days += 719468;
+
+        const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64_t doe = days - era * 146097;
+        const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64_t mp = (5 * doy + 2) / 153;
+
+        const int64_t day = doy - (153 * mp + 2) / 5 + 1;
+        const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+        int64_t year = yoe + era * 400 + (month <= 2);
+
+        char * p = buffer_;
+
+        if (year < 0) {
+            *p++ = '-';
+            year = -year;
+        }
+
+        int width { 4 };
+
+        for (int64_t y { year / 10000 } ; y ; y /= 10) {
+            ++width;
+        }
+
+        p = digits (p, year, width);
+        *p++ = '-';
+        p = digits (p, month, 2);
+        *p++ = '-';
+        p = digits (p, day, 2);
+        *p++ = 'T';
+        p = digits (p, ms / 3600000, 2);
+        *p++ = ':';
+        p = digits (p, ms / 60000 % 60, 2);
+        *p++ = ':';
+        p = digits (p, ms / 1000 % 60, 2);
+        *p++ = '.';
+        p = digits (p, ms % 1000, 3);
+        *p++ = 'Z';
+
+        return { buffer_, static_cast<size_t>(p - buffer_) };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * TimestampPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+TimestampPropertyReader::m_name { // NOLINT
+    "Timestamp Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+TimestampPropertyReader::m_type { // NOLINT
+    "timestamp"
+};
+
+/******************************************************************************
+ *
+ * TimestampPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+TimestampPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { ::readAndNext (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+TimestampPropertyReader::readString (decoder::Decoder * data_) const {
+    char buffer[32];
+
+    return std::string (iso8601 (buffer, ::readAndNext (data_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TimestampPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    char buffer[32];
+
+    visitor_.stringValue (iso8601 (buffer, ::readAndNext (data_)));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+TimestampPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+TimestampPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
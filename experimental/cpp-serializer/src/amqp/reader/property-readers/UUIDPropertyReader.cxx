@@ -0,0 +1,116 @@
+#include "UUIDPropertyReader.h"
+
+#include <any>
+#include <string>
+
+#include "amqp/decoder/Decoder.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    const char HEX[] = "0123456789abcdef";
+
+    /**
+     * @return the UUID under the cursor as 8-4-4-4-12 hex digits, written
+     * into [buffer_]
+     */
+    std::string_view
+    readAndNext (decoder::Decoder * data_, char (& buffer_)[36]) {
+        decoder::auto_next an (data_);
+
+        auto bytes = data_->get_uuid();
+        char * p = buffer_;
+
+        for (size_t i { 0 } ; i < bytes.size() ; ++i) {
+            if (i == 4 || i == 6 || i == 8 || i == 10) {
+                *p++ = '-';
+            }
+
+            auto byte = static_cast<uint8_t>(bytes[i]);
+
+            *p++ = HEX[byte >> 4];
+            *p++ = HEX[byte & 0xF];
+        }
+
+        return { buffer_, sizeof (buffer_) };
+    }
+
+}
+
+/******************************************************************************
+ *
+ * UUIDPropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+UUIDPropertyReader::m_name { // NOLINT
+    "UUID Reader"
+};
+
+/******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+UUIDPropertyReader::m_type { // NOLINT
+    "uuid"
+};
+
+/******************************************************************************
+ *
+ * UUIDPropertyReader
+ *
+ ******************************************************************************/
+
+std::any
+amqp::internal::reader::
+UUIDPropertyReader::read (decoder::Decoder * data_) const {
+    return std::any { readString (data_) };
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+UUIDPropertyReader::readString (decoder::Decoder * data_) const {
+    char buffer[36];
+
+    return std::string (::readAndNext (data_, buffer));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+UUIDPropertyReader::visit (
+    decoder::Decoder * data_,
+    const SchemaType &,
+    amqp::reader::IVisitor & visitor_) const
+{
+    char buffer[36];
+
+    visitor_.stringValue (::readAndNext (data_, buffer));
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+UUIDPropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+UUIDPropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
@@ -1,19 +1,21 @@
 #include "EnumReader.h"
 
+#include <algorithm>
+
 #include "amqp/reader/IReader.h"
-#include "amqp/schema/Descriptors.h"
-#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
-#include "proton/proton_wrapper.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************/
 
 amqp::internal::reader::
 EnumReader::EnumReader (
     std::string type_,
-    std::vector<std::string> choices_
+    std::vector<std::string> choices_,
+    std::vector<std::string> as_
 ) : RestrictedReader (std::move (type_))
-  , m_choices (std::move (choices_)
-) {
+  , m_choices (std::move (choices_))
+  , m_as (std::move (as_))
+{
 
 }
 
@@ -21,74 +23,64 @@ EnumReader::EnumReader (
 
 namespace {
 
-    std::string
-    getValue (pn_data_t * data_) {
-        proton::is_described (data_);
+    namespace decoder = amqp::internal::decoder;
 
-        {
-            proton::auto_enter ae (data_);
+    std::string_view
+    getValue (decoder::Decoder * data_, int32_t * ordinal_ = nullptr) {
+        decoder::is_described (data_);
 
-            /*
-             * Referenced objects are added to a stream when the serialiser
-             * notices it's writing a value it's already written, so to save
-             * space it will just link back to that. Currently we have
-             * no mechanism for decoding that so just throw an error
-             */
-            if (pn_data_type (data_) == PN_ULONG) {
-                if (amqp::stripCorda(pn_data_get_ulong(data_)) ==
-                amqp::schema::descriptors::REFERENCED_OBJECT
-            ) {
-                    throw std::runtime_error (
-                            "Currently don't support referenced objects");
-                }
-            }
+        {
+            decoder::auto_enter ae (data_);
 
-            auto fingerprint = proton::readAndNext<std::string>(data_);
+            auto fingerprint = decoder::readAndNext<std::string>(data_);
 
-            proton::auto_list_enter ale (data_, true);
+            decoder::auto_list_enter ale (data_, true);
 
-            return proton::readAndNext<std::string>(data_);
+            auto value = decoder::readAndNext<std::string_view>(data_);
 
             /*
              * After a string representation of the enumerated value
              * the ordinal value is also encoded. We don't need that for
-             * just dumping things to a string but if I don't leave this
-             * here I'll forget its even a thing
+             * just dumping things to a string, only to look it up
              */
-            // auto idx = proton::readAndNext<int>(data_);
+            if (ordinal_) {
+                *ordinal_ = decoder::readAndNext<int32_t>(data_);
+            }
+
+            return value;
         }
     }
 }
 
 /******************************************************************************/
 
-std::unique_ptr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-EnumReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_
+EnumReader::visitObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
 ) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
 
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            getValue(data_));
-}
+    if (m_as.empty()) {
+        visitor_.enumValue (getValue (data_));
+        return;
+    }
 
-/******************************************************************************/
+    int32_t ordinal { -1 };
+    auto value = getValue (data_, &ordinal);
 
-std::unique_ptr<amqp::reader::IValue>
-amqp::internal::reader::
-EnumReader::dump(
-        pn_data_t * data_,
-        const SchemaType & schema_
-) const {
-    proton::auto_next an (data_);
-    proton::is_described (data_);
+    // the ordinal should tell us where it is, but don't take its word
+    size_t i = static_cast<size_t>(ordinal);
+
+    if (ordinal < 0 || i >= m_choices.size() || m_choices[i] != value) {
+        i = std::find (m_choices.begin(), m_choices.end(), value)
+            - m_choices.begin();
+    }
 
-    return std::make_unique<TypedSingle<std::string>> (getValue(data_));
+    visitor_.enumValue (i < m_as.size() ? std::string_view (m_as[i]) : value);
 }
 
 /******************************************************************************/
@@ -9,17 +9,24 @@ namespace amqp::internal::reader {
     class EnumReader : public RestrictedReader {
         private :
             std::vector<std::string> m_choices;
-        public :
-            EnumReader (std::string, std::vector<std::string>);
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
+            /**
+             * Set when reading an enum written with another version of
+             * it, what each of [m_choices] should be read as
+             */
+            std::vector<std::string> m_as;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override;
+        public :
+            EnumReader (
+                std::string,
+                std::vector<std::string>,
+                std::vector<std::string> as_ = { });
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
     };
 
 }
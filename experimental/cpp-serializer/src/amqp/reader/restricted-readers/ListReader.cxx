@@ -1,6 +1,7 @@
 #include "ListReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "Projection.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************
  *
@@ -16,60 +17,102 @@ ListReader::restrictedType() const {
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-ListReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_
+ListReader::visitObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
 ) const {
-    proton::auto_next an (data_);
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
 
-    return std::make_unique<TypedPair<sList<uPtr<amqp::reader::IValue>>>>(
-         name_,
-         dump_ (data_, schema_));
+    {
+        decoder::auto_enter ae (data_);
+        // the descriptor tells us nothing we don't already know
+        decoder::readAndNext<std::string_view>(data_);
+
+        {
+            decoder::auto_list_enter ale (data_, true);
+
+            visitor_.beginList();
+
+            visitElements (data_, ale.elements(), 1, visitor_,
+                [this, &schema_](
+                        decoder::Decoder * data_,
+                        amqp::reader::IVisitor & visitor_
+                ) {
+                    m_reader->visit (data_, schema_, visitor_);
+                });
+
+            visitor_.endList();
+        }
+    }
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-ListReader::dump(
-    pn_data_t * data_,
-    const SchemaType & schema_
+ListReader::projectObject (
+        decoder::Decoder * data_,
+        const SchemaType & schema_,
+        const Selection & selection_,
+        amqp::reader::IVisitor & visitor_
 ) const {
-    proton::auto_next an (data_);
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
+
+    {
+        decoder::auto_enter ae (data_);
+        decoder::readAndNext<std::string_view>(data_);
 
-    return std::make_unique<TypedSingle<sList<uPtr<amqp::reader::IValue>>>>(
-         dump_ (data_, schema_));
+        {
+            decoder::auto_list_enter ale (data_, true);
+
+            visitor_.beginList();
+
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                if (const auto * selected = selection_.element (i)) {
+                    m_reader->project (data_, schema_, *selected, visitor_);
+                } else {
+                    m_reader->skip (data_, schema_);
+                }
+            }
+
+            visitor_.endList();
+        }
+    }
 }
 
 /******************************************************************************/
 
-sList<uPtr<amqp::reader::IValue>>
+void
 amqp::internal::reader::
-ListReader::dump_(
-        pn_data_t * data_,
+ListReader::skipObject (
+        decoder::Decoder * data_,
         const SchemaType & schema_
 ) const {
-    proton::is_described (data_);
+    if (m_flat) {
+        data_->next();
+        return;
+    }
 
-    decltype (dump_(data_, schema_)) read;
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
 
     {
-        proton::auto_enter ae (data_);
-        schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        decoder::auto_enter ae (data_);
+        decoder::readAndNext<std::string_view>(data_);
 
         {
-            proton::auto_list_enter ale (data_, true);
+            decoder::auto_list_enter ale (data_, true);
 
             for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
+                m_reader->skip (data_, schema_);
             }
         }
     }
-
-    return read;
 }
 
 /******************************************************************************/
@@ -11,31 +11,44 @@ namespace amqp::internal::reader {
     class ListReader : public RestrictedReader {
         private :
             // How to read the underlying types
-            std::weak_ptr<Reader> m_reader;
+            const Reader * m_reader;
 
-            std::list<uPtr<amqp::reader::IValue>> dump_(
-                pn_data_t *,
-                const SchemaType &) const;
+            /**
+             * Elements that aren't objects themselves can be skipped
+             * over along with us, primitives Corda numbers are read by
+             * a [NumberedPropertyReader] so count as objects here
+             */
+            bool m_flat;
 
         public :
             ListReader (
                 const std::string & type_,
                 std::weak_ptr<Reader> reader_
             ) : RestrictedReader (type_)
-              , m_reader (std::move (reader_))
+              , m_reader (resolve (reader_))
+              , m_flat (!dynamic_cast<const ObjectReader *>(m_reader))
             { }
 
             ~ListReader() final = default;
 
             internal::schema::Restricted::RestrictedTypes restrictedType() const;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
+            const Reader * element() const override { return m_reader; }
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void projectObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const override;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+            void skipObject (
+                decoder::Decoder *,
                 const SchemaType &) const override;
     };
 
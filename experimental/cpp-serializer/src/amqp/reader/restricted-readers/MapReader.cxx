@@ -2,7 +2,8 @@
 
 #include "Reader.h"
 #include "amqp/reader/IReader.h"
-#include "proton/proton_wrapper.h"
+#include "Projection.h"
+#include "amqp/decoder/Decoder.h"
 
 /******************************************************************************/
 
@@ -14,69 +15,106 @@ MapReader::restrictedType() const {
 
 /******************************************************************************/
 
-sVec<uPtr<amqp::reader::IValue>>
+void
 amqp::internal::reader::
-MapReader::dump_(
-    pn_data_t * data_,
-    const SchemaType & schema_
+MapReader::visitObject (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
 ) const {
-    proton::is_described (data_);
-    proton::auto_enter ae (data_);
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
 
-    // gloss over fetching the descriptor from the schema since
+    // gloss over looking the descriptor up in the schema since
     // we don't need it, we know the types this is a reader for
     // and don't need context from the schema as there isn't
     // any. Maps have a Key and a Value, they aren't named
     // parameters, unlike composite types.
-    schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+    decoder::readAndNext<std::string_view>(data_);
 
     {
-        proton::auto_map_enter am (data_, true);
-
-        decltype (dump_(data_, schema_)) rtn;
-        rtn.reserve (am.elements() / 2);
-
-        for (int i {0} ; i < am.elements() ; i += 2) {
-            rtn.emplace_back (
-                std::make_unique<ValuePair> (
-                    m_keyReader.lock()->dump (data_, schema_),
-                    m_valueReader.lock()->dump (data_, schema_)
-                )
-            );
-        }
+        decoder::auto_map_enter am (data_, true);
+
+        visitor_.beginMap();
 
-        return rtn;
+        visitElements (data_, am.elements(), 2, visitor_,
+            [this, &schema_](
+                    decoder::Decoder * data_,
+                    amqp::reader::IVisitor & visitor_
+            ) {
+                m_keyReader->visit (data_, schema_, visitor_);
+                m_valueReader->visit (data_, schema_, visitor_);
+            });
+
+        visitor_.endMap();
     }
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-MapReader::dump(
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_
+MapReader::projectObject (
+    decoder::Decoder * data_,
+    const SchemaType & schema_,
+    const Selection & selection_,
+    amqp::reader::IVisitor & visitor_
 ) const {
-    proton::auto_next an (data_);
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
+
+    decoder::readAndNext<std::string_view>(data_);
 
-    return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>>(
-            name_,
-            dump_ (data_, schema_));
+    {
+        decoder::auto_map_enter am (data_, true);
+
+        visitor_.beginMap();
+
+        // the count is of keys and values, not entries
+        for (size_t i { 0 } ; i < am.elements() / 2 ; ++i) {
+            if (const auto * selected = selection_.element (i)) {
+                m_keyReader->visit (data_, schema_, visitor_);
+                m_valueReader->project (data_, schema_, *selected, visitor_);
+            } else {
+                m_keyReader->skip (data_, schema_);
+                m_valueReader->skip (data_, schema_);
+            }
+        }
+
+        visitor_.endMap();
+    }
 }
 
 /******************************************************************************/
 
-std::unique_ptr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-MapReader::dump(
-        pn_data_t * data_,
-        const SchemaType & schema_
-) const  {
-    proton::auto_next an (data_);
-
-    return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>>(
-            dump_ (data_, schema_));
+MapReader::skipObject (
+    decoder::Decoder * data_,
+    const SchemaType & schema_
+) const {
+    if (m_flat) {
+        data_->next();
+        return;
+    }
+
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
+    decoder::auto_enter ae (data_);
+
+    decoder::readAndNext<std::string_view>(data_);
+
+    {
+        decoder::auto_map_enter am (data_, true);
+
+        // the count is of keys and values, not entries
+        for (size_t i { 0 } ; i < am.elements() / 2 ; ++i) {
+            m_keyReader->skip (data_, schema_);
+            m_valueReader->skip (data_, schema_);
+        }
+    }
 }
 
 /******************************************************************************/
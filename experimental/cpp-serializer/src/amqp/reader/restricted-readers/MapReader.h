@@ -11,12 +11,15 @@ namespace amqp::internal::reader {
     class MapReader : public RestrictedReader {
         private :
             // How to read the underlying types
-            std::weak_ptr<Reader> m_keyReader;
-            std::weak_ptr<Reader> m_valueReader;
+            const Reader * m_keyReader;
+            const Reader * m_valueReader;
 
-            sVec<uPtr<amqp::reader::IValue>> dump_(
-                    pn_data_t *,
-                    const SchemaType &) const;
+            /**
+             * Neither keys nor values are objects themselves so we can be
+             * skipped over whole, primitives Corda numbers are read by a
+             * [NumberedPropertyReader] so count as objects here
+             */
+            bool m_flat;
 
         public :
             MapReader (
@@ -24,21 +27,36 @@ namespace amqp::internal::reader {
                 std::weak_ptr<Reader> keyReader_,
                 std::weak_ptr<Reader> valueReader_
             ) : RestrictedReader (type_)
-              , m_keyReader (std::move (keyReader_))
-              , m_valueReader (std::move (valueReader_))
+              , m_keyReader (resolve (keyReader_))
+              , m_valueReader (resolve (valueReader_))
+              , m_flat (!dynamic_cast<const ObjectReader *>(m_keyReader)
+                    && !dynamic_cast<const ObjectReader *>(m_valueReader))
             { }
 
             ~MapReader() final = default;
 
             internal::schema::Restricted::RestrictedTypes restrictedType() const;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
+            /**
+             * Projected by entry, an entry being wanted means its key and
+             * as much of its value as was asked for
+             */
+            const Reader * element() const override { return m_valueReader; }
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void projectObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const override;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
+            void skipObject (
+                decoder::Decoder *,
                 const SchemaType &) const override;
     };
 
@@ -0,0 +1,170 @@
+#include "PrimitiveArrayReader.h"
+
+#include <sstream>
+
+#include "Projection.h"
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************/
+
+namespace {
+
+    namespace decoder = amqp::internal::decoder;
+
+    void get (const decoder::Decoder * data_, int32_t & value_) {
+        value_ = data_->get_int();
+    }
+
+    void get (const decoder::Decoder * data_, int64_t & value_) {
+        value_ = data_->get_long();
+    }
+
+    void get (const decoder::Decoder * data_, double & value_) {
+        value_ = data_->get_double();
+    }
+
+    void emit (amqp::reader::IVisitor & visitor_, int32_t value_) {
+        visitor_.intValue (value_);
+    }
+
+    void emit (amqp::reader::IVisitor & visitor_, int64_t value_) {
+        visitor_.longValue (value_);
+    }
+
+    void emit (amqp::reader::IVisitor & visitor_, double value_) {
+        visitor_.doubleValue (value_);
+    }
+
+    /**
+     * Somewhere to read into when visiting, kept per thread so its storage
+     * is reused from one array to the next
+     */
+    template<typename T>
+    std::vector<T> &
+    scratch() {
+        thread_local std::vector<T> buffer;
+
+        return buffer;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * class PrimitiveArrayReader
+ *
+ ******************************************************************************/
+
+template<typename T>
+amqp::internal::reader::
+PrimitiveArrayReader<T>::PrimitiveArrayReader (
+    std::string type_,
+    std::weak_ptr<Reader> reader_
+) : RestrictedReader (std::move (type_))
+  , m_reader (resolve (reader_))
+{ }
+
+/******************************************************************************/
+
+template<typename T>
+amqp::internal::schema::Restricted::RestrictedTypes
+amqp::internal::reader::
+PrimitiveArrayReader<T>::restrictedType() const {
+    return internal::schema::Restricted::RestrictedTypes::array_t;
+}
+
+/******************************************************************************/
+
+template<typename T>
+amqp::internal::Span<const T>
+amqp::internal::reader::
+PrimitiveArrayReader<T>::values (
+        decoder::Decoder * data_,
+        std::vector<T> & buffer_
+) const {
+    decoder::auto_next an (data_);
+    decoder::is_described (data_);
+
+    decoder::auto_enter ae (data_);
+    // the descriptor tells us nothing we don't already know
+    decoder::readAndNext<std::string_view>(data_);
+
+    if (!data_->get_array_values (buffer_)) {
+        const size_t count = data_->type() == decoder::array_t
+            ? data_->get_array()
+            : data_->get_list();
+
+        buffer_.clear();
+
+        // walk what's actually there rather than trust the count
+        decoder::auto_list_enter ale (data_);
+
+        while (data_->next()) {
+            buffer_.emplace_back();
+            get (data_, buffer_.back());
+        }
+
+        if (buffer_.size() != count) {
+            std::stringstream ss;
+            ss << "Expected " << count << " elements but found "
+               << buffer_.size();
+            throw std::runtime_error (ss.str());
+        }
+    }
+
+    return Span<const T> (buffer_);
+}
+
+/******************************************************************************/
+
+template<typename T>
+void
+amqp::internal::reader::
+PrimitiveArrayReader<T>::visitObject (
+        decoder::Decoder * data_,
+        const SchemaType &,
+        amqp::reader::IVisitor & visitor_
+) const {
+    auto & buffer = scratch<T>();
+
+    visitor_.beginList();
+
+    for (auto value : values (data_, buffer)) {
+        emit (visitor_, value);
+    }
+
+    visitor_.endList();
+}
+
+/******************************************************************************/
+
+template<typename T>
+void
+amqp::internal::reader::
+PrimitiveArrayReader<T>::projectObject (
+        decoder::Decoder * data_,
+        const SchemaType &,
+        const Selection & selection_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    auto & buffer = scratch<T>();
+    auto all = values (data_, buffer);
+
+    visitor_.beginList();
+
+    for (size_t i { 0 } ; i < all.size() ; ++i) {
+        if (selection_.element (i)) {
+            emit (visitor_, all[i]);
+        }
+    }
+
+    visitor_.endList();
+}
+
+/******************************************************************************/
+
+template class amqp::internal::reader::PrimitiveArrayReader<int32_t>;
+template class amqp::internal::reader::PrimitiveArrayReader<int64_t>;
+template class amqp::internal::reader::PrimitiveArrayReader<double>;
+
+/******************************************************************************/
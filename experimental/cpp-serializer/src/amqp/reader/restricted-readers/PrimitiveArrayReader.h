@@ -0,0 +1,66 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "RestrictedReader.h"
+
+#include <vector>
+
+#include "amqp/Span.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Reads unboxed Java arrays, int[p], long[p] and double[p], whose
+     * elements can never be null and are all the same type.
+     *
+     * Rather than hand each element to a reader of its own they're read
+     * straight into a contiguous buffer. Where they've been written as an
+     * AMQP array that's a single byte swapping copy of the whole payload,
+     * Corda itself writes them as lists however, each element with its own
+     * constructor, so those are still read one at a time.
+     *
+     * Instantiated for int32_t, int64_t and double
+     */
+    template<typename T>
+    class PrimitiveArrayReader : public RestrictedReader {
+        private :
+            /**
+             * Only so [Projection]s can see past us
+             */
+            const Reader * m_reader;
+
+        public :
+            PrimitiveArrayReader (std::string, std::weak_ptr<Reader>);
+            ~PrimitiveArrayReader() final = default;
+
+            internal::schema::Restricted::RestrictedTypes restrictedType() const;
+
+            const Reader * element() const override { return m_reader; }
+
+            /**
+             * Read the array under the cursor into [buffer_], reusing its
+             * storage, leaving the cursor on the next value.
+             *
+             * @return a view of [buffer_]
+             */
+            Span<const T> values (decoder::Decoder *, std::vector<T> & buffer_) const;
+
+        protected :
+            void visitObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+            void projectObject (
+                decoder::Decoder *,
+                const SchemaType &,
+                const Selection &,
+                amqp::reader::IVisitor &) const override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,173 @@
+#include "CountingVisitor.h"
+
+/******************************************************************************
+ *
+ * class CountingVisitor
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+CountingVisitor::CountingVisitor (amqp::reader::IVisitor & visitor_)
+    : m_visitor (visitor_)
+    , m_values (0)
+    , m_compounds (0)
+{
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::beginComposite (const std::string & type_) {
+    ++m_compounds;
+    m_visitor.beginComposite (type_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::endComposite() {
+    m_visitor.endComposite();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::beginList() {
+    ++m_compounds;
+    m_visitor.beginList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::endList() {
+    m_visitor.endList();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::beginMap() {
+    ++m_compounds;
+    m_visitor.beginMap();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::endMap() {
+    m_visitor.endMap();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::key (const std::string & key_) {
+    m_visitor.key (key_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::intValue (int32_t value_) {
+    ++m_values;
+    m_visitor.intValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::longValue (int64_t value_) {
+    ++m_values;
+    m_visitor.longValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::boolValue (bool value_) {
+    ++m_values;
+    m_visitor.boolValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::doubleValue (double value_) {
+    ++m_values;
+    m_visitor.doubleValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::stringValue (std::string_view value_) {
+    ++m_values;
+    m_visitor.stringValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::enumValue (std::string_view value_) {
+    ++m_values;
+    m_visitor.enumValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::binaryValue (std::string_view value_) {
+    ++m_values;
+    m_visitor.binaryValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::numberValue (std::string_view value_) {
+    ++m_values;
+    m_visitor.numberValue (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::nullValue() {
+    ++m_values;
+    m_visitor.nullValue();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CountingVisitor::object (size_t object_) {
+    m_visitor.object (object_);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+CountingVisitor::reference (size_t object_) {
+    return m_visitor.reference (object_);
+}
+
+/******************************************************************************/
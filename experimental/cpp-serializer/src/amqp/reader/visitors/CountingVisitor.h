@@ -0,0 +1,60 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Passes everything it's shown on to another visitor, counting what
+     * goes by. Values are the scalars and nulls, a map's keys included,
+     * and nodes are those plus every composite, list and map. The names of
+     * properties are neither.
+     */
+    class CountingVisitor : public amqp::reader::IVisitor {
+        private :
+            amqp::reader::IVisitor & m_visitor;
+
+            uint64_t m_values;
+            uint64_t m_compounds;
+
+        public :
+            explicit CountingVisitor (amqp::reader::IVisitor &);
+
+            uint64_t values() const { return m_values; }
+            uint64_t nodes() const { return m_values + m_compounds; }
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void beginMap() override;
+            void endMap() override;
+
+            void key (const std::string &) override;
+
+            void intValue (int32_t) override;
+            void longValue (int64_t) override;
+            void boolValue (bool) override;
+            void doubleValue (double) override;
+            void stringValue (std::string_view) override;
+            void enumValue (std::string_view) override;
+            void binaryValue (std::string_view) override;
+            void numberValue (std::string_view) override;
+            void nullValue() override;
+
+            void object (size_t) override;
+            bool reference (size_t) override;
+    };
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,445 @@
+#include "JsonWriter.h"
+
+#include <cmath>
+#include <cerrno>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "amqp/Format.h"
+#include "amqp/BinaryEncoding.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * How much we'll buffer before draining to the descriptor
+     */
+    const size_t HIGH_WATER = 64 * 1024;
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+JsonWriter::JsonWriter (Style style_, int fd_, Binary binary_)
+    : m_style (style_)
+    , m_fd (fd_)
+    , m_binary (binary_)
+    , m_keyed (false)
+{
+    m_buffer.reserve (m_fd < 0 ? 4096 : 2 * HIGH_WATER);
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+JsonWriter::~JsonWriter() {
+    try {
+        flush();
+    } catch (...) {
+        // nowhere left to report it
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::flush() {
+    if (m_fd < 0) {
+        return;
+    }
+
+    const char * p = m_buffer.data();
+    size_t left = m_buffer.size();
+
+    while (left) {
+        auto written = ::write (m_fd, p, left);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            m_buffer.clear();
+            throw std::runtime_error ("Failed to write output");
+        }
+
+        p += written;
+        left -= written;
+    }
+
+    m_buffer.clear();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::finish() {
+    m_buffer.append (1, '\n');
+    flush();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::reset() {
+    m_buffer.clear();
+    m_frames.clear();
+    m_keyed = false;
+}
+
+/******************************************************************************/
+
+/**
+ * Are we about to write the key of a map entry
+ */
+bool
+amqp::internal::reader::
+JsonWriter::mapKey() const {
+    return !m_keyed
+        && !m_frames.empty()
+        && m_frames.back().map
+        && !m_frames.back().pairs
+        && m_frames.back().count % 2 == 0;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::indent() {
+    if (m_style == pretty_t) {
+        m_buffer.append (1, '\n').append (2 * m_frames.size(), ' ');
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * @param compound_ the value about to be written is a composite, list or
+ * map, which if it's the first key of a map decides how that's written
+ */
+void
+amqp::internal::reader::
+JsonWriter::separate (bool compound_) {
+    if (m_keyed) {
+        m_keyed = false;
+        return;
+    }
+
+    finishPair();
+
+    if (m_frames.empty()) {
+        return;
+    }
+
+    auto * frame = &m_frames.back();
+
+    if (frame->pending) {
+        frame->pending = false;
+        frame->pairs = compound_;
+        frame->object = !compound_;
+
+        m_buffer.append (1, compound_ ? '[' : '{');
+    }
+
+    /*
+     * Only ever on top at a key, so every entry starts a new pair
+     */
+    if (frame->pairs) {
+        if (frame->count) {
+            m_buffer.append (1, ',');
+        }
+
+        indent();
+        ++frame->count;
+
+        m_buffer.append (1, '[');
+        m_frames.push_back ({ false, false, 0, false, false, true });
+        frame = &m_frames.back();
+    }
+
+    if (frame->map && frame->count % 2) {
+        m_buffer.append (m_style == pretty_t ? ": " : ":");
+    } else {
+        if (frame->count) {
+            m_buffer.append (1, ',');
+        }
+
+        indent();
+    }
+
+    ++frame->count;
+
+    if (m_fd >= 0 && m_buffer.size() > HIGH_WATER) {
+        flush();
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * A pair is left open after its value in case that's a compound, it's
+ * closed by whatever comes next in the map
+ */
+void
+amqp::internal::reader::
+JsonWriter::finishPair() {
+    if (!m_frames.empty() && m_frames.back().pair && m_frames.back().count == 2) {
+        pop (']');
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::open (char bracket_, bool map_, bool object_) {
+    if (mapKey() && !m_frames.back().pending) {
+        throw std::runtime_error (
+            "JSON map written with scalar keys can't take a compound one");
+    }
+
+    separate (true);
+
+    if (map_) {
+        m_frames.push_back ({ true, true, 0, true, false, false });
+    } else {
+        m_buffer.append (1, bracket_);
+        m_frames.push_back ({ false, object_, 0, false, false, false });
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::close (char bracket_) {
+    finishPair();
+
+    if (m_frames.empty()) {
+        throw std::runtime_error ("Unbalanced JSON");
+    }
+
+    auto & frame = m_frames.back();
+
+    if (frame.pending) {
+        m_frames.pop_back();
+        m_buffer.append ("{}");
+    } else {
+        pop (frame.pairs ? ']' : bracket_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::pop (char bracket_) {
+    auto count = m_frames.back().count;
+    m_frames.pop_back();
+
+    if (count) {
+        indent();
+    }
+
+    m_buffer.append (1, bracket_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::quoted (std::string_view value_) {
+    appendJsonString (m_buffer, value_);
+}
+
+/******************************************************************************/
+
+/**
+ * Numbers and booleans are written bare unless they're the key of a map
+ */
+void
+amqp::internal::reader::
+JsonWriter::scalar (std::string_view value_) {
+    auto key = mapKey();
+
+    separate();
+
+    if (key) {
+        quoted (value_);
+    } else {
+        m_buffer.append (value_);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::beginComposite (const std::string &) {
+    open ('{', false, true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endComposite() {
+    close ('}');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::beginList() {
+    open ('[', false, false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endList() {
+    close (']');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::beginMap() {
+    open ('{', true, true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endMap() {
+    close ('}');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::key (const std::string & key_) {
+    if (m_frames.empty() || !m_frames.back().object || m_frames.back().map) {
+        throw std::runtime_error ("JSON keys only belong in objects");
+    }
+
+    separate();
+    quoted (key_);
+    m_buffer.append (m_style == pretty_t ? ": " : ":");
+
+    m_keyed = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::intValue (int32_t value_) {
+    NumberBuffer buffer;
+    scalar (toChars (buffer, value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::longValue (int64_t value_) {
+    NumberBuffer buffer;
+    scalar (toChars (buffer, value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::boolValue (bool value_) {
+    scalar (value_ ? "true" : "false");
+}
+
+/******************************************************************************/
+
+/**
+ * JSON has no way to write NaN or infinity
+ */
+void
+amqp::internal::reader::
+JsonWriter::doubleValue (double value_) {
+    if (!std::isfinite (value_)) {
+        scalar ("null");
+        return;
+    }
+
+    NumberBuffer buffer;
+    scalar (toChars (buffer, value_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::stringValue (std::string_view value_) {
+    separate();
+    quoted (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::enumValue (std::string_view value_) {
+    separate();
+    quoted (value_);
+}
+
+/******************************************************************************/
+
+/**
+ * Encoded straight into the buffer, neither encoding has anything in it
+ * that would need escaping
+ */
+void
+amqp::internal::reader::
+JsonWriter::binaryValue (std::string_view value_) {
+    separate();
+
+    auto * bytes = reinterpret_cast<const uint8_t *>(value_.data());
+    auto at = m_buffer.size();
+
+    if (m_binary == base64_t) {
+        m_buffer.resize (at + base64Length (value_.size()) + 2, '"');
+        toBase64 (bytes, value_.size(), m_buffer.data() + at + 1);
+    } else {
+        m_buffer.resize (at + hexLength (value_.size()) + 2, '"');
+        toHex (bytes, value_.size(), m_buffer.data() + at + 1);
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::numberValue (std::string_view value_) {
+    scalar (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::nullValue() {
+    scalar ("null");
+}
+
+/******************************************************************************/
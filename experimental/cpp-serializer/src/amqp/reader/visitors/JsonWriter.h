@@ -0,0 +1,142 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Writes values out as JSON as they're visited, in a single pass, into
+     * one growing buffer. Given a file descriptor that buffer is drained to
+     * it whenever it gets large so memory use doesn't grow with the blob.
+     *
+     * Composites become objects and lists arrays. Maps whose keys are
+     * scalars become objects as well with those keys written as strings,
+     * anything keyed by composites or lists becomes an array of
+     * [key, value] pairs instead. Which it is gets decided by the first
+     * key, so a map's opening bracket waits for it.
+     */
+    class JsonWriter : public amqp::reader::IVisitor {
+        public :
+            enum Style { compact_t, pretty_t };
+
+            /**
+             * How binary values are written, as strings either way
+             */
+            enum Binary { hex_t, base64_t };
+
+        private :
+            struct Frame {
+                bool   map;
+                bool   object;
+                size_t count;
+
+                /**
+                 * A map that hasn't seen its first key, nothing written yet
+                 */
+                bool   pending;
+
+                /**
+                 * A map being written as an array of pairs
+                 */
+                bool   pairs;
+
+                /**
+                 * One of those pairs, closed once it holds both halves
+                 */
+                bool   pair;
+            };
+
+            Style  m_style;
+            int    m_fd;
+            Binary m_binary;
+
+            std::string m_buffer;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Set by [key], the next value belongs to it
+             */
+            bool m_keyed;
+
+            bool mapKey() const;
+
+            void indent();
+            void separate (bool compound_ = false);
+            void finishPair();
+
+            void open (char, bool map_, bool object_);
+            void close (char);
+            void pop (char);
+
+            void quoted (std::string_view);
+            void scalar (std::string_view);
+
+        public :
+            /**
+             * @param fd_ where to write the output, -1 to keep it all in
+             * the buffer for [str]
+             */
+            explicit JsonWriter (
+                Style = compact_t,
+                int fd_ = -1,
+                Binary = hex_t);
+
+            JsonWriter (const JsonWriter &) = delete;
+
+            ~JsonWriter() override;
+
+            /**
+             * Write out anything buffered, a no op without a descriptor
+             */
+            void flush();
+
+            /**
+             * End a top level value with a newline and flush
+             */
+            void finish();
+
+            const std::string & str() const { return m_buffer; }
+
+            /**
+             * Start again on a new top level value, dropping anything still
+             * buffered but keeping the buffer's capacity
+             */
+            void reset();
+
+            Style style() const { return m_style; }
+            Binary binary() const { return m_binary; }
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void beginMap() override;
+            void endMap() override;
+
+            void key (const std::string &) override;
+
+            void intValue (int32_t) override;
+            void longValue (int64_t) override;
+            void boolValue (bool) override;
+            void doubleValue (double) override;
+            void stringValue (std::string_view) override;
+            void enumValue (std::string_view) override;
+            void binaryValue (std::string_view) override;
+            void numberValue (std::string_view) override;
+            void nullValue() override;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,293 @@
+#include "RecordingVisitor.h"
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::text (Kind kind_, std::string_view text_) {
+    Event event { kind_, { 0 }, m_text.size(), text_.size() };
+
+    m_text.append (text_);
+    m_events.push_back (event);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+RecordingVisitor::textOf (const Event & event_) const {
+    return std::string_view (m_text).substr (event_.offset, event_.length);
+}
+
+/******************************************************************************/
+
+/**
+ * @return the index of the event after the value starting at [i_]
+ */
+size_t
+amqp::internal::reader::
+RecordingVisitor::skip (size_t i_) const {
+    size_t depth { 0 };
+
+    do {
+        switch (m_events[i_].kind) {
+            case beginComposite_t :
+            case beginList_t :
+            case beginMap_t :
+                ++depth;
+                break;
+            case endComposite_t :
+            case endList_t :
+            case endMap_t :
+                --depth;
+                break;
+            default :
+                break;
+        }
+
+        ++i_;
+    // a reference, or a key, is always followed by the value it's for
+    } while (depth || m_events[i_ - 1].kind == reference_t || m_events[i_ - 1].kind == key_t);
+
+    return i_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::beginComposite (const std::string & type_) {
+    text (beginComposite_t, type_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::endComposite() {
+    m_events.push_back (Event { endComposite_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::beginList() {
+    m_events.push_back (Event { beginList_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::endList() {
+    m_events.push_back (Event { endList_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::beginMap() {
+    m_events.push_back (Event { beginMap_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::endMap() {
+    m_events.push_back (Event { endMap_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::key (const std::string & key_) {
+    text (key_t, key_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::intValue (int32_t value_) {
+    m_events.push_back (Event { int_t, { value_ }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::longValue (int64_t value_) {
+    m_events.push_back (Event { long_t, { value_ }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::boolValue (bool value_) {
+    m_events.push_back (Event { bool_t, { value_ }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::doubleValue (double value_) {
+    Event event { double_t, { 0 }, 0, 0 };
+    event.d = value_;
+
+    m_events.push_back (event);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::stringValue (std::string_view value_) {
+    text (string_t, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::enumValue (std::string_view value_) {
+    text (enum_t, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::binaryValue (std::string_view value_) {
+    text (binary_t, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::numberValue (std::string_view value_) {
+    text (number_t, value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::nullValue() {
+    m_events.push_back (Event { null_t, { 0 }, 0, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::object (size_t object_) {
+    Event event { object_t, { 0 }, 0, 0 };
+    event.n = object_;
+
+    m_events.push_back (event);
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+RecordingVisitor::reference (size_t object_) {
+    Event event { reference_t, { 0 }, 0, 0 };
+    event.n = object_;
+
+    m_events.push_back (event);
+
+    return false;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::replay (
+        amqp::reader::IVisitor & visitor_,
+        size_t objects_
+) const {
+    for (size_t i { 0 } ; i < m_events.size() ; ++i) {
+        const auto & event = m_events[i];
+
+        switch (event.kind) {
+            case beginComposite_t :
+                visitor_.beginComposite (std::string (textOf (event)));
+                break;
+            case endComposite_t :
+                visitor_.endComposite();
+                break;
+            case beginList_t :
+                visitor_.beginList();
+                break;
+            case endList_t :
+                visitor_.endList();
+                break;
+            case beginMap_t :
+                visitor_.beginMap();
+                break;
+            case endMap_t :
+                visitor_.endMap();
+                break;
+            case key_t :
+                visitor_.key (std::string (textOf (event)));
+                break;
+            case int_t :
+                visitor_.intValue (static_cast<int32_t>(event.l));
+                break;
+            case long_t :
+                visitor_.longValue (event.l);
+                break;
+            case bool_t :
+                visitor_.boolValue (event.l != 0);
+                break;
+            case double_t :
+                visitor_.doubleValue (event.d);
+                break;
+            case string_t :
+                visitor_.stringValue (textOf (event));
+                break;
+            case enum_t :
+                visitor_.enumValue (textOf (event));
+                break;
+            case binary_t :
+                visitor_.binaryValue (textOf (event));
+                break;
+            case number_t :
+                visitor_.numberValue (textOf (event));
+                break;
+            case null_t :
+                visitor_.nullValue();
+                break;
+            case object_t :
+                visitor_.object (event.n + objects_);
+                break;
+            case reference_t :
+                // skip the revisit we recorded if it isn't wanted, leaving
+                // us on the last event of it
+                if (visitor_.reference (event.n)) {
+                    i = skip (i + 1) - 1;
+                }
+                break;
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+RecordingVisitor::clear() {
+    m_events.clear();
+    m_text.clear();
+}
+
+/******************************************************************************/
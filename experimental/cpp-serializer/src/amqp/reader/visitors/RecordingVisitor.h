@@ -0,0 +1,105 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Remembers everything it's shown so it can be played back to another
+     * visitor later, which lets part of a blob be decoded off to one side,
+     * on another thread say, and then stitched into the output in the right
+     * place.
+     *
+     * We can't know how whoever we're eventually replayed to will want to
+     * treat references so we always ask for the original to be revisited,
+     * remembering it was a reference so the replay can ask for real and
+     * skip over the revisit if it's told to.
+     */
+    class RecordingVisitor : public amqp::reader::IVisitor {
+        private :
+            enum Kind : uint8_t {
+                beginComposite_t, endComposite_t, beginList_t, endList_t,
+                beginMap_t, endMap_t, key_t, int_t, long_t, bool_t,
+                double_t, string_t, enum_t, binary_t, number_t, null_t,
+                object_t, reference_t
+            };
+
+            struct Event {
+                Kind kind;
+
+                union {
+                    int64_t l;
+                    double  d;
+                    size_t  n;
+                };
+
+                /**
+                 * Where any text is in m_text
+                 */
+                size_t offset;
+                size_t length;
+            };
+
+            std::vector<Event> m_events;
+
+            /**
+             * Every string we've been given, back to back
+             */
+            std::string m_text;
+
+            void text (Kind, std::string_view);
+
+            std::string_view textOf (const Event &) const;
+
+            size_t skip (size_t) const;
+
+        public :
+            RecordingVisitor() = default;
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void beginMap() override;
+            void endMap() override;
+
+            void key (const std::string &) override;
+
+            void intValue (int32_t) override;
+            void longValue (int64_t) override;
+            void boolValue (bool) override;
+            void doubleValue (double) override;
+            void stringValue (std::string_view) override;
+            void enumValue (std::string_view) override;
+            void binaryValue (std::string_view) override;
+            void numberValue (std::string_view) override;
+            void nullValue() override;
+
+            void object (size_t) override;
+            bool reference (size_t) override;
+
+            /**
+             * @param objects_ added to the number of every object we saw
+             * finish, we may well have been recording somewhere that didn't
+             * know how many objects came before it
+             */
+            void replay (amqp::reader::IVisitor &, size_t objects_ = 0) const;
+
+            size_t size() const { return m_events.size(); }
+
+            void clear();
+    };
+
+}
+
+/******************************************************************************/
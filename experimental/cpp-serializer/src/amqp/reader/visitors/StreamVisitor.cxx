@@ -0,0 +1,211 @@
+#include "StreamVisitor.h"
+
+#include <string>
+#include <ostream>
+
+#include "amqp/Format.h"
+#include "amqp/BinaryEncoding.h"
+
+/******************************************************************************/
+
+amqp::internal::reader::
+StreamVisitor::StreamVisitor (std::ostream & stream_)
+    : m_stream (stream_)
+    , m_keyed (false)
+{
+}
+
+/******************************************************************************/
+
+template<typename T>
+void
+amqp::internal::reader::
+StreamVisitor::number (T value_) {
+    NumberBuffer buffer;
+
+    auto text = toChars (buffer, value_);
+    m_stream.write (text.data(), text.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Elements are separated by commas except within a map where a key is
+ * separated from its value by a colon
+ */
+void
+amqp::internal::reader::
+StreamVisitor::separate() {
+    if (m_keyed) {
+        m_keyed = false;
+        return;
+    }
+
+    if (m_frames.empty()) {
+        return;
+    }
+
+    auto & frame = m_frames.back();
+
+    if (frame.count) {
+        m_stream << ((frame.map && frame.count % 2) ? " : " : ", ");
+    }
+
+    ++frame.count;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::beginComposite (const std::string &) {
+    separate();
+    m_stream << "{ ";
+    m_frames.push_back ({ false, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::endComposite() {
+    m_frames.pop_back();
+    m_stream << " }";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::beginList() {
+    separate();
+    m_stream << "[ ";
+    m_frames.push_back ({ false, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::endList() {
+    m_frames.pop_back();
+    m_stream << " ]";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::beginMap() {
+    separate();
+    m_stream << "{ ";
+    m_frames.push_back ({ true, 0 });
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::endMap() {
+    m_frames.pop_back();
+    m_stream << " }";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::key (const std::string & key_) {
+    separate();
+    m_stream << key_ << " : ";
+    m_keyed = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::intValue (int32_t value_) {
+    separate();
+    number (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::longValue (int64_t value_) {
+    separate();
+    number (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::boolValue (bool value_) {
+    separate();
+    m_stream << (value_ ? '1' : '0');
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::doubleValue (double value_) {
+    separate();
+    number (value_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::stringValue (std::string_view value_) {
+    separate();
+    m_stream << '"' << value_ << '"';
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::enumValue (std::string_view value_) {
+    separate();
+    m_stream << value_;
+}
+
+/******************************************************************************/
+
+/**
+ * As hex, through a buffer we keep so its storage is reused
+ */
+void
+amqp::internal::reader::
+StreamVisitor::binaryValue (std::string_view value_) {
+    m_scratch.resize (hexLength (value_.size()));
+    toHex (reinterpret_cast<const uint8_t *>(value_.data()), value_.size(), m_scratch.data());
+
+    separate();
+    m_stream << '"' << m_scratch << '"';
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::numberValue (std::string_view value_) {
+    separate();
+    m_stream << value_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+StreamVisitor::nullValue() {
+    separate();
+    m_stream << "null";
+}
+
+/******************************************************************************/
@@ -0,0 +1,77 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Writes values out as they are visited in the same form [IValue::dump]
+     * produces without ever building the tree
+     */
+    class StreamVisitor : public amqp::reader::IVisitor {
+        private :
+            struct Frame {
+                bool   map;
+                size_t count;
+            };
+
+            std::ostream & m_stream;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * Set by [key], the separator for the next value has already
+             * been written
+             */
+            bool m_keyed;
+
+            /**
+             * Somewhere to encode binary values
+             */
+            std::string m_scratch;
+
+            void separate();
+
+            /**
+             * Through std::to_chars rather than the stream's own formatting
+             */
+            template<typename T>
+            void number (T);
+
+        public :
+            explicit StreamVisitor (std::ostream &);
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void beginMap() override;
+            void endMap() override;
+
+            void key (const std::string &) override;
+
+            void intValue (int32_t) override;
+            void longValue (int64_t) override;
+            void boolValue (bool) override;
+            void doubleValue (double) override;
+            void stringValue (std::string_view) override;
+            void enumValue (std::string_view) override;
+            void binaryValue (std::string_view) override;
+            void numberValue (std::string_view) override;
+            void nullValue() override;
+    };
+
+}
+
+/******************************************************************************/
+
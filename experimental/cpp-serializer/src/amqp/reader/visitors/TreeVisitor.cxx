@@ -0,0 +1,451 @@
+#include "TreeVisitor.h"
+
+#include <stdexcept>
+
+#include "amqp/reader/Reader.h"
+
+#include "amqp/Format.h"
+#include "amqp/BinaryEncoding.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    /**
+     * Owns the arena for a tree. Nothing in the tree holds memory from
+     * anywhere else so it's never destroyed as such, it simply goes with
+     * the arena.
+     */
+    class Rooted : public amqp::reader::IValue {
+        private :
+            uPtr<std::pmr::monotonic_buffer_resource> m_arena;
+            const amqp::reader::IValue * m_root;
+
+        public :
+            Rooted (
+                uPtr<std::pmr::monotonic_buffer_resource> arena_,
+                uPtr<amqp::reader::IValue> root_
+            ) : m_arena (std::move (arena_))
+              , m_root (root_.release())
+            { }
+
+            std::string dump() const override {
+                return m_root->dump();
+            }
+
+            void dumpTo (std::string & out_) const override {
+                m_root->dumpTo (out_);
+            }
+    };
+
+    /**
+     * When sharing, values that might be referred back to are built without
+     * a name and given one by this
+     */
+    class Named : public Value {
+        private :
+            std::pmr::string m_name;
+            uPtr<amqp::reader::IValue> m_value;
+
+        public :
+            Named (std::pmr::string name_, uPtr<amqp::reader::IValue> value_)
+                : m_name (std::move (name_))
+                , m_value (std::move (value_))
+            { }
+
+            void dumpTo (std::string & out_) const override {
+                out_.append (m_name).append (" : ");
+                m_value->dumpTo (out_);
+            }
+    };
+
+    /**
+     * Where the blob referred back to an object, the value is owned by
+     * wherever that object was first seen
+     */
+    class Shared : public Value {
+        private :
+            std::optional<std::pmr::string> m_name;
+            const amqp::reader::IValue * m_value;
+
+        public :
+            Shared (
+                std::optional<std::pmr::string> name_,
+                const amqp::reader::IValue * value_
+            ) : m_name (std::move (name_))
+              , m_value (value_)
+            { }
+
+            void dumpTo (std::string & out_) const override {
+                if (m_name) {
+                    out_.append (*m_name).append (" : ");
+                }
+
+                m_value->dumpTo (out_);
+            }
+    };
+
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+TreeVisitor::TreeVisitor (bool share_)
+    : m_arena (std::make_unique<std::pmr::monotonic_buffer_resource> (4096))
+    , m_share (share_)
+    , m_last (nullptr)
+{
+}
+
+/******************************************************************************/
+
+template<class T, typename ... Args>
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+TreeVisitor::make (Args && ... args_) {
+    return uPtr<amqp::reader::IValue> (
+            new (m_arena.get()) T (std::forward<Args> (args_)...));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::add (uPtr<amqp::reader::IValue> value_) {
+    if (m_frames.empty()) {
+        m_result = std::move (value_);
+    } else {
+        m_frames.back().values.emplace_back (std::move (value_));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Values that might be objects, when we're sharing them, are remembered
+ * before they're given a name
+ */
+void
+amqp::internal::reader::
+TreeVisitor::add (
+        Name name_,
+        uPtr<amqp::reader::IValue> value_
+) {
+    m_last = value_.get();
+
+    if (name_) {
+        add (make<Named> (std::move (*name_), std::move (value_)));
+    } else {
+        add (std::move (value_));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * When sharing any scalar might be an object, strings in a list for
+ * instance, so they're all remembered
+ */
+void
+amqp::internal::reader::
+TreeVisitor::scalar (std::pmr::string value_) {
+    if (m_share) {
+        Name name;
+        name.swap (m_key);
+
+        add (std::move (name), make<TypedSingle<std::pmr::string>> (std::move (value_)));
+    } else if (m_key) {
+        add (make<TypedPair<std::pmr::string>> (
+                *m_key, std::move (value_), m_arena.get()));
+        m_key.reset();
+    } else {
+        add (make<TypedSingle<std::pmr::string>> (std::move (value_)));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::begin (Kind kind_) {
+    m_frames.push_back ({ kind_, std::move (m_key), Values { m_arena.get() } });
+    m_key.reset();
+}
+
+/******************************************************************************/
+
+/**
+ * Composites and maps are both rendered as { }, the entries of a map are
+ * paired up into [ValuePair]s first. Lists are rendered as [ ].
+ */
+void
+amqp::internal::reader::
+TreeVisitor::end() {
+    if (m_frames.empty()) {
+        throw std::runtime_error ("Unbalanced end");
+    }
+
+    auto frame = std::move (m_frames.back());
+    m_frames.pop_back();
+
+    Name name;
+
+    if (m_share) {
+        name.swap (frame.name);
+    }
+
+    uPtr<amqp::reader::IValue> value;
+
+    if (frame.kind == list_t) {
+        List list {
+            std::make_move_iterator (frame.values.begin()),
+            std::make_move_iterator (frame.values.end()),
+            m_arena.get()
+        };
+
+        if (frame.name) {
+            value = make<TypedPair<List>> (
+                    *frame.name, std::move (list), m_arena.get());
+        } else {
+            value = make<TypedSingle<List>> (std::move (list));
+        }
+    } else {
+        if (frame.kind == map_t) {
+            Values pairs { m_arena.get() };
+            pairs.reserve (frame.values.size() / 2);
+
+            for (size_t i { 0 } ; i + 1 < frame.values.size() ; i += 2) {
+                pairs.emplace_back (make<ValuePair> (
+                        std::move (frame.values[i]),
+                        std::move (frame.values[i + 1])));
+            }
+
+            frame.values = std::move (pairs);
+        }
+
+        if (frame.name) {
+            value = make<TypedPair<Values>> (
+                    *frame.name, std::move (frame.values), m_arena.get());
+        } else {
+            value = make<TypedSingle<Values>> (std::move (frame.values));
+        }
+    }
+
+    if (m_share) {
+        add (std::move (name), std::move (value));
+    } else {
+        add (std::move (value));
+    }
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+TreeVisitor::result() {
+    if (!m_result) {
+        return nullptr;
+    }
+
+    auto root = std::make_unique<Rooted> (
+            std::move (m_arena), std::move (m_result));
+
+    m_arena = std::make_unique<std::pmr::monotonic_buffer_resource> (4096);
+    m_objects.clear();
+    m_last = nullptr;
+
+    return root;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::beginComposite (const std::string &) {
+    begin (composite_t);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::endComposite() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::beginList() {
+    begin (list_t);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::endList() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::beginMap() {
+    begin (map_t);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::endMap() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::key (const std::string & key_) {
+    m_key.emplace (key_, m_arena.get());
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::intValue (int32_t value_) {
+    std::pmr::string value (m_arena.get());
+    appendNumber (value, value_);
+
+    scalar (std::move (value));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::longValue (int64_t value_) {
+    std::pmr::string value (m_arena.get());
+    appendNumber (value, value_);
+
+    scalar (std::move (value));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::boolValue (bool value_) {
+    std::pmr::string value (m_arena.get());
+    appendNumber (value, value_);
+
+    scalar (std::move (value));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::doubleValue (double value_) {
+    std::pmr::string value (m_arena.get());
+    appendNumber (value, value_);
+
+    scalar (std::move (value));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::stringValue (std::string_view value_) {
+    std::pmr::string quoted (m_arena.get());
+    quoted.reserve (value_.size() + 2);
+    quoted.append (1, '"').append (value_).append (1, '"');
+
+    scalar (std::move (quoted));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::nullValue() {
+    scalar (std::pmr::string ("null", m_arena.get()));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::enumValue (std::string_view value_) {
+    scalar (std::pmr::string (value_, m_arena.get()));
+}
+
+/******************************************************************************/
+
+/**
+ * As hex
+ */
+void
+amqp::internal::reader::
+TreeVisitor::binaryValue (std::string_view value_) {
+    std::pmr::string quoted (hexLength (value_.size()) + 2, '"', m_arena.get());
+    toHex (reinterpret_cast<const uint8_t *>(value_.data()), value_.size(), quoted.data() + 1);
+
+    scalar (std::move (quoted));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::numberValue (std::string_view value_) {
+    scalar (std::pmr::string (value_, m_arena.get()));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+TreeVisitor::object (size_t object_) {
+    if (!m_share) {
+        return;
+    }
+
+    if (object_ >= m_objects.size()) {
+        m_objects.resize (object_ + 1, nullptr);
+    }
+
+    m_objects[object_] = m_last;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+TreeVisitor::reference (size_t object_) {
+    if (!m_share) {
+        return false;
+    }
+
+    if (object_ >= m_objects.size() || !m_objects[object_]) {
+        throw std::runtime_error (
+                "Reference to object " + std::to_string (object_)
+                    + " before it was read");
+    }
+
+    Name name;
+    name.swap (m_key);
+
+    add (make<Shared> (std::move (name), m_objects[object_]));
+
+    return true;
+}
+
+/******************************************************************************/
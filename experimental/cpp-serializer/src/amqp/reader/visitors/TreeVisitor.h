@@ -0,0 +1,113 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <memory_resource>
+
+#include "types.h"
+
+#include "amqp/reader/IReader.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Rebuilds the tree of [IValue]s the readers used to construct
+     * directly, this is what [Reader::dump] is built on.
+     *
+     * Every node, container and string in the tree, names and keys
+     * included, is carved out of a single arena that belongs to the root
+     * handed back by [result], so dropping the tree is one release of the
+     * arena without visiting a single value.
+     *
+     * Built to share, a reference in the blob becomes a node pointing at
+     * the value already built for the object it refers to rather than a
+     * copy of it, so the tree only ever grows with the unique objects.
+     */
+    class TreeVisitor : public amqp::reader::IVisitor {
+        private :
+            enum Kind { composite_t, list_t, map_t };
+
+            using Values = std::pmr::vector<uPtr<amqp::reader::IValue>>;
+            using List = std::pmr::list<uPtr<amqp::reader::IValue>>;
+
+            using Name = std::optional<std::pmr::string>;
+
+            struct Frame {
+                Kind kind;
+                Name name;
+                Values values;
+            };
+
+            uPtr<std::pmr::monotonic_buffer_resource> m_arena;
+
+            std::vector<Frame> m_frames;
+
+            /**
+             * The name given to the next value by [key]
+             */
+            Name m_key;
+
+            uPtr<amqp::reader::IValue> m_result;
+
+            const bool m_share;
+
+            /**
+             * When sharing, the value each numbered object was built as and
+             * the last value we built that might be one
+             */
+            std::vector<const amqp::reader::IValue *> m_objects;
+            const amqp::reader::IValue * m_last;
+
+            template<class T, typename ... Args>
+            uPtr<amqp::reader::IValue> make (Args && ...);
+
+            void add (uPtr<amqp::reader::IValue>);
+            void add (Name, uPtr<amqp::reader::IValue>);
+            void scalar (std::pmr::string);
+
+            void begin (Kind);
+            void end();
+
+        public :
+            explicit TreeVisitor (bool share_ = false);
+
+            /**
+             * Hands over the finished tree, along with the arena it lives in
+             */
+            uPtr<amqp::reader::IValue> result();
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void beginMap() override;
+            void endMap() override;
+
+            void key (const std::string &) override;
+
+            void intValue (int32_t) override;
+            void longValue (int64_t) override;
+            void boolValue (bool) override;
+            void doubleValue (double) override;
+            void stringValue (std::string_view) override;
+            void enumValue (std::string_view) override;
+            void binaryValue (std::string_view) override;
+            void numberValue (std::string_view) override;
+            void nullValue() override;
+
+            void object (size_t) override;
+            bool reference (size_t) override;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -53,12 +53,9 @@ namespace amqp::internal::schema {
 
             const std::string & descriptor() const;
 
-            const std::string & name() const;
+            const std::string & name() const override;
 
             virtual Type type() const = 0;
-
-            virtual int dependsOnRHS (const Restricted &) const = 0;
-            virtual int dependsOnRHS (const Composite &) const = 0;
     };
 
 }
@@ -1,21 +0,0 @@
-#include "amqp/schema/Descriptors.h"
-
-/******************************************************************************/
-
-namespace amqp::schema::descriptors {
-
-    const int ENVELOPE              =  1;
-    const int SCHEMA                =  2;
-    const int OBJECT                =  3;
-    const int FIELD                 =  4;
-    const int COMPOSITE_TYPE        =  5;
-    const int RESTRICTED_TYPE       =  6;
-    const int CHOICE                =  7;
-    const int REFERENCED_OBJECT     =  8;
-    const int TRANSFORM_SCHEMA      =  9;
-    const int TRANSFORM_ELEMENT     = 10;
-    const int TRANSFORM_ELEMENT_KEY = 11;
-
-}
-
-/******************************************************************************/
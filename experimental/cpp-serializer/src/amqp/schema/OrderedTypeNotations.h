@@ -1,8 +1,12 @@
 #pragma once
 
 #include <list>
+#include <vector>
 #include <ostream>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
 #include "debug.h"
 #include "types.h"
@@ -36,7 +40,14 @@ namespace amqp::internal::schema {
         public :
             virtual ~OrderedTypeNotation() = default;
 
-            virtual int dependsOn (const OrderedTypeNotation &) const = 0;
+            virtual const std::string & name() const = 0;
+
+            /**
+             * The names of the types that need to come before this one. Names
+             * that aren't of another type in the same set, primitives for
+             * instance, and our own name are ignored.
+             */
+            virtual std::vector<std::string_view> dependencies() const = 0;
     };
 
 }
@@ -45,22 +56,34 @@ namespace amqp::internal::schema {
 
 namespace amqp::internal::schema {
 
+    /**
+     * Orders a set of type notations into levels such that everything a
+     * type depends on is in an earlier level than it is.
+     *
+     * Types are collected as they're inserted and only ordered when the
+     * levels are first iterated over, at which point a dependency graph is
+     * built from their names and sorted topologically in a single pass, so
+     * ordering is linear in the number of types and dependencies between
+     * them.
+     *
+     * Whoever builds the set should iterate it once before sharing it,
+     * as Schema's constructor does, so later readers never reorder.
+     */
     template<class T>
     class OrderedTypeNotations {
         private:
-            std::list<std::list<uPtr<T>>> m_schemas;
+            mutable std::list<std::list<uPtr<T>>> m_schemas;
 
-        public :
-            typedef decltype(m_schemas.begin()) iterator;
+            /**
+             * Inserted but yet to be given a level
+             */
+            mutable std::vector<uPtr<T>> m_unordered;
 
-        private:
-            void insert (uPtr<T> &&, iterator);
-            void insertNewList (uPtr<T> &&);
-            void insertNewList (
-                    uPtr<T> &&,
-                    typename std::list<std::list<uPtr<T>>>::iterator &);
+            void order() const;
 
         public :
+            typedef decltype(m_schemas.begin()) iterator;
+
             void insert (uPtr<T> && ptr);
 
             friend std::ostream & ::operator << <> (
@@ -68,10 +91,12 @@ namespace amqp::internal::schema {
                     const amqp::internal::schema::OrderedTypeNotations<T> &);
 
             decltype (m_schemas.cbegin()) begin() const {
+                order();
                 return m_schemas.cbegin();
             }
 
             decltype (m_schemas.cend()) end() const {
+                order();
                 return m_schemas.cend();
             }
     };
@@ -87,7 +112,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<T> &otn_
 ) {
     int idx1 {0};
-    for (const auto &i : otn_.m_schemas) {
+    for (const auto &i : otn_) {
         stream_ << "level " << ++idx1 << std::endl;
         for (const auto &j : i) {
             stream_ << "    * " << j->name() << std::endl;
@@ -103,103 +128,100 @@ operator << (
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(uPtr<T> && ptr) {
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.emplace_back(std::move (l));
+OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
+    DBG ("Insert: " << ptr->name() << std::endl);
+
+    m_unordered.emplace_back (std::move (ptr));
 }
 
 /******************************************************************************/
 
 /**
- * This could be a bit more space efficient by checking the previous element
- * for dependendies again as its possible we are moving multiple elements "up"
- * but the extra checks probably don't make it worth it.
+ * Kahn's algorithm, a level at a time. Anything inserted after we last
+ * ordered means starting again from everything, which is still linear.
  */
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(
-        uPtr<T> && ptr,
-        typename std::list<std::list<uPtr<T>>>::iterator & here_)
-{
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.insert(here_, std::move (l));
-}
+OrderedTypeNotations<T>::order() const {
+    if (m_unordered.empty()) {
+        return;
+    }
 
-/******************************************************************************/
+    std::vector<uPtr<T>> types;
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
-    return insert (std::move (ptr), m_schemas.begin());
-}
+    for (auto & level : m_schemas) {
+        for (auto & type : level) {
+            types.emplace_back (std::move (type));
+        }
+    }
 
-/******************************************************************************/
+    m_schemas.clear();
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (
-        uPtr<T> && ptr,
-        amqp::internal::schema::OrderedTypeNotations<T>::iterator l_
-) {
-    DBG ("Insert: " << ptr->name() << std::endl);
-    /*
-     * First we find where this element needs to be added
-     */
-    amqp::internal::schema::OrderedTypeNotations<T>::iterator insertionPoint { l_ };
-
-    for (auto i = l_ ; i != m_schemas.end() ; ++i) {
-        for (const auto & j : *i) {
-            /*
-             * A score of 0 means no dependencies at all
-             * A score of 1 means "j" has a dependency on what's being inserted
-             * A score of 2 means what's being inserted depends on "j"
-             */
-            auto score = j->dependsOn(*ptr);
+    for (auto & type : m_unordered) {
+        types.emplace_back (std::move (type));
+    }
+
+    m_unordered.clear();
 
-            if (score == 1) {
-                insertionPoint = std::next(i);
-            } else if (score == 2) {
-                insertionPoint = i;
-                goto done;
+    std::unordered_map<std::string_view, size_t> byName;
+    byName.reserve (types.size());
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        byName.emplace (types[i]->name(), i);
+    }
+
+    // for each type how many of its dependencies are yet to be given a
+    // level and which types depend on it
+    std::vector<size_t> waitingOn (types.size(), 0);
+    std::vector<std::vector<size_t>> dependents (types.size());
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        for (const auto & dependency : types[i]->dependencies()) {
+            auto it = byName.find (dependency);
+
+            if (it != byName.end() && it->second != i) {
+                dependents[it->second].push_back (i);
+                ++waitingOn[i];
             }
         }
     }
-done:
 
-    /*
-     * Now we insert it and work out if anything requires shuffling
-     */
-    if (insertionPoint == m_schemas.end()) {
-        insertNewList (std::move(ptr));
-    } else {
-        const auto & insertedPtr = insertionPoint->emplace_front (std::move(ptr));
-
-        for (auto j = std::next (insertionPoint->begin()) ; j != insertionPoint->end() ; ) {
-            auto toErase = j++;
-
-            auto score { insertedPtr->dependsOn (**toErase) };
-
-            if (score > 0) {
-                uPtr<T> tmpPtr{std::move(*toErase)};
-                insertionPoint->erase (toErase);
-                switch (score) {
-                    // Needs to go after the element we're adding
-                    case 1: {
-                        insert(std::move(tmpPtr), std::next(insertionPoint));
-                        break;
-                    }
-                    // Needs to go before the element we're adding
-                    case 2: {
-                        insertNewList (std::move(tmpPtr), insertionPoint);
-                        break;
-                    }
+    std::vector<size_t> level;
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        if (!waitingOn[i]) {
+            level.push_back (i);
+        }
+    }
+
+    size_t ordered { 0 };
+
+    while (!level.empty()) {
+        std::vector<size_t> next;
+        std::list<uPtr<T>> members;
+
+        for (auto i : level) {
+            for (auto dependent : dependents[i]) {
+                if (!--waitingOn[dependent]) {
+                    next.push_back (dependent);
                 }
+            }
+
+            members.emplace_back (std::move (types[i]));
+        }
+
+        ordered += level.size();
+        m_schemas.emplace_back (std::move (members));
+
+        level = std::move (next);
+    }
 
+    if (ordered != types.size()) {
+        for (size_t i { 0 } ; i < types.size() ; ++i) {
+            if (types[i]) {
+                throw std::runtime_error (
+                        "Circular dependency involving " + types[i]->name());
             }
         }
     }
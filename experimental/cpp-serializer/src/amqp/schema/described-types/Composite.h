@@ -72,9 +72,7 @@ namespace amqp::internal::schema {
 
             Type type() const override;
 
-            int dependsOn (const OrderedTypeNotation &) const override;
-            int dependsOnRHS (const class Restricted &) const override;
-            int dependsOnRHS (const Composite &) const override;
+            std::vector<std::string_view> dependencies() const override;
 
             decltype(m_fields)::const_iterator begin() const { return m_fields.cbegin();}
             decltype(m_fields)::const_iterator end() const { return m_fields.cend(); }
@@ -29,8 +29,12 @@ operator << (
 amqp::internal::schema::
 Envelope::Envelope (
     uPtr<Schema> & schema_,
+    uPtr<TransformsSchema> transforms_,
     std::string descriptor_
 ) : m_schema (std::move (schema_))
+  , m_transforms (transforms_
+        ? std::move (transforms_)
+        : std::make_unique<TransformsSchema>())
   , m_descriptor (std::move (descriptor_))
 { }
 
@@ -44,6 +48,14 @@ Envelope::schema() const {
 
 /******************************************************************************/
 
+const amqp::internal::schema::TransformsSchema &
+amqp::internal::schema::
+Envelope::transforms() const {
+    return *m_transforms;
+}
+
+/******************************************************************************/
+
 const std::string &
 amqp::internal::schema::
 Envelope::descriptor() const {
@@ -5,6 +5,7 @@
 #include "amqp/AMQPDescribed.h"
 
 #include "amqp/schema/described-types/Schema.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
 
 #include <iosfwd>
 
@@ -18,6 +19,7 @@ namespace amqp::internal::schema {
 
         private :
             std::unique_ptr<Schema> m_schema;
+            std::unique_ptr<TransformsSchema> m_transforms;
             std::string m_descriptor;
 
         public :
@@ -25,10 +27,13 @@ namespace amqp::internal::schema {
 
             Envelope (
                 std::unique_ptr<Schema> & schema_,
+                std::unique_ptr<TransformsSchema> transforms_,
                 std::string descriptor_);
 
             const ISchemaType & schema() const;
 
+            const TransformsSchema & transforms() const;
+
             const std::string & descriptor() const;
     };
 
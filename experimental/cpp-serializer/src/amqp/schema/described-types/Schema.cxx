@@ -45,8 +45,14 @@ Schema::Schema (
     for (auto i { m_types.begin() } ; i != m_types.end() ; ++i) {
         for (auto & j : *i) {
             DBG ("Schema: " << j->descriptor() << " " << j->name() << std::endl); // NOLINT
-            m_descriptorToType.emplace (j->descriptor(), std::ref (j));
-            m_typeToDescriptor.emplace (j->name(), std::ref (j));
+            m_descriptorToType.emplace (intern (j->descriptor()), std::ref (j));
+            m_typeToDescriptor.emplace (intern (j->name()), std::ref (j));
+
+            // and anything they're built from so the factory never has
+            // to add to the table once it starts building readers
+            for (const auto & dependency : j->dependencies()) {
+                intern (dependency);
+            }
         }
     }
 }
@@ -64,7 +70,7 @@ Schema::types() const {
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
 Schema::fromType (const std::string & type_) const {
-    return m_typeToDescriptor.find(type_);
+    return fromType (Symbols::instance().find (type_));
 }
 
 /******************************************************************************/
@@ -72,6 +78,22 @@ Schema::fromType (const std::string & type_) const {
 amqp::internal::schema::SchemaMap::const_iterator
 amqp::internal::schema::
 Schema::fromDescriptor (const std::string & descriptor_) const {
+    return fromDescriptor (Symbols::instance().find (descriptor_));
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+Schema::fromType (Symbol type_) const {
+    return m_typeToDescriptor.find (type_);
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::SchemaMap::const_iterator
+amqp::internal::schema::
+Schema::fromDescriptor (Symbol descriptor_) const {
     return m_descriptorToType.find (descriptor_);
 }
 
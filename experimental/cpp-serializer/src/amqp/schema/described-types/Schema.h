@@ -3,7 +3,6 @@
 /******************************************************************************/
 
 #include <set>
-#include <map>
 #include <iosfwd>
 
 #include "types.h"
@@ -11,6 +10,7 @@
 #include "Descriptor.h"
 #include "schema/OrderedTypeNotations.h"
 
+#include "amqp/SymbolMap.h"
 #include "amqp/AMQPDescribed.h"
 #include "amqp/schema/ISchema.h"
 
@@ -18,9 +18,12 @@
 
 namespace amqp::internal::schema {
 
-    using SchemaMap = std::map<
-            std::string,
-            const std::reference_wrapper<const uPtr <AMQPTypeNotation>>>;
+    /**
+     * Keyed on the interned type name or descriptor, both of which are
+     * interned as the schema is built
+     */
+    using SchemaMap = SymbolMap<
+            std::reference_wrapper<const uPtr <AMQPTypeNotation>>>;
 
     using ISchemaType = amqp::schema::ISchema<SchemaMap::const_iterator>;
 
@@ -51,6 +54,9 @@ namespace amqp::internal::schema {
             SchemaMap::const_iterator fromType (const std::string &) const override;
             SchemaMap::const_iterator fromDescriptor (const std::string &) const override ;
 
+            SchemaMap::const_iterator fromType (Symbol) const;
+            SchemaMap::const_iterator fromDescriptor (Symbol) const;
+
             decltype (m_types.begin()) begin() const { return m_types.begin(); }
             decltype (m_types.end()) end() const { return m_types.end(); }
     };
@@ -0,0 +1,91 @@
+#include "TransformsSchema.h"
+
+#include <iostream>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+std::ostream &
+operator << (
+        std::ostream & stream_,
+        const amqp::internal::schema::Transform & transform_
+) {
+    switch (transform_.m_type) {
+        case Transform::enumDefault_t :
+            stream_ << "EnumDefault: " << transform_.m_from
+                << " -> " << transform_.m_to;
+            break;
+        case Transform::rename_t :
+            stream_ << "Rename: " << transform_.m_from
+                << " -> " << transform_.m_to;
+            break;
+        default :
+            stream_ << "Unknown";
+            break;
+    }
+
+    return stream_;
+}
+
+/******************************************************************************/
+
+std::ostream &
+operator << (
+        std::ostream & stream_,
+        const amqp::internal::schema::TransformsSchema & transforms_
+) {
+    for (const auto & type : transforms_.m_transforms) {
+        stream_ << type.first << std::endl;
+
+        for (const auto & transform : type.second) {
+            stream_ << "  " << *transform << std::endl;
+        }
+    }
+
+    return stream_;
+}
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Transform
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Transform::Transform (
+    Type type_,
+    std::string from_,
+    std::string to_
+) : m_type (type_)
+  , m_from (std::move (from_))
+  , m_to (std::move (to_))
+{ }
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::TransformsSchema
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+TransformsSchema::TransformsSchema (
+    std::map<std::string, Transforms> transforms_
+) : m_transforms (std::move (transforms_))
+{ }
+
+/******************************************************************************/
+
+const amqp::internal::schema::TransformsSchema::Transforms &
+amqp::internal::schema::
+TransformsSchema::transforms (const std::string & type_) const {
+    static const Transforms none;
+
+    auto it = m_transforms.find (type_);
+
+    return it == m_transforms.end() ? none : it->second;
+}
+
+/******************************************************************************/
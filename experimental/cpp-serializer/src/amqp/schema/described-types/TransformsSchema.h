@@ -0,0 +1,85 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A change made to an enum that Corda records alongside the schema so a
+     * reader built against one version of it can still make sense of the
+     * constants written by another.
+     *
+     *  - Rename, [from] was renamed [to]
+     *  - EnumDefault, a reader that doesn't know [from], a constant added
+     *    since it was built, should read it as [to]
+     *
+     * Anything else is kept, as unknown_t, but ignored.
+     */
+    class Transform : public AMQPDescribed {
+        public :
+            friend std::ostream & operator << (std::ostream &, const Transform &);
+
+            enum Type { unknown_t, enumDefault_t, rename_t };
+
+        private :
+            Type m_type;
+            std::string m_from;
+            std::string m_to;
+
+        public :
+            Transform (Type, std::string, std::string);
+
+            Type type() const { return m_type; }
+            const std::string & from() const { return m_from; }
+            const std::string & to() const { return m_to; }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The third and final part of an Envelope, every Transform that applies
+     * to each type named in the Schema that has any, in the order they were
+     * made
+     */
+    class TransformsSchema : public AMQPDescribed {
+        public :
+            friend std::ostream & operator << (std::ostream &, const TransformsSchema &);
+
+            using Transforms = std::vector<uPtr<Transform>>;
+
+        private :
+            std::map<std::string, Transforms> m_transforms;
+
+        public :
+            TransformsSchema() = default;
+
+            explicit TransformsSchema (std::map<std::string, Transforms>);
+
+            /**
+             * @return the transforms for [type_], empty if there aren't any
+             */
+            const Transforms & transforms (const std::string & type_) const;
+
+            bool empty() const { return m_transforms.empty(); }
+
+            decltype (m_transforms.cbegin()) begin() const { return m_transforms.cbegin(); }
+            decltype (m_transforms.cend()) end() const { return m_transforms.cend(); }
+    };
+
+}
+
+/******************************************************************************/
@@ -20,7 +20,7 @@ namespace amqp::internal::schema::descriptors {
 
 /******************************************************************************/
 
-const std::string &
+std::string_view
 amqp::internal::schema::descriptors::
 AMQPDescriptor::symbol() const {
     return m_symbol;
@@ -76,7 +76,7 @@ AMQPDescriptor::read (
                             << pn_data_get_list(data_)
                             << std::endl;
 
-                        AMQPDescriptorRegistory[key]->read (data_, ss_, ai);
+                        AMQPDescriptorRegistory (key).read (data_, ss_, ai);
                         break;
                     }
                     case PN_SYMBOL : {
@@ -2,10 +2,10 @@
 
 /******************************************************************************/
 
-#include <map>
 #include <memory>
 #include <string>
 #include <iostream>
+#include <string_view>
 
 #include "amqp/AMQPDescribed.h"
 
@@ -48,25 +48,32 @@ namespace amqp::internal::schema::descriptors {
 
 namespace amqp::internal::schema::descriptors {
 
+    /**
+     * Constructors are all constexpr and destructors trivial so the
+     * registry's descriptors are built at compile time and can be used
+     * from anywhere, including other static initialisers, without worrying
+     * about order. Nothing ever owns one through a pointer to this base
+     * so it doesn't need a virtual destructor.
+     */
     class AMQPDescriptor {
         protected :
-            std::string m_symbol;
+            std::string_view m_symbol;
             int32_t m_val;
 
         public :
-            AMQPDescriptor()
+            constexpr AMQPDescriptor()
                 : m_symbol ("ERROR")
                 , m_val (-1)
             { }
 
-            AMQPDescriptor (std::string symbol_, int val_)
-                : m_symbol (std::move (symbol_))
+            constexpr AMQPDescriptor (std::string_view symbol_, int val_)
+                : m_symbol (symbol_)
                 , m_val (val_)
             { }
 
-            virtual ~AMQPDescriptor() = default;
+            ~AMQPDescriptor() = default;
 
-            const std::string & symbol() const;
+            std::string_view symbol() const;
 
             void validateAndNext (pn_data_t *) const;
 
@@ -11,89 +11,90 @@
 #include "corda-descriptors/CompositeDescriptor.h"
 #include "corda-descriptors/RestrictedDescriptor.h"
 
+#include <array>
 #include <limits>
 #include <climits>
+#include <sstream>
+#include <stdexcept>
+
+#include <proton/codec.h>
 
 /******************************************************************************/
 
-/**
- *
- */
-namespace amqp::internal {
-
-    std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>>
-    AMQPDescriptorRegistory = {
-        {
-            22UL,
-            std::make_shared<internal::schema::descriptors::AMQPDescriptor> ("DESCRIBED", -1)
-        },
-        {
-            1UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::EnvelopeDescriptor> (
-                    "ENVELOPE",
-                    ::amqp::schema::descriptors::ENVELOPE)
-        },
-        {
-            2UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::SchemaDescriptor> (
-                    "SCHEMA",
-                    ::amqp::schema::descriptors::SCHEMA)
-        },
-        {
-            3UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ObjectDescriptor> (
-                    "OBJECT_DESCRIPTOR",
-                    ::amqp::schema::descriptors::OBJECT)
-        },
-        {
-            4UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::FieldDescriptor> (
-                    "FIELD",
-                    ::amqp::schema::descriptors::FIELD)
-        },
-        {
-            5UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::CompositeDescriptor> (
-                    "COMPOSITE_TYPE",
-                    ::amqp::schema::descriptors::COMPOSITE_TYPE)
-        },
-        {
-            6UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::RestrictedDescriptor> (
-                    "RESTRICTED_TYPE",
-                    ::amqp::schema::descriptors::RESTRICTED_TYPE)
-        },
-        {
-            7UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ChoiceDescriptor> (
-                    "CHOICE",
-                    ::amqp::schema::descriptors::CHOICE)
-        },
-        {
-            8UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::ReferencedObjectDescriptor> (
-                    "REFERENCED_OBJECT",
-                    ::amqp::schema::descriptors::REFERENCED_OBJECT)
-        },
-        {
-            9UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformSchemaDescriptor> (
-                    "TRANSFORM_SCHEMA",
-                    ::amqp::schema::descriptors::TRANSFORM_SCHEMA)
-        },
-        {
-            10UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformElementDescriptor> (
-                    "TRANSFORM_ELEMENT",
-                    ::amqp::schema::descriptors::TRANSFORM_ELEMENT)
-        },
-        {
-            11UL | ::amqp::schema::descriptors::DESCRIPTOR_TOP_32BITS,
-            std::make_shared<internal::schema::descriptors::TransformElementKeyDescriptor> (
-                    "TRANSFORM_ELEMENT_KEY",
-                    ::amqp::schema::descriptors::TRANSFORM_ELEMENT_KEY)
-        }
+namespace {
+
+    using namespace amqp::internal::schema::descriptors;
+
+    namespace r3 = ::amqp::schema::descriptors;
+
+    constexpr AMQPDescriptor described { "DESCRIBED", -1 };
+
+    constexpr EnvelopeDescriptor envelope { "ENVELOPE", r3::ENVELOPE };
+    constexpr SchemaDescriptor schema { "SCHEMA", r3::SCHEMA };
+    constexpr ObjectDescriptor object { "OBJECT_DESCRIPTOR", r3::OBJECT };
+    constexpr FieldDescriptor field { "FIELD", r3::FIELD };
+    constexpr CompositeDescriptor composite { "COMPOSITE_TYPE", r3::COMPOSITE_TYPE };
+    constexpr RestrictedDescriptor restricted { "RESTRICTED_TYPE", r3::RESTRICTED_TYPE };
+    constexpr ChoiceDescriptor choice { "CHOICE", r3::CHOICE };
+
+    constexpr ReferencedObjectDescriptor referencedObject {
+        "REFERENCED_OBJECT", r3::REFERENCED_OBJECT };
+
+    constexpr TransformSchemaDescriptor transformSchema {
+        "TRANSFORM_SCHEMA", r3::TRANSFORM_SCHEMA };
+
+    constexpr TransformElementDescriptor transformElement {
+        "TRANSFORM_ELEMENT", r3::TRANSFORM_ELEMENT };
+
+    constexpr TransformElementKeyDescriptor transformElementKey {
+        "TRANSFORM_ELEMENT_KEY", r3::TRANSFORM_ELEMENT_KEY };
+
+    /**
+     * Indexed by the R3 descriptor with the enterprise number stripped off,
+     * there is no descriptor zero
+     */
+    constexpr std::array<const AMQPDescriptor *, r3::TRANSFORM_ELEMENT_KEY + 1>
+    registry {
+        nullptr,
+        &envelope,
+        &schema,
+        &object,
+        &field,
+        &composite,
+        &restricted,
+        &choice,
+        &referencedObject,
+        &transformSchema,
+        &transformElement,
+        &transformElementKey
     };
+
+    static_assert (registry[r3::ENVELOPE] == &envelope);
+    static_assert (registry[r3::RESTRICTED_TYPE] == &restricted);
+    static_assert (registry[r3::TRANSFORM_ELEMENT_KEY] == &transformElementKey);
+
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::descriptors::AMQPDescriptor &
+amqp::internal::AMQPDescriptorRegistory (uint64_t id_) {
+    constexpr uint64_t top32 = ~static_cast<uint64_t>(UINT_MAX);
+
+    if ((id_ & top32) == r3::DESCRIPTOR_TOP_32BITS) {
+        auto idx = stripCorda (id_);
+
+        if (idx < registry.size() && registry[idx]) {
+            return *registry[idx];
+        }
+    } else if (id_ == PN_DESCRIBED) {
+        return described;
+    }
+
+    std::stringstream ss;
+    ss << "Unknown descriptor 0x" << std::hex << id_;
+
+    throw std::runtime_error (ss.str());
 }
 
 /******************************************************************************/
@@ -2,8 +2,8 @@
 
 /******************************************************************************/
 
-#include <map>
-#include <memory>
+#include <string>
+#include <cstdint>
 
 /******************************************************************************/
 
@@ -19,7 +19,16 @@
  */
 namespace amqp::internal {
 
-    extern std::map<uint64_t, std::shared_ptr<internal::schema::descriptors::AMQPDescriptor>> AMQPDescriptorRegistory;
+    /**
+     * Look up how to handle a described type by its descriptor.
+     *
+     * Either one of the R3 descriptors or, for historical reasons, the
+     * proton PN_DESCRIBED type id, which gives back the generic handler
+     * for any described node. Anything else is an error.
+     *
+     * @throws std::runtime_error for a descriptor we don't know about
+     */
+    const schema::descriptors::AMQPDescriptor & AMQPDescriptorRegistory (uint64_t);
 
 }
 
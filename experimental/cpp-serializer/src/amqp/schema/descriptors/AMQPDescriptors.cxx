@@ -13,6 +13,7 @@
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
 #include "amqp/schema/described-types/Composite.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/AMQPDescribed.h"
@@ -56,6 +57,11 @@ ReferencedObjectDescriptor::build (pn_data_t * data_) const {
 
 /******************************************************************************/
 
+/**
+ * The transforms are a map of type name to a map of the kind of transform,
+ * a described ordinal, to a list of the transforms of that kind. As each
+ * transform names its own kind we don't need to look at the middle key.
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 TransformSchemaDescriptor::build (pn_data_t * data_) const {
@@ -63,11 +69,38 @@ TransformSchemaDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM SCHEMA " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    std::map<std::string, schema::TransformsSchema::Transforms> transforms;
+
+    proton::auto_map_enter ame (data_);
+
+    while (pn_data_next (data_)) {
+        auto & forType = transforms[proton::get_string (data_)];
+
+        pn_data_next (data_);
+        proton::auto_map_enter ame2 (data_);
+
+        while (pn_data_next (data_)) {
+            // the kind
+            pn_data_next (data_);
+
+            proton::auto_list_enter ale (data_);
+
+            while (pn_data_next (data_)) {
+                forType.emplace_back (
+                    dispatchDescribed<schema::Transform> (data_));
+            }
+        }
+    }
+
+    return std::make_unique<schema::TransformsSchema> (std::move (transforms));
 }
 
 /******************************************************************************/
 
+/**
+ * A list of the transform's name followed by its arguments. EnumDefault
+ * is written [ name, old, new ] and Rename [ name, from, to ]
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 TransformElementDescriptor::build (pn_data_t * data_) const {
@@ -75,7 +108,26 @@ TransformElementDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM ELEMENT " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    proton::auto_list_enter ale (data_, true);
+
+    auto name = proton::readAndNext<std::string> (data_);
+
+    if (name == "EnumDefault") {
+        auto old = proton::readAndNext<std::string> (data_);
+        auto added = proton::get_string (data_);
+
+        return std::make_unique<schema::Transform> (
+            schema::Transform::enumDefault_t, added, old);
+    } else if (name == "Rename") {
+        auto from = proton::readAndNext<std::string> (data_);
+        auto to = proton::get_string (data_);
+
+        return std::make_unique<schema::Transform> (
+            schema::Transform::rename_t, from, to);
+    }
+
+    return std::make_unique<schema::Transform> (
+        schema::Transform::unknown_t, "", "");
 }
 
 /******************************************************************************/
@@ -40,7 +40,7 @@ namespace amqp::internal::schema::descriptors {
 
         return uPtr<T>(
             static_cast<T *>(
-                AMQPDescriptorRegistory[id]->build(data_).release()));
+                AMQPDescriptorRegistory (id).build(data_).release()));
     }
 }
 
@@ -50,13 +50,13 @@ namespace amqp::internal::schema::descriptors {
 
     class ReferencedObjectDescriptor : public AMQPDescriptor {
         public :
-            ReferencedObjectDescriptor() : AMQPDescriptor() { }
+            constexpr ReferencedObjectDescriptor() : AMQPDescriptor() { }
 
-            ReferencedObjectDescriptor(const std::string & symbol_, int val_)
+            constexpr ReferencedObjectDescriptor(std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~ReferencedObjectDescriptor() final = default;
+            ~ReferencedObjectDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
@@ -69,13 +69,13 @@ namespace amqp::internal::schema::descriptors {
 
     class TransformSchemaDescriptor : public AMQPDescriptor {
         public :
-            TransformSchemaDescriptor() : AMQPDescriptor() { }
+            constexpr TransformSchemaDescriptor() : AMQPDescriptor() { }
 
-            TransformSchemaDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformSchemaDescriptor(std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformSchemaDescriptor() final = default;
+            ~TransformSchemaDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
@@ -88,13 +88,13 @@ namespace amqp::internal::schema::descriptors {
 
     class TransformElementDescriptor : public AMQPDescriptor {
         public :
-            TransformElementDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementDescriptor() : AMQPDescriptor() { }
 
-            TransformElementDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformElementDescriptor(std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformElementDescriptor() final = default;
+            ~TransformElementDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
@@ -107,13 +107,13 @@ namespace amqp::internal::schema::descriptors {
 
     class TransformElementKeyDescriptor : public AMQPDescriptor {
         public :
-            TransformElementKeyDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementKeyDescriptor() : AMQPDescriptor() { }
 
-            TransformElementKeyDescriptor(const std::string & symbol_, int val_)
+            constexpr TransformElementKeyDescriptor(std::string_view symbol_, int val_)
                 : AMQPDescriptor(symbol_, val_)
             { }
 
-            ~TransformElementKeyDescriptor() final = default;
+            ~TransformElementKeyDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
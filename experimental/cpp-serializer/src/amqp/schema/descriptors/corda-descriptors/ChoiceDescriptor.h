@@ -14,9 +14,11 @@ namespace amqp::internal::schema::descriptors {
         public :
             ChoiceDescriptor() = delete;
 
-            ChoiceDescriptor (std::string, int);
+            constexpr ChoiceDescriptor (std::string_view symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
-            ~ChoiceDescriptor() final = default;
+            ~ChoiceDescriptor() = default;
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
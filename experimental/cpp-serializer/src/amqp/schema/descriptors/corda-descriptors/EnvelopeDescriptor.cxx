@@ -2,6 +2,7 @@
 
 #include "amqp/schema/described-types/Schema.h"
 #include "amqp/schema/described-types/Envelope.h"
+#include "amqp/schema/described-types/TransformsSchema.h"
 #include "proton/proton_wrapper.h"
 
 #include "types.h"
@@ -49,12 +50,12 @@ EnvelopeDescriptor::read (
         proton::auto_enter p (data_);
 
         ss_ << ai << "1]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        AMQPDescriptorRegistory (pn_data_type(data_)).read (
                 (pn_data_t *)proton::auto_next (data_), ss_, AutoIndent { ai });
 
 
         ss_ << ai << "2]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        AMQPDescriptorRegistory (pn_data_type(data_)).read (
                 (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
     }
@@ -62,16 +63,6 @@ EnvelopeDescriptor::read (
 
 /******************************************************************************/
 
-amqp::internal::schema::descriptors::
-EnvelopeDescriptor::EnvelopeDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 EnvelopeDescriptor::build (pn_data_t * data_) const {
@@ -96,15 +87,18 @@ EnvelopeDescriptor::build (pn_data_t * data_) const {
      */
     auto schema = descriptors::dispatchDescribed<schema::Schema> (data_);
 
-    pn_data_next(data_);
-
     /*
-     * The transforms schema
+     * The transforms schema, older blobs may not have one
      */
-    // Skip for now
-    // dispatchDescribed (data_);
+    uPtr<schema::TransformsSchema> transforms;
+
+    if (pn_data_next (data_)) {
+        transforms = descriptors::dispatchDescribed<schema::TransformsSchema> (
+                data_);
+    }
 
-    return std::make_unique<schema::Envelope> (schema::Envelope (schema, outerType));
+    return std::make_unique<schema::Envelope> (
+            schema::Envelope (schema, std::move (transforms), outerType));
 }
 
 /******************************************************************************/
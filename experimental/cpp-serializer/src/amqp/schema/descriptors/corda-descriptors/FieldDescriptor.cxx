@@ -15,16 +15,6 @@
  *
  ******************************************************************************/
 
-amqp::internal::schema::descriptors::
-FieldDescriptor::FieldDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 FieldDescriptor::build (pn_data_t * data_) const {
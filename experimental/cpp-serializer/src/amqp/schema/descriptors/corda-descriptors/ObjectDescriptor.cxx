@@ -14,15 +14,6 @@
  *
  ******************************************************************************/
 
-amqp::internal::schema::descriptors::
-ObjectDescriptor::ObjectDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-}
-
-/******************************************************************************/
-
 /**
  *
  */
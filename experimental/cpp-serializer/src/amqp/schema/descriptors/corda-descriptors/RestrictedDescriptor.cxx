@@ -22,7 +22,7 @@ namespace {
             },
             {
                 "java.lang.Boolean",
-                std::pair { std::regex { "java.lang.Boolean"}, "bool"}
+                std::pair { std::regex { "java.lang.Boolean"}, "boolean"}
             },
             {
                 "java.lang.Byte",
@@ -68,18 +68,6 @@ namespace amqp::internal::schema::descriptors {
 
 }
 
-/******************************************************************************/
-
-amqp::internal::schema::descriptors::
-RestrictedDescriptor::RestrictedDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_)
-  , val_
-) {
-    
-}
-
 /******************************************************************************
  *
  * Restricted types represent lists and maps
@@ -190,7 +178,7 @@ RestrictedDescriptor::read (
 
     ss_ << ai << "5] Descriptor:" << std::endl;
 
-    AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+    AMQPDescriptorRegistory (pn_data_type(data_)).read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 }
 
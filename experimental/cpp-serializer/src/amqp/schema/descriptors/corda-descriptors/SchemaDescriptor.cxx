@@ -16,15 +16,6 @@
 
 /******************************************************************************/
 
-amqp::internal::schema::descriptors::
-SchemaDescriptor::SchemaDescriptor (
-    std::string symbol_,
-    int val_
-) : AMQPDescriptor (std::move (symbol_), val_) {
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::schema::descriptors::
 SchemaDescriptor::build (pn_data_t * data_) const {
@@ -47,12 +38,12 @@ SchemaDescriptor::build (pn_data_t * data_) const {
                 schemas.insert (
                     descriptors::dispatchDescribed<schema::AMQPTypeNotation> (
                         data_));
-
-                DBG("=======" << std::endl << schemas << "======" << std::endl);
             }
         }
     }
 
+    DBG("=======" << std::endl << schemas << "======" << std::endl);
+
     return std::make_unique<schema::Schema> (std::move (schemas));
 }
 
@@ -85,7 +76,7 @@ SchemaDescriptor::read (
                 ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
                         << "] " << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                AMQPDescriptorRegistory (pn_data_type(data_)).read (
                         data_, ss_,
                         AutoIndent { ai2 });
             }
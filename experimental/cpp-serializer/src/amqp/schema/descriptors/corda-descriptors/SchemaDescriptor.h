@@ -13,8 +13,10 @@ namespace amqp::internal::schema::descriptors {
     class SchemaDescriptor : public AMQPDescriptor {
     public :
         SchemaDescriptor() = delete;
-        SchemaDescriptor (std::string, int);
-        ~SchemaDescriptor() final = default;
+        constexpr SchemaDescriptor (std::string_view symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
+        ~SchemaDescriptor() = default;
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
@@ -5,6 +5,8 @@
 
 #include "debug.h"
 
+#include "amqp/SymbolMap.h"
+
 #include "ArrayField.h"
 #include "PrimitiveField.h"
 #include "CompositeField.h"
@@ -115,14 +117,28 @@ Field::Field (
 
 /******************************************************************************/
 
+/**
+ * Every AMQP primitive, interned up front so asking is a hash of the name
+ * and a lookup rather than a string compare against each in turn
+ */
 bool
 amqp::internal::schema::
 Field::typeIsPrimitive (const std::string & type_) {
-    return (type_ == "string" ||
-            type_ == "long" ||
-            type_ == "boolean" ||
-            type_ == "int" ||
-            type_ == "double");
+    static const auto primitives = [] {
+        SymbolMap<bool> rtn;
+
+        for (const auto * type : {
+            "string", "long", "boolean", "int", "double", "float", "char",
+            "byte", "short", "ubyte", "ushort", "uint", "ulong", "decimal32",
+            "decimal64", "decimal128", "timestamp", "uuid", "binary", "symbol" })
+        {
+            rtn.emplace (intern (type), true);
+        }
+
+        return rtn;
+    }();
+
+    return primitives.find (Symbols::instance().find (type_)) != primitives.end();
 }
 
 /******************************************************************************/
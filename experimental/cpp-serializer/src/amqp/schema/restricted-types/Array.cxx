@@ -88,82 +88,4 @@ Array::arrayOf() const {
     return m_arrayOf[0];
 }
 
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Array::dependsOnMap (const amqp::internal::schema::Map & map_) const {
-    // do we depend on the lhs
-    if (arrayOf() == map_.name()) {
-        return 1;
-    }
-
-    // does lhs_ depend on us
-    auto lhsMapOf { map_.mapOf() };
-
-    if (lhsMapOf.first.get() == name() || lhsMapOf.second.get() == name()) {
-        return 2;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Array::dependsOnList (const amqp::internal::schema::List & list_) const {
-    // do we depend on the lhs
-    if (arrayOf() == list_.name()) {
-        return 1;
-    }
-
-    // does the left hand side depend on us
-    if (list_.listOf() == name()) {
-        return 2;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Array::dependsOnArray (const amqp::internal::schema::Array & array_) const {
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Array::dependsOnEnum (const amqp::internal::schema::Enum & enum_) const {
-    // an enum cannot depend on us so don't bother checking, lets just check
-    // if we depend on it
-    if (arrayOf() == enum_.name()) {
-        return 1;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Array::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
-    if (arrayOf() == lhs_.name()) {
-        return 1;
-    }
-
-    for (const auto & field : lhs_.fields()) {
-        if (field->resolvedType() == name()) {
-            return 2;
-        }
-    }
-
-    return 0;
-}
-
 /*********************************************************o*********************/
@@ -46,71 +46,6 @@ Enum::end() const {
     return m_enum.end();
 }
 
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Enum::dependsOnMap (const amqp::internal::schema::Map & map_) const {
-    // does lhs_ depend on us
-    auto lhsMapOf { map_.mapOf() };
-    if (lhsMapOf.first.get() == name() || lhsMapOf.second.get() == name()) {
-        return 1;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Enum::dependsOnList (const amqp::internal::schema::List & list_) const {
-    // does the left hand side depend on us
-    if (list_.listOf() == name()) {
-        return 2;
-    }
-
-    // we can never depend on the left hand side so don't bother checking
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Enum::dependsOnArray (const amqp::internal::schema::Array & array_) const {
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-Enum::dependsOnEnum (const amqp::internal::schema::Enum &) const {
-    // enums should never depend on one another so just return 0;
-    return 0;
-}
-
-/*********************************************************o*********************/
-
-int
-amqp::internal::schema::
-Enum::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
-    if (name() == lhs_.name()) {
-        return 1;
-    }
-
-    for (const auto & field : lhs_.fields()) {
-        if (field->resolvedType() == name()) {
-            return 2;
-        }
-    }
-
-
-    return 0;
-}
-
 /*********************************************************o*********************/
 
 std::vector<std::string>
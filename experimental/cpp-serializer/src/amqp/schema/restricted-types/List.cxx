@@ -73,82 +73,4 @@ List::listOf() const {
     return m_listOf[0];
 }
 
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOnMap (const amqp::internal::schema::Map & map_) const {
-    // do we depend on the lhs
-    if (listOf() == map_.name()) {
-        return 1;
-    }
-
-    // does lhs_ depend on us
-    auto lhsMapOf { map_.mapOf() };
-
-    if (lhsMapOf.first.get() == name() || lhsMapOf.second.get() == name()) {
-        return 2;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOnList (const amqp::internal::schema::List & list_) const {
-    // do we depend on the lhs
-    if (listOf() == list_.name()) {
-        return 1;
-    }
-
-    // does the left hand side depend on us
-    if (list_.listOf() == name()) {
-        return 2;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOnArray (const amqp::internal::schema::Array & array_) const {
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOnEnum (const amqp::internal::schema::Enum & enum_) const {
-    // an enum cannot depend on us so don't bother checking, lets just check
-    // if we depend on it
-    if (listOf() == enum_.name()) {
-        return 1;
-    }
-
-    return 0;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOnRHS (const amqp::internal::schema::Composite & lhs_) const {
-    if (listOf() == lhs_.name()) {
-        return 1;
-    }
-
-    for (const auto & field : lhs_.fields()) {
-        if (field->resolvedType() == name()) {
-            return 2;
-        }
-    }
-
-    return 0;
-}
-
 /*********************************************************o*********************/
@@ -15,11 +15,6 @@ namespace amqp::internal::schema {
             std::vector<std::string> m_mapOf;
             std::string m_source;
 
-            int dependsOnMap (const Map &) const override;
-            int dependsOnList (const List &) const override;
-            int dependsOnEnum (const Enum &) const override;
-            int dependsOnArray (const Array &) const override;
-
         public :
             Map (
                 uPtr<Descriptor> descriptor_,
@@ -34,8 +29,6 @@ namespace amqp::internal::schema {
             std::pair<
                 std::reference_wrapper<const std::string>,
                 std::reference_wrapper<const std::string>> mapOf() const;
-
-            int dependsOnRHS (const Composite &) const override;
     };
 
 }
@@ -82,7 +82,7 @@ namespace {
 
     std::map<std::string, std::string> boxedToUnboxed = {
             { "java.lang.Integer", "int" },
-            { "java.lang.Boolean", "bool" },
+            { "java.lang.Boolean", "boolean" },
             { "java.lang.Byte", "char" },
             { "java.lang.Short", "short" },
             { "java.lang.Character", "char" },
@@ -225,37 +225,13 @@ Restricted::restrictedType() const {
 
 /******************************************************************************/
 
-int
-amqp::internal::schema::
-Restricted::dependsOn (const OrderedTypeNotation & rhs_) const {
-    return dynamic_cast<const AMQPTypeNotation &>(rhs_).dependsOnRHS (*this);
-}
-
-/*********************************************************o*********************/
-
-/*
- * If the left hand side of the original call, restricted_ in this case,
- * depends on this instance then we return 1.
- *
- * If this instance of a map depends on the parameter we return 2
+/**
+ * The types we represent, for an enum that's just itself
  */
-int
+std::vector<std::string_view>
 amqp::internal::schema::
-Restricted::dependsOnRHS (const Restricted & lhs_) const  {
-    switch (lhs_.restrictedType()) {
-        case Restricted::RestrictedTypes::map_t :
-            return dependsOnMap (
-                static_cast<const amqp::internal::schema::Map &>(lhs_)); // NOLINT
-        case Restricted::RestrictedTypes::list_t :
-            return dependsOnList (
-                static_cast<const amqp::internal::schema::List &>(lhs_)); // NOLINT
-        case Restricted::RestrictedTypes::enum_t :
-            return dependsOnEnum (
-                static_cast<const amqp::internal::schema::Enum &>(lhs_)); // NOLINT
-        case Restricted::RestrictedTypes::array_t :
-            return dependsOnArray (
-                    static_cast<const amqp::internal::schema::Array &>(lhs_)); // NOLINT
-    }
+Restricted::dependencies() const {
+    return { begin(), end() };
 }
 
 /*********************************************************o*********************/
@@ -76,11 +76,6 @@ namespace amqp::internal::schema {
                 std::vector<std::string>,
                 RestrictedTypes);
 
-            virtual int dependsOnMap (const Map &) const = 0;
-            virtual int dependsOnList (const List &) const = 0;
-            virtual int dependsOnArray (const Array &) const = 0;
-            virtual int dependsOnEnum (const Enum &) const = 0;
-
         public :
             static std::unique_ptr<Restricted> make(
                     std::unique_ptr<Descriptor>,
@@ -104,10 +99,7 @@ namespace amqp::internal::schema {
             virtual std::vector<std::string>::const_iterator begin() const = 0;
             virtual std::vector<std::string>::const_iterator end() const = 0;
 
-            int dependsOn (const OrderedTypeNotation &) const override;
-            int dependsOnRHS (const Restricted &) const override;
-
-            int dependsOnRHS (const Composite &) const override = 0;
+            std::vector<std::string_view> dependencies() const override;
 
             const decltype (m_provides) & provides() const { return m_provides; }
             const decltype (m_label) & label() const { return m_label; }
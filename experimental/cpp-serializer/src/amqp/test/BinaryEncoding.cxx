@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "amqp/BinaryEncoding.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    hex (const uint8_t * from_, size_t n_) {
+        static const char digits[] = "0123456789abcdef";
+
+        std::string rtn;
+
+        for (size_t i { 0 } ; i < n_ ; ++i) {
+            rtn += digits[from_[i] >> 4];
+            rtn += digits[from_[i] & 0xF];
+        }
+
+        return rtn;
+    }
+
+    std::string
+    base64 (const uint8_t * from_, size_t n_) {
+        static const char alphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string rtn;
+        uint32_t bits { 0 };
+        int held { 0 };
+
+        for (size_t i { 0 } ; i < n_ ; ++i) {
+            bits = (bits << 8) | from_[i];
+            held += 8;
+
+            while (held >= 6) {
+                held -= 6;
+                rtn += alphabet[(bits >> held) & 0x3F];
+            }
+        }
+
+        if (held) {
+            rtn += alphabet[(bits << (6 - held)) & 0x3F];
+        }
+
+        while (rtn.size() % 4) {
+            rtn += '=';
+        }
+
+        return rtn;
+    }
+
+    /**
+     * Compare [encode_] to the obvious one byte at a time encoding for every
+     * length up to and past a few vector widths, from every alignment, and
+     * check it doesn't write past the end of what it should
+     */
+    void
+    check (
+        size_t (*length_)(size_t),
+        void (*encode_)(const uint8_t *, size_t, char *),
+        std::string (*expected_)(const uint8_t *, size_t)
+    ) {
+        std::vector<uint8_t> in (256 + 16);
+
+        for (size_t i { 0 } ; i < in.size() ; ++i) {
+            in[i] = static_cast<uint8_t>(i * 37 + 11);
+        }
+
+        for (size_t offset { 0 } ; offset < 16 ; ++offset) {
+            for (size_t n { 0 } ; n <= 256 ; ++n) {
+                std::string actual (length_ (n) + 1, '#');
+
+                encode_ (in.data() + offset, n, actual.data());
+
+                ASSERT_EQ (expected_ (in.data() + offset, n) + "#", actual)
+                    << binaryEncodingImplementation()
+                    << " n " << n << " offset " << offset;
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (BinaryEncoding, hex) { // NOLINT
+    check ([](size_t n_) { return hexLength (n_); }, toHex, hex);
+}
+
+/******************************************************************************/
+
+TEST (BinaryEncoding, base64) { // NOLINT
+    check ([](size_t n_) { return base64Length (n_); }, toBase64, base64);
+
+    const std::string man ("Man");
+    std::string out (base64Length (2), '\0');
+
+    toBase64 (reinterpret_cast<const uint8_t *>(man.data()), 2, out.data());
+    ASSERT_EQ ("TWE=", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+#include <cstring>
+
+#include "amqp/decoder/ByteSwap.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::decoder;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Reverse each [width_] byte lane by hand and compare that to what we
+     * get from [swap_], for every length up to and past a couple of vector
+     * widths and from every alignment
+     */
+    void
+    check (
+        size_t width_,
+        void (*swap_)(const uint8_t *, void *, size_t)
+    ) {
+        std::vector<uint8_t> in (128 * width_ + 8);
+
+        for (size_t i { 0 } ; i < in.size() ; ++i) {
+            in[i] = static_cast<uint8_t>(i * 7 + 3);
+        }
+
+        for (size_t offset { 0 } ; offset < 8 ; ++offset) {
+            for (size_t n { 0 } ; n <= 100 ; ++n) {
+                std::vector<uint8_t> expected (n * width_);
+                std::vector<uint8_t> actual (n * width_ + 1);
+
+                for (size_t i { 0 } ; i < n ; ++i) {
+                    for (size_t b { 0 } ; b < width_ ; ++b) {
+                        expected[i * width_ + b] =
+                            in[offset + i * width_ + (width_ - 1 - b)];
+                    }
+                }
+
+                // write from an odd address as well
+                swap_ (in.data() + offset, actual.data() + 1, n);
+
+                // an empty expected has no data() to compare against
+                if (n == 0) continue;
+
+                ASSERT_EQ (0, std::memcmp (
+                        expected.data(), actual.data() + 1, n * width_))
+                    << byteSwapImplementation() << " width " << width_
+                    << " n " << n << " offset " << offset;
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (ByteSwap, sixteen) { // NOLINT
+    check (2, fromBigEndian16);
+}
+
+/******************************************************************************/
+
+TEST (ByteSwap, thirtyTwo) { // NOLINT
+    check (4, fromBigEndian32);
+}
+
+/******************************************************************************/
+
+TEST (ByteSwap, sixtyFour) { // NOLINT
+    check (8, fromBigEndian64);
+}
+
+/******************************************************************************/
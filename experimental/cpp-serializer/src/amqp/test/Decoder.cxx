@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::decoder;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * described (0x53 0x01) [ "ab", 7, [ 1L ] ] followed by a second
+     * top level value, true
+     */
+    const std::string described {
+        "\x00\x53\x01"
+        "\xc0\x0d\x04"
+            "\xa1\x02" "ab"
+            "\x54\x07"
+            "\xc0\x03\x01" "\x55\x01"
+            "\x44"
+        "\x41", 19
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (Decoder, navigation) { // NOLINT
+    Decoder d (described.data(), described.size());
+
+    ASSERT_EQ (described_t, d.type());
+    ASSERT_EQ (0, d.offset());
+
+    {
+        auto_enter ae (&d);
+
+        ASSERT_EQ (ulong_t, d.type());
+        ASSERT_EQ (1UL, d.get_ulong());
+
+        ASSERT_TRUE (d.next());
+        ASSERT_EQ (list_t, d.type());
+        ASSERT_EQ (4UL, d.get_list());
+
+        {
+            auto_list_enter ale (&d, true);
+            ASSERT_EQ (4UL, ale.elements());
+
+            ASSERT_EQ ("ab", readAndNext<std::string> (&d));
+            ASSERT_EQ (7, readAndNext<int32_t> (&d));
+
+            // step over the nested list without entering it
+            ASSERT_EQ (list_t, d.type());
+            ASSERT_TRUE (d.next());
+
+            ASSERT_EQ (ulong_t, d.type());
+            ASSERT_EQ (0UL, d.get_ulong());
+            ASSERT_FALSE (d.next());
+        }
+
+        ASSERT_EQ (list_t, d.type());
+        ASSERT_FALSE (d.next());
+    }
+
+    ASSERT_EQ (described_t, d.type());
+    ASSERT_EQ (described.size() - 1, d.encoded().size());
+
+    ASSERT_TRUE (d.next());
+    ASSERT_EQ (bool_t, d.type());
+    ASSERT_TRUE (d.get_bool());
+    ASSERT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+/**
+ * A described array shares its element constructor, the descriptor is
+ * the first child just as it is with proton
+ */
+TEST (Decoder, describedArray) { // NOLINT
+    const std::string array {
+        "\xe0\x0e\x02"
+            "\x00\xa3\x01" "x"
+            "\x71"
+                "\x00\x00\x00\x01"
+                "\xff\xff\xff\xfe", 16
+    };
+
+    Decoder d (array.data(), array.size());
+
+    ASSERT_EQ (array_t, d.type());
+    ASSERT_EQ (2UL, d.get_array());
+    ASSERT_TRUE (d.is_array_described());
+
+    auto_enter ae (&d);
+
+    ASSERT_EQ (symbol_t, d.type());
+    ASSERT_EQ ("x", d.get_symbol());
+
+    ASSERT_TRUE (d.next());
+    ASSERT_EQ (int_t, d.type());
+    ASSERT_EQ (1, d.get_int());
+
+    ASSERT_TRUE (d.next());
+    ASSERT_EQ (-2, d.get_int());
+
+    ASSERT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+TEST (Decoder, map) { // NOLINT
+    const std::string map {
+        "\xd1\x00\x00\x00\x0c\x00\x00\x00\x04"
+            "\x52\x01" "\xa1\x01" "a"
+            "\x52\x02" "\x40", 17
+    };
+
+    Decoder d (map.data(), map.size());
+
+    ASSERT_EQ (map_t, d.type());
+
+    auto_map_enter ame (&d, true);
+    ASSERT_EQ (4UL, ame.elements());
+
+    ASSERT_EQ (1U, d.get_uint());
+    d.next();
+    ASSERT_EQ ("a", get_string (&d));
+    d.next();
+    ASSERT_EQ (2U, d.get_uint());
+    d.next();
+    ASSERT_EQ ("", get_string (&d, true));
+    ASSERT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+TEST (Decoder, truncated) { // NOLINT
+    const std::string list { "\xc0\x10\x01\x71", 4 };
+
+    Decoder d (list.data(), list.size());
+
+    ASSERT_THROW (d.enter(), std::runtime_error); // NOLINT
+
+    // nothing but the format codes, the counts would be past the end
+    ASSERT_THROW (Decoder ("\xc0", 1).get_list(), std::runtime_error); // NOLINT
+    ASSERT_THROW (Decoder ("\xd0", 1).get_list(), std::runtime_error); // NOLINT
+    ASSERT_THROW (Decoder ("\xd1", 1).get_map(), std::runtime_error); // NOLINT
+    ASSERT_THROW (Decoder ("\xf0", 1).get_array(), std::runtime_error); // NOLINT
+
+    // counts no number of bytes could hold, each element needs at least one
+    const std::string liar { "\xd0\x00\x00\x00\x05\xff\xff\xff\xff\x40", 10 };
+    Decoder d2 (liar.data(), liar.size());
+    ASSERT_THROW (d2.get_list(), std::runtime_error); // NOLINT
+    ASSERT_THROW (d2.enter(), std::runtime_error); // NOLINT
+    ASSERT_THROW (Decoder ("\xc1\x02\x03\x40", 4).get_map(), std::runtime_error); // NOLINT
+    ASSERT_THROW (Decoder ("\xe0\x02\x09\x71", 4).get_array(), std::runtime_error); // NOLINT
+
+    // unless they're a zero width type sharing the one constructor
+    ASSERT_EQ (9UL, Decoder ("\xe0\x02\x09\x40", 4).get_array());
+}
+
+/******************************************************************************/
+
+/**
+ * Going back to a remembered value leaves us exactly where we were once
+ * we come back out of it
+ */
+TEST (Decoder, recall) { // NOLINT
+    Decoder d (described.data(), described.size());
+
+    auto_enter ae (&d);
+    d.next();
+
+    auto_list_enter ale (&d, true);
+
+    ASSERT_EQ (0UL, d.remember (d.offset()));
+    d.next();
+    d.next();
+    ASSERT_EQ (1UL, d.remember (d.offset()));
+    d.next();
+
+    ASSERT_EQ (2UL, d.remembered());
+    ASSERT_FALSE (d.recalling());
+
+    d.recall (1);
+    ASSERT_TRUE (d.recalling());
+    ASSERT_EQ (list_t, d.type());
+    ASSERT_EQ (1UL, d.get_list());
+    {
+        auto_list_enter ale2 (&d, true);
+        ASSERT_EQ (long_t, d.type());
+
+        // references inside a recalled value can be recalled too
+        d.recall (0);
+        ASSERT_EQ ("ab", get_string (&d));
+        ASSERT_FALSE (d.next());
+        d.exit();
+
+        ASSERT_TRUE (d.recalling());
+    }
+    ASSERT_FALSE (d.next());
+    d.exit();
+
+    ASSERT_FALSE (d.recalling());
+    ASSERT_EQ (ulong_t, d.type());
+    ASSERT_EQ (0UL, d.get_ulong());
+
+    ASSERT_THROW (d.recall (2), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Decoder, arrayValues) { // NOLINT
+    // [ 1, 2, -3 ] as full width ints
+    const std::string ints {
+        "\xe0\x0e\x03\x71"
+            "\x00\x00\x00\x01" "\x00\x00\x00\x02" "\xff\xff\xff\xfd", 16
+    };
+
+    // [ 1, 2, -3 ] as small ints
+    const std::string smallInts { "\xe0\x05\x03\x54\x01\x02\xfd", 7 };
+
+    // [ 1L, -2L ]
+    const std::string longs {
+        "\xe0\x12\x02\x81"
+            "\x00\x00\x00\x00\x00\x00\x00\x01"
+            "\xff\xff\xff\xff\xff\xff\xff\xfe", 20
+    };
+
+    // [ 1.5 ]
+    const std::string doubles {
+        "\xe0\x0a\x01\x82" "\x3f\xf8\x00\x00\x00\x00\x00\x00", 12
+    };
+
+    const std::string empty { "\xe0\x02\x00\x71", 4 };
+
+    std::vector<int32_t> i;
+    std::vector<int64_t> l;
+    std::vector<double> dbl;
+
+    {
+        Decoder d (ints.data(), ints.size());
+        ASSERT_TRUE (d.get_array_values (i));
+        ASSERT_EQ ((std::vector<int32_t> { 1, 2, -3 }), i);
+
+        // wrong width, nothing changes
+        ASSERT_FALSE (d.get_array_values (l));
+        ASSERT_FALSE (d.get_array_values (dbl));
+    }
+
+    {
+        Decoder d (smallInts.data(), smallInts.size());
+        ASSERT_TRUE (d.get_array_values (i));
+        ASSERT_EQ ((std::vector<int32_t> { 1, 2, -3 }), i);
+    }
+
+    {
+        Decoder d (longs.data(), longs.size());
+        ASSERT_TRUE (d.get_array_values (l));
+        ASSERT_EQ ((std::vector<int64_t> { 1, -2 }), l);
+    }
+
+    {
+        Decoder d (doubles.data(), doubles.size());
+        ASSERT_TRUE (d.get_array_values (dbl));
+        ASSERT_EQ ((std::vector<double> { 1.5 }), dbl);
+    }
+
+    {
+        Decoder d (empty.data(), empty.size());
+        ASSERT_TRUE (d.get_array_values (i));
+        ASSERT_TRUE (i.empty());
+    }
+
+    {
+        // not an array at all
+        Decoder d (described.data(), described.size());
+        ASSERT_FALSE (d.get_array_values (i));
+    }
+}
+
+/******************************************************************************/
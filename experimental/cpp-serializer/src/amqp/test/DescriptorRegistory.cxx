@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <proton/codec.h>
+
+#include "amqp/schema/Descriptors.h"
+#include "amqp/schema/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+namespace r3 = amqp::schema::descriptors;
+
+/******************************************************************************/
+
+TEST (DescriptorRegistory, known) { // NOLINT
+    EXPECT_EQ ("ENVELOPE",
+            AMQPDescriptorRegistory (r3::ENVELOPE | r3::DESCRIPTOR_TOP_32BITS).symbol());
+    EXPECT_EQ ("RESTRICTED_TYPE",
+            AMQPDescriptorRegistory (r3::RESTRICTED_TYPE | r3::DESCRIPTOR_TOP_32BITS).symbol());
+    EXPECT_EQ ("TRANSFORM_ELEMENT_KEY",
+            AMQPDescriptorRegistory (r3::TRANSFORM_ELEMENT_KEY | r3::DESCRIPTOR_TOP_32BITS).symbol());
+    EXPECT_EQ ("DESCRIBED", AMQPDescriptorRegistory (PN_DESCRIBED).symbol());
+}
+
+/******************************************************************************/
+
+TEST (DescriptorRegistory, unknown) { // NOLINT
+    // no descriptor zero, nothing past the end of the range, nothing
+    // without the R3 enterprise number and no other proton types
+    EXPECT_THROW (AMQPDescriptorRegistory (r3::DESCRIPTOR_TOP_32BITS), std::runtime_error); // NOLINT
+    EXPECT_THROW (AMQPDescriptorRegistory (12UL | r3::DESCRIPTOR_TOP_32BITS), std::runtime_error); // NOLINT
+    EXPECT_THROW (AMQPDescriptorRegistory (r3::ENVELOPE), std::runtime_error); // NOLINT
+    EXPECT_THROW (AMQPDescriptorRegistory (PN_LIST), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
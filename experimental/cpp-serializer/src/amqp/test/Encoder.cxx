@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdio>
+#include <memory>
+#include <iterator>
+
+#include <unistd.h>
+
+#include "amqp/encoder/Encoder.h"
+#include "amqp/decoder/Decoder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * described (1UL) [ "ab", 7, -70000, [ 1L ], { "k" : 2.5 } ] and then a
+     * second top level value, true
+     */
+    void
+    encode (encoder::Encoder & e_) {
+        e_.putDescribed();
+        e_.putUlong (1);
+        e_.beginList();
+        e_.putString ("ab");
+        e_.putInt (7);
+        e_.putInt (-70000);
+        e_.beginList();
+        e_.putLong (1);
+        e_.endList();
+        e_.beginMap();
+        e_.putSymbol ("k");
+        e_.putDouble (2.5);
+        e_.endMap();
+        e_.endList();
+        e_.putBool (true);
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * What we write the Decoder reads back, sizes and counts included
+ */
+TEST (Encoder, roundTrip) { // NOLINT
+    encoder::Encoder e;
+    encode (e);
+
+    ASSERT_EQ (e.size(), e.str().size());
+
+    decoder::Decoder d (e.str().data(), e.str().size());
+
+    ASSERT_EQ (decoder::described_t, d.type());
+    {
+        decoder::auto_enter ae (&d);
+        ASSERT_EQ (1UL, d.get_ulong());
+
+        ASSERT_TRUE (d.next());
+        decoder::auto_list_enter ale (&d, true);
+        ASSERT_EQ (5UL, ale.elements());
+
+        ASSERT_EQ ("ab", decoder::readAndNext<std::string> (&d));
+        ASSERT_EQ (7, decoder::readAndNext<int32_t> (&d));
+        ASSERT_EQ (-70000, decoder::readAndNext<int32_t> (&d));
+
+        {
+            decoder::auto_list_enter ale2 (&d, true);
+            ASSERT_EQ (1UL, ale2.elements());
+            ASSERT_EQ (1L, decoder::readAndNext<long> (&d));
+        }
+
+        ASSERT_TRUE (d.next());
+
+        {
+            // keys and values both count
+            decoder::auto_map_enter ame (&d, true);
+            ASSERT_EQ (2UL, ame.elements());
+            ASSERT_EQ ("k", decoder::readAndNext<std::string_view> (&d));
+            ASSERT_EQ (2.5, decoder::readAndNext<double> (&d));
+        }
+    }
+
+    ASSERT_TRUE (d.next());
+    ASSERT_TRUE (d.get_bool());
+    ASSERT_FALSE (d.next());
+}
+
+/******************************************************************************/
+
+TEST (Encoder, scalars) { // NOLINT
+    encoder::Encoder e;
+
+    e.putByte (-2);
+    e.putUshort (65000);
+    e.putUint (0);
+    e.putUint (300);
+    e.putUlong (1ULL << 63);
+    e.putChar (0x1F600);
+    e.putTimestamp (-1);
+    e.putFloat (1.5F);
+    e.putUuid ({ '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f' });
+    e.putBinary (std::string (300, '\x7f'));
+    e.putNull();
+
+    decoder::Decoder d (e.str().data(), e.str().size());
+
+    ASSERT_EQ (-2, d.get_byte()); d.next();
+    ASSERT_EQ (65000, d.get_ushort()); d.next();
+    ASSERT_EQ (0U, d.get_uint()); d.next();
+    ASSERT_EQ (300U, d.get_uint()); d.next();
+    ASSERT_EQ (1ULL << 63, d.get_ulong()); d.next();
+    ASSERT_EQ (0x1F600U, d.get_char()); d.next();
+    ASSERT_EQ (-1, d.get_timestamp()); d.next();
+    ASSERT_EQ (1.5F, d.get_float()); d.next();
+    ASSERT_EQ ('f', d.get_uuid()[15]); d.next();
+    ASSERT_EQ (std::string (300, '\x7f'), d.get_binary()); d.next();
+    ASSERT_EQ (decoder::null_t, d.type());
+}
+
+/******************************************************************************/
+
+/**
+ * Written out a megabyte at a time, with sizes that are only known once
+ * that's happened patched into the file, gives the same bytes as keeping it
+ * all in memory
+ */
+TEST (Encoder, file) { // NOLINT
+    auto big = [](encoder::Encoder & e_) {
+        e_.beginList();
+        for (int i { 0 } ; i < 100000 ; ++i) {
+            e_.putString ("0123456789abcdefghijklmnopqrstuvwxyz");
+        }
+        e_.endList();
+        encode (e_);
+    };
+
+    encoder::Encoder memory;
+    big (memory);
+
+    std::unique_ptr<FILE, decltype(&::fclose)> file { ::tmpfile(), ::fclose };
+    ASSERT_TRUE (file);
+
+    {
+        encoder::Encoder e (::fileno (file.get()));
+        big (e);
+        e.flush();
+
+        ASSERT_EQ (memory.size(), e.size());
+    }
+
+    std::string written (memory.size(), '\0');
+    ASSERT_EQ (
+        static_cast<ssize_t>(written.size()),
+        ::pread (::fileno (file.get()), written.data(), written.size(), 0));
+
+    ASSERT_EQ (memory.str(), written);
+}
+
+/******************************************************************************/
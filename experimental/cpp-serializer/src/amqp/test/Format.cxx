@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <limits>
+
+#include "amqp/Format.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+/**
+ * Put something that needs escaping at every position of strings either
+ * side of a few vector widths, from every alignment, and check it's the
+ * first thing found
+ */
+TEST (Format, jsonEscape) { // NOLINT
+    const char specials[] = { '"', '\\', '\n', '\x01', '\x1f' };
+
+    std::string in (128 + 32, 'a');
+
+    for (size_t offset { 0 } ; offset < 32 ; ++offset) {
+        for (size_t n { 0 } ; n <= 128 ; ++n) {
+            ASSERT_EQ (n, jsonEscape (in.data() + offset, n))
+                << formatImplementation() << " n " << n;
+
+            for (size_t at { 0 } ; at < n ; ++at) {
+                auto c = specials[at % sizeof (specials)];
+
+                in[offset + at] = c;
+
+                ASSERT_EQ (at, jsonEscape (in.data() + offset, n))
+                    << formatImplementation()
+                    << " n " << n << " at " << at << " offset " << offset;
+
+                in[offset + at] = 'a';
+            }
+        }
+    }
+
+    // nothing past 0x7f is special, UTF-8 goes through as it is
+    const std::string utf8 ("\xc3\xa9\xe2\x82\xac \xf0\x9f\x98\x80 0123456789abcdef");
+    ASSERT_EQ (utf8.size(), jsonEscape (utf8.data(), utf8.size()));
+}
+
+/******************************************************************************/
+
+TEST (Format, appendJsonString) { // NOLINT
+    std::string out ("x");
+
+    appendJsonString (out, std::string_view ("a\"b\\c\nd\te\x01", 10));
+    ASSERT_EQ (R"(x"a\"b\\c\nd\te\u0001")", out);
+}
+
+/******************************************************************************/
+
+TEST (Format, toChars) { // NOLINT
+    NumberBuffer buffer;
+
+    ASSERT_EQ ("10.1", toChars (buffer, 10.1));
+    ASSERT_EQ ("10", toChars (buffer, 10.0));
+    ASSERT_EQ ("1e+300", toChars (buffer, 1e300));
+    ASSERT_EQ ("-9223372036854775808", toChars (buffer, std::numeric_limits<int64_t>::min()));
+    ASSERT_EQ ("1", toChars (buffer, true));
+
+    std::string out ("n=");
+    appendNumber (out, 0.25f);
+    ASSERT_EQ ("n=0.25", out);
+}
+
+/******************************************************************************/
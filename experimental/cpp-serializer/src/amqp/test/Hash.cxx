@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Hash.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+/**
+ * The reference implementation's answers, covering the short input path,
+ * the 32 byte stripes and the 8, 4 and 1 byte tails
+ */
+TEST (Hash, xxh64) { // NOLINT
+    EXPECT_EQ (0xef46db3751d8e999ULL, xxh64 (""));
+    EXPECT_EQ (0x44bc2cf5ad770999ULL, xxh64 ("abc"));
+    EXPECT_EQ (0xfbcea83c8a378bf1ULL, xxh64 ("Nobody inspects the spammish repetition"));
+}
+
+/******************************************************************************/
+
+TEST (Hash, seeded) { // NOLINT
+    EXPECT_NE (xxh64 ("abc"), xxh64 ("abc", 1));
+    EXPECT_EQ (xxh64 ("abc", 1), xxh64 (std::string ("abc"), 1));
+}
+
+/******************************************************************************/
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "visitors/JsonWriter.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    walk (JsonWriter & writer_) {
+        writer_.beginComposite ("c");
+            writer_.key ("a");
+            writer_.intValue (-1);
+            writer_.key ("b");
+            writer_.beginList();
+                writer_.doubleValue (10.1);
+                writer_.boolValue (true);
+                writer_.longValue (100000000000L);
+            writer_.endList();
+            writer_.key ("c");
+            writer_.beginMap();
+                writer_.intValue (1);
+                writer_.enumValue ("E");
+                writer_.stringValue ("k");
+                writer_.beginList();
+                writer_.endList();
+            writer_.endMap();
+        writer_.endComposite();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, compact) { // NOLINT
+    JsonWriter writer;
+
+    walk (writer);
+
+    EXPECT_EQ (
+        R"({"a":-1,"b":[10.1,true,100000000000],"c":{"1":"E","k":[]}})",
+        writer.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, pretty) { // NOLINT
+    JsonWriter writer (JsonWriter::pretty_t);
+
+    walk (writer);
+
+    EXPECT_EQ (
+        "{\n"
+        "  \"a\": -1,\n"
+        "  \"b\": [\n"
+        "    10.1,\n"
+        "    true,\n"
+        "    100000000000\n"
+        "  ],\n"
+        "  \"c\": {\n"
+        "    \"1\": \"E\",\n"
+        "    \"k\": []\n"
+        "  }\n"
+        "}",
+        writer.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, escaping) { // NOLINT
+    JsonWriter writer;
+
+    writer.beginList();
+    writer.stringValue ("a\"b\\c\nd\te\x01 \xc3\xa9");
+    writer.doubleValue (1.0 / 0.0);
+    writer.endList();
+
+    EXPECT_EQ (R"(["a\"b\\c\nd\te\u0001 )" "\xc3\xa9" R"(",null])", writer.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, binary) { // NOLINT
+    const std::string bytes ("\x00\xfbMan", 5);
+
+    JsonWriter hex;
+    hex.beginMap();
+    hex.binaryValue (bytes);
+    hex.binaryValue (bytes);
+    hex.endMap();
+
+    EXPECT_EQ (R"({"00fb4d616e":"00fb4d616e"})", hex.str());
+
+    JsonWriter base64 (JsonWriter::compact_t, -1, JsonWriter::base64_t);
+    base64.beginList();
+    base64.binaryValue (bytes);
+    base64.binaryValue ({ });
+    base64.endList();
+
+    EXPECT_EQ (R"(["APtNYW4=",""])", base64.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, compositeMapKey) { // NOLINT
+    auto walk = [](JsonWriter & writer_) {
+        writer_.beginMap();
+            writer_.beginComposite ("c");
+                writer_.key ("a");
+                writer_.intValue (1);
+            writer_.endComposite();
+            writer_.stringValue ("x");
+            writer_.beginList();
+            writer_.endList();
+            writer_.beginMap();
+            writer_.endMap();
+        writer_.endMap();
+    };
+
+    JsonWriter compact;
+    walk (compact);
+
+    EXPECT_EQ (R"([[{"a":1},"x"],[[],{}]])", compact.str());
+
+    JsonWriter pretty (JsonWriter::pretty_t);
+    walk (pretty);
+
+    EXPECT_EQ (
+        "[\n"
+        "  [\n"
+        "    {\n"
+        "      \"a\": 1\n"
+        "    },\n"
+        "    \"x\"\n"
+        "  ],\n"
+        "  [\n"
+        "    [],\n"
+        "    {}\n"
+        "  ]\n"
+        "]",
+        pretty.str());
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, mixedMapKeys) { // NOLINT
+    JsonWriter writer;
+
+    writer.beginMap();
+    writer.intValue (1);
+    writer.intValue (2);
+
+    EXPECT_THROW (writer.beginList(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, descriptor) { // NOLINT
+    char path[] = "/tmp/json-writer-XXXXXX";
+    int fd = ::mkstemp (path);
+    ASSERT_LE (0, fd);
+
+    {
+        JsonWriter writer (JsonWriter::compact_t, fd);
+        walk (writer);
+        writer.finish();
+
+        EXPECT_TRUE (writer.str().empty());
+    }
+
+    ::close (fd);
+
+    std::ifstream file (path);
+    std::string written {
+        std::istreambuf_iterator<char> (file),
+        std::istreambuf_iterator<char>() };
+
+    ::unlink (path);
+
+    EXPECT_EQ (
+        R"({"a":-1,"b":[10.1,true,100000000000],"c":{"1":"E","k":[]}})" "\n",
+        written);
+}
+
+/******************************************************************************/
@@ -19,8 +19,8 @@ TEST (List, dependsOn1) {
     auto list1 = test::list ("string");
     auto list2 = test::list (list1->name());
 
-    ASSERT_EQ (1, list1->dependsOn (*list2));
-    ASSERT_EQ (2, list2->dependsOn (*list1));
+    ASSERT_EQ (std::vector<std::string_view> { "string" }, list1->dependencies());
+    ASSERT_EQ (std::vector<std::string_view> { list1->name() }, list2->dependencies());
 }
 
 /******************************************************************************/
@@ -16,41 +16,10 @@ namespace {
                 , m_dependsOn (std::move (dependsOn_))
             { }
 
+            const std::string & name() const override { return m_name; }
 
-            int dependsOn (const OrderedTypeNotation & otn_) const override {
-                const auto & otn = dynamic_cast<const OTN &>(otn_);
-
-                // does the "left hand side" depend on us (in this case
-                // the lhs is us as we're not inverting
-                if (std::find (
-                        m_dependsOn.begin(),
-                        m_dependsOn.end(),
-                        otn.name()) != m_dependsOn.end())
-                {
-                    return 1;
-                }
-
-                // do we depend on the left hand side
-
-                if (std::find (
-                        otn.begin(),
-                        otn.end(),
-                        name()) != otn.end())
-                {
-                    return 2;
-                }
-
-                return 0;
-            }
-
-            const std::string & name() const { return m_name; }
-
-            decltype(m_dependsOn.cbegin()) begin() const {
-                return m_dependsOn.cbegin();
-            }
-
-            decltype(m_dependsOn.cend()) end() const {
-                return m_dependsOn.cend();
+            std::vector<std::string_view> dependencies() const override {
+                return { m_dependsOn.begin(), m_dependsOn.end() };
             }
     };
 
@@ -69,7 +38,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<OTN> &otn_
 ) {
     auto first { true };
-    for (const auto & i : otn_.m_schemas) {
+    for (const auto & i : otn_) {
         for (const auto & j : i) {
             if (first) {
                 first = false;
@@ -114,11 +83,9 @@ TEST (OTNTest, twoInserts) { // NOLINT
     list.insert(std::make_unique<OTN>("A", std::vector<std::string>()));
     list.insert(std::make_unique<OTN>("B", std::vector<std::string>()));
 
-    // Inserting B after A with no dependencies between the two will force
-    // B to be recorded before A since elements added at the same
-    // level are always added to the front of the list to ensrue we can
-    // inspect the rest of that level
-    ASSERT_EQ ("B A", str (list));
+    // With no dependencies between the two they share a level and keep
+    // the order they were inserted in
+    ASSERT_EQ ("A B", str (list));
 }
 
 /******************************************************************************/
@@ -129,7 +96,7 @@ TEST (OTNTest, A_depends_on_B) { // NOLINT
     std::vector<std::string> aDeps = { "B" };
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", std::vector<std::string>()));
-    ASSERT_EQ("A B", str (list));
+    ASSERT_EQ("B A", str (list));
 }
 
 /******************************************************************************/
@@ -143,7 +110,7 @@ TEST (OTNTest, B_depends_on_A) { // NOLINT
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", bDeps));
 
-    ASSERT_EQ ("B A", str (list));
+    ASSERT_EQ ("A B", str (list));
 }
 
 /******************************************************************************/
@@ -159,7 +126,7 @@ TEST (OTNTest, three_1) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("C", cDeps));
 
-    ASSERT_EQ ("B C A", str (list));
+    ASSERT_EQ ("A B C", str (list));
 }
 
 /******************************************************************************/
@@ -175,7 +142,7 @@ TEST (OTNTest, three_2) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("C", cDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -191,7 +158,7 @@ TEST (OTNTest, three_3) { // NOLINT
     list.insert(std::make_unique<OTN>("A", aDeps));
     list.insert(std::make_unique<OTN>("B", bDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -207,7 +174,7 @@ TEST (OTNTest, three_4) { // NOLINT
     list.insert(std::make_unique<OTN>("B", bDeps));
     list.insert(std::make_unique<OTN>("A", aDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
 }
 
 /******************************************************************************/
@@ -223,7 +190,74 @@ TEST (OTNTest, three_5) { // NOLINT
     list.insert(std::make_unique<OTN>("C", cDeps));
     list.insert(std::make_unique<OTN>("A", aDeps));
 
-    EXPECT_EQ ("A B C", str (list));
+    EXPECT_EQ ("C B A", str (list));
+}
+
+/******************************************************************************/
+
+/**
+ * Each type lands one level after the deepest thing it depends on
+ */
+TEST (OTNTest, levels) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("D", std::vector<std::string> { "B", "C" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A", "int" }));
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "A" }));
+    list.insert(std::make_unique<OTN>("E", std::vector<std::string> { }));
+
+    std::vector<std::vector<std::string>> levels;
+    for (const auto & level : list) {
+        levels.emplace_back();
+        for (const auto & type : level) {
+            levels.back().push_back (type->name());
+        }
+    }
+
+    ASSERT_EQ (
+        (std::vector<std::vector<std::string>> {
+            { "A", "E" }, { "C", "B" }, { "D" } }),
+        levels);
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, circular) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A" }));
+
+    ASSERT_THROW (str (list), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/**
+ * A long chain inserted back to front used to be the worst case
+ */
+TEST (OTNTest, longChain) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    const int n { 5000 };
+
+    for (int i { n - 1 } ; i >= 0 ; --i) {
+        std::vector<std::string> deps;
+        if (i) {
+            deps.push_back (std::to_string (i - 1));
+        }
+
+        list.insert(std::make_unique<OTN>(std::to_string (i), deps));
+    }
+
+    int i { 0 };
+    for (const auto & level : list) {
+        ASSERT_EQ (1UL, level.size());
+        ASSERT_EQ (std::to_string (i++), level.front()->name());
+    }
+
+    ASSERT_EQ (n, i);
 }
 
 /******************************************************************************/
@@ -31,7 +31,7 @@ TEST (Pair, UP1) { // NOLINT
     std::unique_ptr<TypedPair<double>> test =
         std::make_unique<TypedPair<double>> ("property", 10.0);
 
-    EXPECT_EQ("property : 10.000000", test->dump());
+    EXPECT_EQ("property : 10", test->dump());
 }
 
 /******************************************************************************/
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sstream>
+
+#include "PropertyReader.h"
+#include "amqp/schema/described-types/Schema.h"
+#include "amqp/decoder/Decoder.h"
+#include "visitors/StreamVisitor.h"
+#include "visitors/RecordingVisitor.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Primitives never need to look anything up
+     */
+    const amqp::internal::schema::Schema &
+    schema() {
+        static const amqp::internal::schema::Schema schema {
+            amqp::internal::schema::OrderedTypeNotations<
+                amqp::internal::schema::AMQPTypeNotation> { }
+        };
+
+        return schema;
+    }
+
+    /**
+     * Visit the single AMQP value in [encoded_] as a [type_]
+     */
+    std::string
+    visit (const std::string & type_, const std::string & encoded_) {
+        amqp::internal::decoder::Decoder d (encoded_.data(), encoded_.size());
+
+        std::ostringstream ss;
+        StreamVisitor visitor (ss);
+
+        PropertyReader::make (type_)->visit (&d, schema(), visitor);
+
+        return ss.str();
+    }
+
+    std::string
+    readString (const std::string & type_, const std::string & encoded_) {
+        amqp::internal::decoder::Decoder d (encoded_.data(), encoded_.size());
+
+        return PropertyReader::make (type_)->readString (&d);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, primitive) { // NOLINT
+    using amqp::internal::schema::Field;
+
+    for (const auto * type : {
+        "int", "string", "char", "byte", "short", "float", "binary",
+        "timestamp", "uuid", "decimal128", "symbol", "ulong" })
+    {
+        EXPECT_TRUE (Field::typeIsPrimitive (type)) << type;
+        EXPECT_EQ (type, PropertyReader::make (type)->type());
+    }
+
+    EXPECT_FALSE (Field::typeIsPrimitive ("net.corda.Int"));
+    EXPECT_FALSE (Field::typeIsPrimitive ("never.interned.before"));
+    EXPECT_THROW (PropertyReader::make ("list"), std::runtime_error);
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, integral) { // NOLINT
+    EXPECT_EQ ("-5", visit ("byte", std::string ("\x51\xfb", 2)));
+    EXPECT_EQ ("-300", visit ("short", std::string ("\x61\xfe\xd4", 3)));
+    EXPECT_EQ ("200", visit ("ubyte", std::string ("\x50\xc8", 2)));
+    EXPECT_EQ ("65535", visit ("ushort", std::string ("\x60\xff\xff", 3)));
+    EXPECT_EQ ("4000000000", visit ("uint", std::string ("\x70\xee\x6b\x28\x00", 5)));
+    EXPECT_EQ ("18446744073709551615",
+        visit ("ulong", std::string ("\x80\xff\xff\xff\xff\xff\xff\xff\xff", 9)));
+    EXPECT_EQ ("7", visit ("ulong", std::string ("\x53\x07", 2)));
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, text) { // NOLINT
+    EXPECT_EQ (R"("A")", visit ("char", std::string ("\x73\x00\x00\x00\x41", 5)));
+    EXPECT_EQ ("\"\xc3\xa9\"", visit ("char", std::string ("\x73\x00\x00\x00\xe9", 5)));
+    EXPECT_EQ ("\"\xe2\x82\xac\"", visit ("char", std::string ("\x73\x00\x00\x20\xac", 5)));
+
+    // surrogates and anything past U+10FFFF have no UTF-8 form
+    EXPECT_EQ ("\"\xef\xbf\xbd\"", visit ("char", std::string ("\x73\x00\x00\xd8\x00", 5)));
+    EXPECT_EQ ("\"\xef\xbf\xbd\"", visit ("char", std::string ("\x73\x00\x11\x00\x00", 5)));
+    EXPECT_EQ ("\"\xf4\x8f\xbf\xbf\"", visit ("char", std::string ("\x73\x00\x10\xff\xff", 5)));
+
+    EXPECT_EQ (R"("net.corda:abc")", visit ("symbol", std::string ("\xa3\x0d" "net.corda:abc", 15)));
+
+    EXPECT_EQ (R"("00ff10")", visit ("binary", std::string ("\xa0\x03\x00\xff\x10", 5)));
+    EXPECT_EQ (R"("")", visit ("binary", std::string ("\xa0\x00", 2)));
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, floats) { // NOLINT
+    EXPECT_EQ ("0.1", visit ("float", std::string ("\x72\x3d\xcc\xcc\xcd", 5)));
+    EXPECT_EQ ("-2", visit ("float", std::string ("\x72\xc0\x00\x00\x00", 5)));
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, timestamp) { // NOLINT
+    EXPECT_EQ (R"("2019-06-12T13:40:05.123Z")",
+        visit ("timestamp", std::string ("\x83\x00\x00\x01\x6b\x4b\xea\xc3\x83", 9)));
+    EXPECT_EQ ("1970-01-01T00:00:00.000Z",
+        readString ("timestamp", std::string ("\x83\x00\x00\x00\x00\x00\x00\x00\x00", 9)));
+    EXPECT_EQ ("1969-12-31T23:59:59.999Z",
+        readString ("timestamp", std::string ("\x83\xff\xff\xff\xff\xff\xff\xff\xff", 9)));
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, uuid) { // NOLINT
+    EXPECT_EQ (R"("00112233-4455-6677-8899-aabbccddeeff")",
+        visit ("uuid", std::string (
+            "\x98\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc\xdd\xee\xff", 17)));
+}
+
+/******************************************************************************/
+
+TEST (PropertyReader, decimal) { // NOLINT
+    EXPECT_EQ ("1.23", visit ("decimal32", std::string ("\x74\x31\x80\x00\x7b", 5)));
+    // coefficient too wide for the short form
+    EXPECT_EQ ("9999999", visit ("decimal32", std::string ("\x74\x6c\xb8\x96\x7f", 5)));
+    EXPECT_EQ ("-0.000001",
+        visit ("decimal64", std::string ("\x84\xb1\x00\x00\x00\x00\x00\x00\x01", 9)));
+    EXPECT_EQ ("1E-7",
+        visit ("decimal64", std::string ("\x84\x30\xe0\x00\x00\x00\x00\x00\x01", 9)));
+    EXPECT_EQ ("1.2345E+7",
+        visit ("decimal128", std::string (
+            "\x94\x30\x46\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x30\x39", 17)));
+    // infinity
+    EXPECT_EQ ("inf", visit ("decimal32", std::string ("\x74\x78\x00\x00\x00", 5)));
+}
+
+/******************************************************************************/
+
+/**
+ * Numbers survive being recorded and played back
+ */
+TEST (PropertyReader, recorded) { // NOLINT
+    const std::string encoded ("\x74\x31\x80\x00\x7b", 5);
+
+    amqp::internal::decoder::Decoder d (encoded.data(), encoded.size());
+
+    RecordingVisitor recording;
+    PropertyReader::make ("decimal32")->visit (&d, schema(), recording);
+
+    std::ostringstream ss;
+    StreamVisitor visitor (ss);
+    recording.replay (visitor);
+
+    EXPECT_EQ ("1.23", ss.str());
+}
+
+/******************************************************************************/
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <chrono>
+
+#include "Stats.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+namespace {
+
+    void
+    sleep (int ms_) {
+        std::this_thread::sleep_for (std::chrono::milliseconds (ms_));
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Stats, nothingCollecting) { // NOLINT
+    ASSERT_EQ (nullptr, Stats::current());
+
+    {
+        Stats::Timer timer (Stats::render_t);
+        sleep (1);
+    }
+
+    ASSERT_EQ (nullptr, Stats::current());
+}
+
+/******************************************************************************/
+
+/**
+ * Scopes nest, the outer one being collected into again once the inner
+ * one's gone
+ */
+TEST (Stats, scope) { // NOLINT
+    Stats outer;
+    Stats inner;
+
+    {
+        Stats::Scope s1 (outer);
+        EXPECT_EQ (&outer, Stats::current());
+
+        {
+            Stats::Scope s2 (inner);
+            EXPECT_EQ (&inner, Stats::current());
+        }
+
+        EXPECT_EQ (&outer, Stats::current());
+    }
+
+    EXPECT_EQ (nullptr, Stats::current());
+}
+
+/******************************************************************************/
+
+/**
+ * The outer stage isn't charged for the time spent in the one inside it
+ */
+TEST (Stats, timersNest) { // NOLINT
+    Stats stats;
+
+    {
+        Stats::Scope scope (stats);
+        Stats::Timer outer (Stats::schema_t);
+
+        sleep (5);
+
+        {
+            Stats::Timer inner (Stats::readers_t);
+            sleep (20);
+        }
+    }
+
+    EXPECT_GE (stats.time[Stats::readers_t], std::chrono::milliseconds (20));
+    EXPECT_GE (stats.time[Stats::schema_t], std::chrono::milliseconds (5));
+    EXPECT_LT (stats.time[Stats::schema_t], stats.time[Stats::readers_t]);
+    EXPECT_EQ (0, stats.time[Stats::render_t].count());
+}
+
+/******************************************************************************/
+
+TEST (Stats, add) { // NOLINT
+    Stats a;
+    Stats b;
+
+    a.blobs = 1;
+    a.values = 10;
+    a.nodes = 12;
+    a.time[Stats::read_t] = std::chrono::nanoseconds (5);
+
+    b.blobs = 2;
+    b.values = 3;
+    b.misses = 1;
+    b.time[Stats::read_t] = std::chrono::nanoseconds (7);
+
+    a += b;
+
+    EXPECT_EQ (3, a.blobs);
+    EXPECT_EQ (13, a.values);
+    EXPECT_EQ (12, a.nodes);
+    EXPECT_EQ (1, a.misses);
+    EXPECT_EQ (12, a.time[Stats::read_t].count());
+}
+
+/******************************************************************************/
+
+/**
+ * Nothing in this binary counts allocations so none are reported
+ */
+TEST (Stats, summary) { // NOLINT
+    Stats stats;
+
+    stats.blobs = 2;
+    stats.bytes = 100;
+    stats.time[Stats::render_t] = std::chrono::milliseconds (3);
+
+    EXPECT_EQ (
+        "blobs 2, bytes 100, types 0, values 0, nodes 0, schema hits 0, "
+        "misses 0 | read 0.000ms, envelope 0.000ms, schema 0.000ms, "
+        "readers 0.000ms, render 3.000ms, total 3.000ms",
+        stats.summary());
+}
+
+/******************************************************************************/
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Symbols.h"
+#include "SymbolMap.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+TEST (Symbols, intern) { // NOLINT
+    auto a = intern ("net.corda:symbolsTestA");
+    auto b = intern ("net.corda:symbolsTestB");
+
+    EXPECT_TRUE (a.valid());
+    EXPECT_TRUE (b.valid());
+    EXPECT_NE (a, b);
+
+    // interning the same name from a different string gives the same symbol
+    std::string name { "net.corda:" };
+    name += "symbolsTestA";
+
+    EXPECT_EQ (a, intern (name));
+    EXPECT_EQ (a, Symbols::instance().find (name));
+    EXPECT_EQ ("net.corda:symbolsTestA", a.str());
+}
+
+/******************************************************************************/
+
+TEST (Symbols, findNeverAdds) { // NOLINT
+    auto size = Symbols::instance().size();
+
+    EXPECT_FALSE (Symbols::instance().find ("net.corda:symbolsTestMissing").valid());
+    EXPECT_EQ (size, Symbols::instance().size());
+
+    EXPECT_THROW (Symbol().str(), std::out_of_range); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Symbols, grow) { // NOLINT
+    std::vector<Symbol> symbols;
+
+    for (int i { 0 } ; i < 1000 ; ++i) {
+        symbols.push_back (intern ("symbolsTestGrow." + std::to_string (i)));
+    }
+
+    for (int i { 0 } ; i < 1000 ; ++i) {
+        auto name = "symbolsTestGrow." + std::to_string (i);
+
+        EXPECT_EQ (symbols[i], Symbols::instance().find (name));
+        EXPECT_EQ (name, symbols[i].str());
+    }
+}
+
+/******************************************************************************/
+
+TEST (SymbolMap, emplace) { // NOLINT
+    SymbolMap<std::string> map;
+
+    auto a = intern ("symbolMapTestA");
+    auto b = intern ("symbolMapTestB");
+
+    EXPECT_TRUE (map.emplace (a, "a").second);
+    EXPECT_FALSE (map.emplace (a, "not a").second);
+
+    EXPECT_EQ (1, map.size());
+    EXPECT_EQ ("a", map.find (a)->second);
+    EXPECT_EQ (map.end(), map.find (b));
+    EXPECT_EQ (map.end(), map.find (Symbol()));
+
+    map[b] = "b";
+
+    EXPECT_EQ (2, map.size());
+    EXPECT_EQ ("b", map.find (b)->second);
+}
+
+/******************************************************************************/
+
+TEST (SymbolMap, grow) { // NOLINT
+    SymbolMap<int> map;
+
+    for (int i { 0 } ; i < 1000 ; ++i) {
+        map.emplace (intern ("symbolMapTestGrow." + std::to_string (i)), i);
+    }
+
+    EXPECT_EQ (1000, map.size());
+
+    for (int i { 0 } ; i < 1000 ; ++i) {
+        auto it = map.find (intern ("symbolMapTestGrow." + std::to_string (i)));
+
+        ASSERT_NE (map.end(), it);
+        EXPECT_EQ (i, it->second);
+    }
+
+    // iterates in the order things were added
+    int i { 0 };
+    for (const auto & entry : map) {
+        EXPECT_EQ (i++, entry.second);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sstream>
+
+#include "Reader.h"
+#include "visitors/TreeVisitor.h"
+#include "visitors/StreamVisitor.h"
+#include "visitors/CountingVisitor.h"
+#include "visitors/RecordingVisitor.h"
+
+/******************************************************************************/
+
+using namespace amqp::reader;
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * { a : 1, b : [ "x", "y" ], c : { 1 : E, 2 : { d : 0 } } }
+     */
+    void
+    walk (IVisitor & visitor_) {
+        visitor_.key ("top");
+        visitor_.beginComposite ("c");
+            visitor_.key ("a");
+            visitor_.intValue (1);
+            visitor_.key ("b");
+            visitor_.beginList();
+                visitor_.stringValue ("x");
+                visitor_.stringValue ("y");
+            visitor_.endList();
+            visitor_.key ("c");
+            visitor_.beginMap();
+                visitor_.longValue (1);
+                visitor_.enumValue ("E");
+                visitor_.longValue (2);
+                visitor_.beginComposite ("d");
+                    visitor_.key ("d");
+                    visitor_.boolValue (false);
+                visitor_.endComposite();
+            visitor_.endMap();
+            visitor_.key ("e");
+            visitor_.beginList();
+            visitor_.endList();
+        visitor_.endComposite();
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Visitor, tree) { // NOLINT
+    TreeVisitor visitor;
+
+    walk (visitor);
+
+    EXPECT_EQ (
+        R"(top : { a : 1, b : [ "x", "y" ], c : { 1 : E, 2 : { d : 0 } }, e : [  ] })",
+        visitor.result()->dump());
+}
+
+/******************************************************************************/
+
+TEST (Visitor, stream) { // NOLINT
+    std::stringstream ss;
+    StreamVisitor visitor (ss);
+
+    walk (visitor);
+
+    EXPECT_EQ (
+        R"(top : { a : 1, b : [ "x", "y" ], c : { 1 : E, 2 : { d : 0 } }, e : [  ] })",
+        ss.str());
+}
+
+/******************************************************************************/
+
+/**
+ * A tree owns the arena it was built in so it has to survive the visitor
+ * that built it, and the visitor has to be good for another tree
+ */
+TEST (Visitor, treeOutlivesVisitor) { // NOLINT
+    uPtr<IValue> first, second;
+
+    {
+        TreeVisitor visitor;
+
+        walk (visitor);
+        first = visitor.result();
+
+        walk (visitor);
+        second = visitor.result();
+
+        ASSERT_EQ (nullptr, visitor.result());
+    }
+
+    EXPECT_EQ (first->dump(), second->dump());
+}
+
+/******************************************************************************/
+
+TEST (Visitor, recording) { // NOLINT
+    RecordingVisitor recording;
+    std::stringstream ss;
+    StreamVisitor visitor (ss);
+
+    walk (recording);
+    recording.replay (visitor);
+
+    EXPECT_EQ (
+        R"(top : { a : 1, b : [ "x", "y" ], c : { 1 : E, 2 : { d : 0 } }, e : [  ] })",
+        ss.str());
+}
+
+/******************************************************************************/
+
+TEST (Visitor, counting) { // NOLINT
+    std::stringstream ss;
+    StreamVisitor visitor (ss);
+    CountingVisitor counting (visitor);
+
+    walk (counting);
+
+    EXPECT_EQ (7, counting.values());
+    EXPECT_EQ (7 + 5, counting.nodes());
+    EXPECT_EQ (
+        R"(top : { a : 1, b : [ "x", "y" ], c : { 1 : E, 2 : { d : 0 } }, e : [  ] })",
+        ss.str());
+}
+
+/******************************************************************************/
+
+/**
+ * A recording always has the original revisited, a replay only passes that
+ * on if whoever it's replayed to wants it
+ */
+TEST (Visitor, recordingReferences) { // NOLINT
+    RecordingVisitor recording;
+
+    auto x = [&recording]() {
+        recording.beginComposite ("x");
+        recording.key ("a");
+        recording.intValue (1);
+        recording.endComposite();
+    };
+
+    recording.beginList();
+    x();
+    recording.object (0);
+    EXPECT_FALSE (recording.reference (0));
+    x();
+    recording.stringValue ("after");
+    recording.endList();
+
+    std::stringstream ss;
+    StreamVisitor stream (ss);
+    TreeVisitor tree (true);
+
+    recording.replay (stream);
+    recording.replay (tree);
+
+    EXPECT_EQ (R"([ { a : 1 }, { a : 1 }, "after" ])", ss.str());
+    EXPECT_EQ (ss.str(), tree.result()->dump());
+}
+
+/******************************************************************************/
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+#include "WorkPool.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+
+/******************************************************************************/
+
+TEST (WorkPool, runsEverything) { // NOLINT
+    WorkPool pool (3);
+
+    std::vector<int> done (1000, 0);
+    std::vector<std::function<void()>> tasks;
+
+    for (size_t i { 0 } ; i < done.size() ; ++i) {
+        tasks.emplace_back ([&done, i]() { done[i] += 1; });
+    }
+
+    pool.run (std::move (tasks));
+
+    for (auto i : done) {
+        ASSERT_EQ (1, i);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * The first failure is rethrown, but only once everything else has run
+ */
+TEST (WorkPool, rethrows) { // NOLINT
+    WorkPool pool (2);
+
+    std::atomic<int> ran { 0 };
+    std::vector<std::function<void()>> tasks;
+
+    for (int i { 0 } ; i < 10 ; ++i) {
+        tasks.emplace_back ([&ran, i]() {
+            ++ran;
+
+            if (i == 3) {
+                throw std::runtime_error ("three");
+            }
+        });
+    }
+
+    EXPECT_THROW (pool.run (std::move (tasks)), std::runtime_error); // NOLINT
+    EXPECT_EQ (10, ran);
+}
+
+/******************************************************************************/
+
+/**
+ * Tasks that run batches of their own, a worker waiting on its batch helps
+ * with whatever's queued rather than blocking
+ */
+TEST (WorkPool, nested) { // NOLINT
+    WorkPool pool (2);
+
+    std::atomic<int> ran { 0 };
+    std::vector<std::function<void()>> outer;
+
+    for (int i { 0 } ; i < 8 ; ++i) {
+        outer.emplace_back ([&pool, &ran]() {
+            std::vector<std::function<void()>> inner;
+
+            for (int j { 0 } ; j < 8 ; ++j) {
+                inner.emplace_back ([&ran]() { ++ran; });
+            }
+
+            pool.run (std::move (inner));
+        });
+    }
+
+    pool.run (std::move (outer));
+
+    EXPECT_EQ (64, ran);
+}
+
+/******************************************************************************/
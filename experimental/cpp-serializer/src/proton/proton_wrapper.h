@@ -5,6 +5,8 @@
 #include <iosfwd>
 #include <string>
 
+#include <sys/types.h>
+
 #include <proton/types.h>
 #include <proton/codec.h>
 
@@ -107,3 +109,24 @@ namespace proton {
 }
 
 /******************************************************************************/
+
+/**
+ * The specialisations have to be declared before anything uses them,
+ * otherwise an optimising build is free to inline the primary templates
+ * in their place
+ */
+namespace proton {
+
+    template<> std::string get_symbol<std::string> (pn_data_t *);
+    template<> pn_bytes_t get_symbol<pn_bytes_t> (pn_data_t *);
+
+    template<> int32_t readAndNext<int32_t> (pn_data_t *, bool);
+    template<> long readAndNext<long> (pn_data_t *, bool);
+    template<> u_long readAndNext<u_long> (pn_data_t *, bool);
+    template<> bool readAndNext<bool> (pn_data_t *, bool);
+    template<> double readAndNext<double> (pn_data_t *, bool);
+    template<> std::string readAndNext<std::string> (pn_data_t *, bool);
+
+}
+
+/******************************************************************************/